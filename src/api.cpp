@@ -0,0 +1,299 @@
+// api.cpp - Versioned JSON REST API (/api/v1) implementation
+#include "api.h"
+#include "globals.h"
+#include "logging.h"
+#include "logring.h"
+#include "hist.h"
+#include "manifest.h"
+#include "appender.h"
+#include "recent.h"
+#include "series.h"
+#include <ArduinoJson.h>
+#include <memory>
+
+#define API_LOG_FIELDS      4
+
+static const char* const apiLogFieldNames[API_LOG_FIELDS] = {"level", "module", "unit", "msg"};
+
+// Per-response state; one day file is open at a time. Items are serialized
+// one by one into line, so a page of any length costs the same memory.
+struct ApiState {
+    ApiPage page;
+    std::vector<ManifestEntry> days;
+    size_t day = 0;             // next entry of days to open
+    bool dayOpen = false;
+    bool finished = false;
+    HistReader hist;
+    File log;
+    uint32_t logDate = 0;
+    uint32_t logEnd = 0;
+    uint16_t emitted = 0;
+    JsonDocument doc;
+    char entry[LOG_RING_LINE_MAX + 32];     // decoded log line, unit and message point into it
+    char line[API_ITEM_MAX];
+    size_t lineLen = 0;
+    size_t linePos = 0;
+
+    ~ApiState() {
+        if (dayOpen) {
+            if (page.resource == API_HISTORY) histClose(hist);
+            else log.close();
+        }
+    }
+};
+
+static int apiLogField(const String& name) {
+    for (uint8_t i = 0; i < API_LOG_FIELDS; i++) {
+        if (name == apiLogFieldNames[i]) return i;
+    }
+    return -1;
+}
+
+// fields=a,b,..: channel names (history) or log fields; ts always comes
+// along, an empty list selects everything
+static bool apiParseFields(const String& list, ApiResource resource, uint32_t& mask) {
+    if (list.length() == 0) {
+        mask = resource == API_HISTORY ? (1UL << HIST_CHANNELS) - 1 : (1UL << API_LOG_FIELDS) - 1;
+        return true;
+    }
+    mask = 0;
+    int start = 0;
+    while (start <= (int)list.length()) {
+        int comma = list.indexOf(',', start);
+        if (comma < 0) comma = list.length();
+        String name = list.substring(start, comma);
+        name.trim();
+        start = comma + 1;
+        if (name.length() == 0 || name == "ts") continue;
+        int bit = resource == API_HISTORY ? seriesChannel(name) : apiLogField(name);
+        if (bit < 0) return false;
+        mask |= 1UL << bit;
+    }
+    return true;
+}
+
+// Eight upper- or lower-case hex digits at s[at]
+static bool apiHex(const String& s, size_t at, uint32_t& v) {
+    v = 0;
+    for (size_t i = at; i < at + 8; i++) {
+        char c = s[i];
+        uint8_t d;
+        if (c >= '0' && c <= '9') d = c - '0';
+        else if (c >= 'A' && c <= 'F') d = c - 'A' + 10;
+        else if (c >= 'a' && c <= 'f') d = c - 'a' + 10;
+        else return false;
+        v = (v << 4) | d;
+    }
+    return true;
+}
+
+// Reads from/to/limit/fields/cursor into page; the error text, NULL if valid
+const char* apiPageArgs(AsyncWebServerRequest* request, ApiResource resource, ApiPage& page) {
+    page.resource = resource;
+    String toStr = request->arg("to");
+    String fromStr = request->arg("from");
+    page.toTs = toStr.length() > 0 ? (uint32_t)toStr.toInt() : (uint32_t)myTZ.now();
+    page.fromTs = fromStr.length() > 0 ? (uint32_t)fromStr.toInt() : page.toTs - 86399UL;
+    if (page.fromTs > page.toTs) return "invalid range";
+
+    String limitStr = request->arg("limit");
+    long limit = limitStr.length() > 0 ? limitStr.toInt() : API_LIMIT_DEFAULT;
+    if (limit < 1 || limit > API_LIMIT_MAX) return "invalid limit";
+    page.limit = limit;
+
+    if (!apiParseFields(request->arg("fields"), resource, page.fields)) return "unknown field";
+
+    // "H" + next ts, or "L" + day + offset of the next entry
+    page.resume = false;
+    String cursor = request->arg("cursor");
+    if (cursor.length() > 0) {
+        uint32_t a = 0, b = 0;
+        bool valid = resource == API_HISTORY
+                         ? cursor.length() == 9 && cursor[0] == 'H' && apiHex(cursor, 1, a)
+                         : cursor.length() == 17 && cursor[0] == 'L' && apiHex(cursor, 1, a) && apiHex(cursor, 9, b);
+        if (!valid) return "invalid cursor";
+        page.resume = true;
+        if (resource == API_HISTORY) {
+            page.fromTs = max(page.fromTs, a);
+        } else {
+            page.resumeDate = a;
+            page.resumePos = b;
+        }
+    }
+    return NULL;
+}
+
+// Next record in range; histOpen() seeks straight to fromTs in each day
+static bool apiNextRecord(ApiState& st, HistRecord& rec) {
+    while (true) {
+        if (!st.dayOpen) {
+            if (st.day >= st.days.size()) return false;
+            String path = histPath(st.days[st.day++].date);
+            st.dayOpen = histOpen(st.hist, path.c_str(), st.page.fromTs, st.page.toTs);
+            continue;
+        }
+        if (histNext(st.hist, rec)) {
+            if (rec.ts < st.page.fromTs) continue;
+            return true;
+        }
+        histClose(st.hist);
+        st.dayOpen = false;
+    }
+}
+
+// Next log entry in range, in file order; pos is where it starts in day
+// file st.logDate
+static bool apiNextEntry(ApiState& st, uint8_t& flags, uint32_t& ts, const char*& unit, const char*& msg,
+                         uint32_t& pos) {
+    while (true) {
+        if (!st.dayOpen) {
+            if (st.day >= st.days.size()) return false;
+            st.logDate = st.days[st.day++].date;
+            if (!logOpenWindow(st.logDate, st.page.fromTs, st.page.toTs, st.log, st.logEnd)) continue;
+            if (st.page.resume && st.logDate == st.page.resumeDate && st.page.resumePos > st.log.position()) {
+                st.log.seek(min(st.page.resumePos, st.logEnd));
+            }
+            st.dayOpen = true;
+            continue;
+        }
+        pos = st.log.position();
+        if (pos >= st.logEnd || !logReadEntry(st.log, st.entry, sizeof(st.entry), flags) ||
+            st.log.position() == pos) {
+            st.log.close();
+            st.dayOpen = false;
+            continue;
+        }
+        // "unix|unit|message"
+        char* end;
+        ts = strtoul(st.entry, &end, 10);
+        if (end == st.entry || *end != '|') continue;
+        unit = end + 1;
+        char* bar = strchr(end + 1, '|');
+        if (!bar) continue;
+        *bar = '\0';
+        msg = bar + 1;
+        if (ts < st.page.fromTs || ts > st.page.toTs) continue;
+        return true;
+    }
+}
+
+// st.doc after a separator into st.line
+static size_t apiSerialize(ApiState& st) {
+    size_t n = 0;
+    if (st.emitted++ > 0) st.line[n++] = ',';
+    return n + serializeJson(st.doc, st.line + n, sizeof(st.line) - n);
+}
+
+static size_t apiHistoryItem(ApiState& st, const HistRecord& rec) {
+    char values[HIST_CHANNELS][16];
+    st.doc.clear();
+    st.doc["ts"] = rec.ts;
+    for (uint8_t ch = 0; ch < HIST_CHANNELS; ch++) {
+        if (!(st.page.fields & (1UL << ch))) continue;
+        histFormatValue(rec, ch, values[ch], sizeof(values[ch]));
+        st.doc[recentChannelName(ch)] = serialized((const char*)values[ch]);
+    }
+    return apiSerialize(st);
+}
+
+// Text lines (CEW, older files) have neither level nor module
+static size_t apiLogItem(ApiState& st, uint8_t flags, uint32_t ts, const char* unit, const char* msg) {
+    uint8_t level = LOG_REC_LEVEL(flags);
+    st.doc.clear();
+    st.doc["ts"] = ts;
+    if (st.page.fields & API_LOG_LEVEL) {
+        if (level) st.doc["level"] = logLevelName(level);
+        else st.doc["level"] = nullptr;
+    }
+    if (st.page.fields & API_LOG_MODULE) {
+        if (level) st.doc["module"] = logModuleName(LOG_REC_MODULE(flags));
+        else st.doc["module"] = nullptr;
+    }
+    if (st.page.fields & API_LOG_UNIT) st.doc["unit"] = unit;
+    if (st.page.fields & API_LOG_MSG) {
+        st.doc["msg"] = msg;
+        // Escaping may outgrow the buffer; cut the message on a UTF-8 boundary
+        if (measureJson(st.doc) + 2 > sizeof(st.line)) {
+            size_t cut = min(strlen(msg), (sizeof(st.line) - 128) / 6);
+            while (cut > 0 && (msg[cut] & 0xC0) == 0x80) cut--;
+            st.entry[msg - st.entry + cut] = '\0';
+            st.doc["msg"] = msg;
+        }
+    }
+    return apiSerialize(st);
+}
+
+// Loads the next JSON element into st.line; false when the response is complete
+static bool apiNextItem(ApiState& st) {
+    if (st.finished) return false;
+    size_t len = 0;
+    char cursor[20] = "";
+    if (st.page.resource == API_HISTORY) {
+        HistRecord rec;
+        if (apiNextRecord(st, rec)) {
+            if (st.emitted < st.page.limit) len = apiHistoryItem(st, rec);
+            else snprintf(cursor, sizeof(cursor), "H%08lX", (unsigned long)rec.ts);
+        }
+    } else {
+        uint8_t flags;
+        uint32_t ts, pos;
+        const char* unit;
+        const char* msg;
+        if (apiNextEntry(st, flags, ts, unit, msg, pos)) {
+            if (st.emitted < st.page.limit) len = apiLogItem(st, flags, ts, unit, msg);
+            else snprintf(cursor, sizeof(cursor), "L%08lX%08lX", (unsigned long)st.logDate, (unsigned long)pos);
+        }
+    }
+    if (len == 0) {
+        len = cursor[0] ? snprintf(st.line, sizeof(st.line), "],\"next\":\"%s\"}", cursor)
+                        : snprintf(st.line, sizeof(st.line), "],\"next\":null}");
+        st.finished = true;
+        LOGD(LOG_MOD_WEB, "WEB: API %s page %u items, next %s", st.page.resource == API_HISTORY ? "history" : "logs",
+             st.emitted, cursor[0] ? cursor : "-");
+    }
+    st.lineLen = len;
+    st.linePos = 0;
+    return true;
+}
+
+// {"from":..,"to":..,"fields":["ts",..],"items":[{"ts":..,..},..],"next":"<cursor>"|null}
+// History items are in time order, log entries in the order they were written
+AsyncWebServerResponse* beginApiPage(AsyncWebServerRequest* request, const ApiPage& page) {
+    std::shared_ptr<ApiState> st = std::make_shared<ApiState>();
+    st->page = page;
+    if (page.resource == API_HISTORY) {
+        appenderSyncAll();  // make buffered samples visible
+        if (page.fromTs <= page.toTs) {
+            st->days = manifestRange(MF_SENS, histDateOf(page.fromTs), histDateOf(page.toTs));
+        }
+    } else {
+        // Day files take a late flush past midnight, as in logSearch()
+        st->days = manifestRange(MF_LOGS, histDateOf(page.fromTs), histDateOf(page.toTs + 86400UL));
+        if (page.resume) {
+            while (st->day < st->days.size() && st->days[st->day].date < page.resumeDate) st->day++;
+        }
+    }
+
+    int n = snprintf(st->line, sizeof(st->line), "{\"from\":%lu,\"to\":%lu,\"fields\":[\"ts\"",
+                     (unsigned long)page.fromTs, (unsigned long)page.toTs);
+    uint8_t fieldCount = page.resource == API_HISTORY ? HIST_CHANNELS : API_LOG_FIELDS;
+    for (uint8_t i = 0; i < fieldCount; i++) {
+        if (!(page.fields & (1UL << i))) continue;
+        n += snprintf(st->line + n, sizeof(st->line) - n, ",\"%s\"",
+                      page.resource == API_HISTORY ? recentChannelName(i) : apiLogFieldNames[i]);
+    }
+    n += snprintf(st->line + n, sizeof(st->line) - n, "],\"items\":[");
+    st->lineLen = n;
+
+    return request->beginChunkedResponse("application/json", [st](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+        size_t written = 0;
+        while (written < maxLen) {
+            if (st->linePos >= st->lineLen && !apiNextItem(*st)) break;
+            size_t n = min(st->lineLen - st->linePos, maxLen - written);
+            memcpy(buffer + written, st->line + st->linePos, n);
+            st->linePos += n;
+            written += n;
+        }
+        return written;
+    });
+}
@@ -0,0 +1,40 @@
+// api.h - Versioned JSON REST API (/api/v1) header
+#ifndef API_H
+#define API_H
+
+#include "config.h"
+#include <ESPAsyncWebServer.h>
+
+#define API_LIMIT_DEFAULT   500             // items per page without limit=
+#define API_LIMIT_MAX       5000
+#define API_ITEM_MAX        1536            // one serialized item, a log message escaped included
+
+// Log fields; history fields are bit ch of the channel
+#define API_LOG_LEVEL       0x01
+#define API_LOG_MODULE      0x02
+#define API_LOG_UNIT        0x04
+#define API_LOG_MSG         0x08
+
+enum ApiResource { API_HISTORY, API_LOGS };
+
+// One page request. A cursor is handed out with every page that is not the
+// last; it holds where the next item sits (history: its timestamp, logs: day
+// file and byte offset), so the following page starts with a seek instead
+// of reading past the items already sent. from/to/fields are sent again
+// unchanged along with it.
+struct ApiPage {
+    ApiResource resource;
+    uint32_t fromTs;
+    uint32_t toTs;
+    uint32_t fields;
+    uint16_t limit;
+    bool resume;
+    uint32_t resumeDate;        // logs only
+    uint32_t resumePos;
+};
+
+// Function declarations
+const char* apiPageArgs(AsyncWebServerRequest* request, ApiResource resource, ApiPage& page);
+AsyncWebServerResponse* beginApiPage(AsyncWebServerRequest* request, const ApiPage& page);
+
+#endif // API_H
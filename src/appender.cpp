@@ -0,0 +1,223 @@
+// appender.cpp - Keep-open, write-combining SD appender implementation
+#include "appender.h"
+#include "globals.h"
+#include "logging.h"
+#include "manifest.h"
+#include "tier.h"
+#include <ArduinoJson.h>
+
+Appender sensAppender;
+Appender fanAppender;
+
+static Appender* appenders[] = {&sensAppender, &fanAppender};
+static const size_t APPENDER_COUNT = sizeof(appenders) / sizeof(appenders[0]);
+
+// Appends run from loop() and from AsyncTCP handlers
+static SemaphoreHandle_t appenderLock = NULL;
+
+static void lockAppenders() {
+    if (appenderLock) xSemaphoreTakeRecursive(appenderLock, portMAX_DELAY);
+}
+
+static void unlockAppenders() {
+    if (appenderLock) xSemaphoreGiveRecursive(appenderLock);
+}
+
+void initAppenders() {
+    if (!appenderLock) appenderLock = xSemaphoreCreateRecursiveMutex();
+    sensAppender.name = "sens";
+    fanAppender.name = "fan";
+    for (size_t i = 0; i < APPENDER_COUNT; i++) {
+        appenders[i]->reserve = APPENDER_RESERVE;
+        appenders[i]->isOpen = false;
+        appenders[i]->len = 0;
+        appenders[i]->patchLen = 0;
+        memset(&appenders[i]->stats, 0, sizeof(AppenderStats));
+    }
+}
+
+// Buffer and patch are only released once written; after a failure they
+// stay for the next flush, which appenderTick() tries again after
+// APPENDER_MAX_AGE_MS. Rewriting from a.offset makes a retry idempotent.
+static bool appenderFlushLocked(Appender& a) {
+    if (!a.isOpen || (a.len == 0 && a.patchLen == 0)) return true;
+
+    uint32_t start = micros();
+    size_t bytes = a.len + a.patchLen;
+    bool ok = true;
+    if (a.len > 0) {
+        ok = a.file.seek(a.offset) && a.file.write(a.buf, a.len) == a.len;
+        if (ok) {
+            a.offset += a.len;
+            a.len = 0;
+        }
+    }
+    if (ok && a.patchLen > 0) {
+        ok = a.file.seek(a.patchOffset) && a.file.write(a.patch, a.patchLen) == a.patchLen;
+        if (ok) a.patchLen = 0;
+    }
+    if (ok) {
+        a.file.flush();  // sync so readers on other handles see the new size
+        manifestUpdate(a.path, a.file.size());
+    }
+
+    uint32_t us = micros() - start;
+    a.stats.flushes++;
+    a.stats.lastFlushUs = us;
+    a.stats.maxFlushUs = max(a.stats.maxFlushUs, us);
+    a.stats.totalFlushUs += us;
+    if (!ok) {
+        a.stats.errors++;
+        a.firstWriteMs = millis();
+        LOGE(LOG_MOD_SD, "SD:Appender %s flush failed for %s, %u bytes kept", a.name, a.path, a.len + a.patchLen);
+        return false;
+    }
+    a.stats.bytes += bytes;
+    a.stats.lastBytes = bytes;
+    a.stats.maxBytes = max(a.stats.maxBytes, (uint32_t)bytes);
+    return true;
+}
+
+static void appenderCloseLocked(Appender& a) {
+    if (!a.isOpen) return;
+    if (!appenderFlushLocked(a)) {
+        LOGE(LOG_MOD_SD, "SD:Appender %s closed with %u unwritten bytes", a.name, a.len + a.patchLen);
+    }
+    a.file.close();
+    a.isOpen = false;
+}
+
+bool appenderOpen(Appender& a, const String& path, uint32_t offset) {
+    lockAppenders();
+    if (a.isOpen && a.path == path && offset == APPENDER_OFFSET_END) {
+        unlockAppenders();
+        return true;
+    }
+
+    // Date rollover or explicit reposition: finish the previous file first
+    appenderCloseLocked(a);
+
+    // Flushes are staged in the hot tier and reach the card in bulk
+    bool exists = storage.exists(path.c_str());
+    a.file = tierOpen(path, offset == 0 || !exists, a.reserve);
+    if (!a.file) {
+        a.stats.errors++;
+        unlockAppenders();
+        LOGE(LOG_MOD_SD, "SD:Appender %s open failed for %s", a.name, path);
+        return false;
+    }
+    uint32_t size = a.file.size();
+    a.offset = (offset == APPENDER_OFFSET_END || offset > size) ? size : offset;
+    a.path = path;
+    a.isOpen = true;
+    manifestUpdate(path, size);
+    a.len = 0;
+    a.patchLen = 0;
+    unlockAppenders();
+    return true;
+}
+
+bool appenderWrite(Appender& a, const void* data, size_t len) {
+    lockAppenders();
+    if (!a.isOpen) {
+        unlockAppenders();
+        return false;
+    }
+    // Room is made before copying, so a failed flush rejects the whole
+    // record instead of keeping part of it
+    if (a.len + len > APPENDER_BUF_SIZE && a.len > 0 && !appenderFlushLocked(a)) {
+        unlockAppenders();
+        return false;
+    }
+    const uint8_t* p = (const uint8_t*)data;
+    size_t start = a.len;
+    bool flushed = false;
+    bool ok = true;
+    while (len > 0) {
+        if (a.len == 0) a.firstWriteMs = millis();
+        size_t n = min(len, (size_t)APPENDER_BUF_SIZE - a.len);
+        memcpy(a.buf + a.len, p, n);
+        a.len += n;
+        p += n;
+        len -= n;
+        if (a.len < APPENDER_BUF_SIZE) continue;
+        if (appenderFlushLocked(a)) {
+            flushed = true;
+            continue;
+        }
+        // A record that exactly filled the buffer is kept; appenderTick()
+        // or the next write retries the flush. Otherwise drop the buffered
+        // part of the record, unless a part of it already reached the file.
+        if (len == 0) break;
+        if (!flushed) a.len = start;
+        ok = false;
+        break;
+    }
+    unlockAppenders();
+    return ok;
+}
+
+void appenderPatch(Appender& a, uint32_t offset, const void* data, size_t len) {
+    if (len > APPENDER_PATCH_MAX) return;
+    lockAppenders();
+    memcpy(a.patch, data, len);
+    a.patchLen = len;
+    a.patchOffset = offset;
+    if (a.len == 0) a.firstWriteMs = millis();
+    unlockAppenders();
+}
+
+bool appenderFlush(Appender& a) {
+    lockAppenders();
+    bool ok = appenderFlushLocked(a);
+    unlockAppenders();
+    return ok;
+}
+
+uint32_t appenderSize(Appender& a) {
+    lockAppenders();
+    uint32_t size = a.isOpen ? a.offset + a.len : 0;
+    unlockAppenders();
+    return size;
+}
+
+void appenderSyncAll() {
+    lockAppenders();
+    for (size_t i = 0; i < APPENDER_COUNT; i++) appenderFlushLocked(*appenders[i]);
+    unlockAppenders();
+}
+
+void appenderTick() {
+    lockAppenders();
+    for (size_t i = 0; i < APPENDER_COUNT; i++) {
+        Appender& a = *appenders[i];
+        if ((a.len > 0 || a.patchLen > 0) && millis() - a.firstWriteMs >= APPENDER_MAX_AGE_MS) {
+            appenderFlushLocked(a);
+        }
+    }
+    unlockAppenders();
+}
+
+String appenderStatsJson() {
+    JsonDocument doc;
+    lockAppenders();
+    for (size_t i = 0; i < APPENDER_COUNT; i++) {
+        const Appender& a = *appenders[i];
+        JsonObject o = doc[a.name].to<JsonObject>();
+        o["path"] = a.path;
+        o["buffered"] = a.len;
+        o["flushes"] = a.stats.flushes;
+        o["bytes"] = a.stats.bytes;
+        o["lastBytes"] = a.stats.lastBytes;
+        o["maxBytes"] = a.stats.maxBytes;
+        o["avgBytes"] = a.stats.flushes ? a.stats.bytes / a.stats.flushes : 0;
+        o["lastFlushUs"] = a.stats.lastFlushUs;
+        o["maxFlushUs"] = a.stats.maxFlushUs;
+        o["avgFlushUs"] = a.stats.flushes ? (uint32_t)(a.stats.totalFlushUs / a.stats.flushes) : 0;
+        o["errors"] = a.stats.errors;
+    }
+    unlockAppenders();
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
@@ -0,0 +1,56 @@
+// appender.h - Keep-open, write-combining SD appender header
+#ifndef APPENDER_H
+#define APPENDER_H
+
+#include "config.h"
+#include "storage.h"
+
+#define APPENDER_BUF_SIZE       2048          // 4 SD sectors
+#define APPENDER_MAX_AGE_MS     60000UL       // flush buffered data after a minute (to the hot tier)
+#define APPENDER_OFFSET_END     UINT32_MAX
+#define APPENDER_PATCH_MAX      128
+#define APPENDER_RESERVE        32768UL       // preallocated for a new day file (SdFat backend)
+
+struct AppenderStats {
+    uint32_t flushes;
+    uint32_t bytes;             // total bytes written by flushes
+    uint32_t lastBytes;
+    uint32_t maxBytes;
+    uint32_t lastFlushUs;
+    uint32_t maxFlushUs;
+    uint64_t totalFlushUs;
+    uint32_t errors;
+};
+
+// One output stream; the handle stays open until the path changes
+struct Appender {
+    const char* name;
+    uint32_t reserve;           // bytes reserved when the file is created
+    String path;
+    File file;
+    bool isOpen;
+    uint32_t offset;            // file position where buf starts
+    alignas(4) uint8_t buf[APPENDER_BUF_SIZE];
+    size_t len;
+    uint32_t firstWriteMs;      // millis() of the oldest buffered byte
+    uint8_t patch[APPENDER_PATCH_MAX];   // deferred in-place rewrite (e.g. a file header)
+    size_t patchLen;
+    uint32_t patchOffset;
+    AppenderStats stats;
+};
+
+extern Appender sensAppender;
+extern Appender fanAppender;
+
+// Function declarations
+void initAppenders();
+bool appenderOpen(Appender& a, const String& path, uint32_t offset = APPENDER_OFFSET_END);
+bool appenderWrite(Appender& a, const void* data, size_t len);
+void appenderPatch(Appender& a, uint32_t offset, const void* data, size_t len);
+bool appenderFlush(Appender& a);
+uint32_t appenderSize(Appender& a);
+void appenderSyncAll();
+void appenderTick();
+String appenderStatsJson();
+
+#endif // APPENDER_H
@@ -0,0 +1,163 @@
+// columns.cpp - Per-channel column files of closed sensor days implementation
+#include "columns.h"
+#include "globals.h"
+#include "logging.h"
+#include "layout.h"
+#include "sd.h"
+
+bool colExists(uint32_t date) {
+    return storage.exists(layoutColumnsPath(date).c_str());
+}
+
+static void colCursorInit(ColCursor& c, uint32_t offset, uint32_t length) {
+    c.pos = offset;
+    c.end = offset + length;
+    c.len = 0;
+    c.at = 0;
+}
+
+// The two cursors share one handle, so every refill seeks
+static bool colByte(File& f, ColCursor& c, uint8_t& b) {
+    if (c.at >= c.len) {
+        if (c.pos >= c.end) return false;
+        uint32_t want = min((uint32_t)sizeof(c.buf), c.end - c.pos);
+        if (!f.seek(c.pos)) return false;
+        c.len = f.read(c.buf, want);
+        c.at = 0;
+        c.pos += c.len;
+        if (c.len == 0) return false;
+    }
+    b = c.buf[c.at++];
+    return true;
+}
+
+static bool colVarint(File& f, ColCursor& c, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        uint8_t b;
+        if (!colByte(f, c, b)) return false;
+        value |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+bool colOpen(ColSeries& s, uint32_t date, uint8_t ch, uint32_t fromTs, uint32_t toTs) {
+    if (ch >= HIST_CHANNELS) return false;
+    s.file = storage.open(layoutColumnsPath(date).c_str(), FILE_READ);
+    if (!s.file) return false;
+    if (s.file.read((uint8_t*)&s.hdr, sizeof(s.hdr)) != sizeof(s.hdr) ||
+        s.hdr.magic != COL_MAGIC || s.hdr.columns != COL_COLUMNS) {
+        s.file.close();
+        return false;
+    }
+    s.ch = ch;
+    s.fromTs = fromTs;
+    s.toTs = toTs;
+    s.pos = 0;
+    s.ts = s.hdr.dayStart;
+    s.value = 0;
+    colCursorInit(s.tsCur, s.hdr.offset[COL_TS], s.hdr.length[COL_TS]);
+    colCursorInit(s.valCur, s.hdr.offset[1 + ch], s.hdr.length[1 + ch]);
+    return true;
+}
+
+bool colNext(ColSeries& s, uint32_t& ts, int32_t& value) {
+    while (s.pos < s.hdr.count) {
+        uint32_t dt, zz;
+        if (!colVarint(s.file, s.tsCur, dt) || !colVarint(s.file, s.valCur, zz)) break;
+        s.ts += dt;
+        s.value += (int32_t)((zz >> 1) ^ (~(zz & 1) + 1));
+        s.pos++;
+        if (s.ts > s.toTs) break;
+        if (s.ts >= s.fromTs) {
+            ts = s.ts;
+            value = s.value;
+            return true;
+        }
+    }
+    s.pos = s.hdr.count;
+    return false;
+}
+
+void colClose(ColSeries& s) {
+    if (s.file) s.file.close();
+}
+
+static void colPut(std::vector<uint8_t>& col, uint32_t value) {
+    while (value >= 0x80) {
+        col.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    col.push_back((uint8_t)value);
+}
+
+// Reads the (raw or compacted) day file; false if there is nothing to do
+bool colBuildBegin(ColBuilder& b, uint32_t date) {
+    String src = histPath(date);
+    if (!histOpen(b.src, src.c_str())) return false;
+    b.path = layoutColumnsPath(date);
+    b.tmpPath = b.path.substring(0, b.path.length() - 4) + ".tmp";
+
+    memset(&b.hdr, 0, sizeof(b.hdr));
+    b.hdr.magic = COL_MAGIC;
+    b.hdr.version = COL_VERSION;
+    b.hdr.columns = COL_COLUMNS;
+    b.hdr.date = date;
+    b.hdr.dayStart = dateToEpoch(date);
+    b.prev.ts = b.hdr.dayStart;
+    memset(b.prev.v, 0, sizeof(b.prev.v));
+    for (uint8_t c = 0; c < COL_COLUMNS; c++) std::vector<uint8_t>().swap(b.col[c]);
+    return true;
+}
+
+// Encodes up to maxRecords; 1 = more to do, 0 = done, -1 = failed
+int colBuildStep(ColBuilder& b, uint16_t maxRecords) {
+    HistRecord rec;
+    for (uint16_t i = 0; i < maxRecords; i++) {
+        if (!histNext(b.src, rec)) {
+            histClose(b.src);
+            return b.hdr.count > 0 ? 0 : -1;
+        }
+        // Out of day or out of order samples would need negative ts deltas
+        if (rec.ts < b.prev.ts || rec.ts - b.hdr.dayStart >= 86400UL) continue;
+
+        colPut(b.col[COL_TS], rec.ts - b.prev.ts);
+        for (uint8_t ch = 0; ch < HIST_CHANNELS; ch++) {
+            int32_t d = rec.v[ch] - b.prev.v[ch];
+            colPut(b.col[1 + ch], ((uint32_t)d << 1) ^ (uint32_t)(d >> 31));
+        }
+        b.prev = rec;
+        b.hdr.count++;
+    }
+    return 1;
+}
+
+// Writes header and columns to the .tmp file and renames it into place
+bool colBuildCommit(ColBuilder& b) {
+    uint32_t offset = sizeof(ColHeader);
+    for (uint8_t c = 0; c < COL_COLUMNS; c++) {
+        b.hdr.offset[c] = offset;
+        b.hdr.length[c] = b.col[c].size();
+        offset += b.hdr.length[c];
+    }
+
+    File out = storage.open(b.tmpPath.c_str(), FILE_WRITE);
+    if (!out) return false;
+    bool ok = out.write((const uint8_t*)&b.hdr, sizeof(b.hdr)) == sizeof(b.hdr);
+    for (uint8_t c = 0; c < COL_COLUMNS && ok; c++) {
+        ok = out.write(b.col[c].data(), b.col[c].size()) == b.col[c].size();
+    }
+    out.close();
+    for (uint8_t c = 0; c < COL_COLUMNS; c++) std::vector<uint8_t>().swap(b.col[c]);
+
+    if (ok && storage.exists(b.path.c_str())) storage.remove(b.path.c_str());
+    ok = ok && storage.rename(b.tmpPath.c_str(), b.path.c_str());
+    if (!ok) storage.remove(b.tmpPath.c_str());
+    return ok;
+}
+
+void colBuildAbort(ColBuilder& b) {
+    histClose(b.src);
+    for (uint8_t c = 0; c < COL_COLUMNS; c++) std::vector<uint8_t>().swap(b.col[c]);
+}
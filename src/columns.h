@@ -0,0 +1,83 @@
+// columns.h - Per-channel column files of closed sensor days header
+#ifndef COLUMNS_H
+#define COLUMNS_H
+
+#include "config.h"
+#include "hist.h"
+#include <vector>
+
+// Set to 0 with -D HIST_COLUMNS=0 to keep rows only; readers then fall back
+// to the sens_DD.bin day files
+#ifndef HIST_COLUMNS
+#define HIST_COLUMNS        1
+#endif
+
+#define COL_MAGIC           0x31435352UL  // "RSC1"
+#define COL_VERSION         1
+#define COL_COLUMNS         (HIST_CHANNELS + 1)   // timestamps, then one per channel
+#define COL_TS              0
+#define COL_READ_BUF        128           // per column cursor
+
+// cols_DD.bin next to the day's sens_DD.bin. Every column is a contiguous
+// run of varints: timestamps as deltas from dayStart and then from the
+// previous sample, values as zigzag deltas from 0 and then from the previous
+// value. A single-channel read touches the header, the timestamp column and
+// one value column only.
+struct __attribute__((packed)) ColHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t columns;
+    uint8_t reserved;
+    uint32_t date;                  // YYYYMMDD
+    uint32_t dayStart;
+    uint32_t count;                 // samples in every column
+    uint32_t offset[COL_COLUMNS];   // file offset of each column
+    uint32_t length[COL_COLUMNS];   // bytes of each column
+};
+
+// Buffered varint stream over one column
+struct ColCursor {
+    uint32_t pos;                   // next file offset to read
+    uint32_t end;
+    uint8_t buf[COL_READ_BUF];
+    uint16_t len;
+    uint16_t at;
+};
+
+// Reader of one channel of one day
+struct ColSeries {
+    File file;
+    ColHeader hdr;
+    uint8_t ch;
+    uint32_t fromTs;
+    uint32_t toTs;
+    uint32_t pos;                   // samples decoded
+    uint32_t ts;
+    int32_t value;
+    ColCursor tsCur;
+    ColCursor valCur;
+};
+
+// Incremental build of the column file of one closed day; the columns are
+// small enough (a few hundred bytes per channel at the 5 min interval) to
+// be collected in RAM and written in one go
+struct ColBuilder {
+    HistReader src;
+    String path;
+    String tmpPath;
+    ColHeader hdr;
+    HistRecord prev;
+    std::vector<uint8_t> col[COL_COLUMNS];
+};
+
+// Function declarations
+bool colExists(uint32_t date);
+bool colOpen(ColSeries& s, uint32_t date, uint8_t ch, uint32_t fromTs = 0, uint32_t toTs = UINT32_MAX);
+bool colNext(ColSeries& s, uint32_t& ts, int32_t& value);
+void colClose(ColSeries& s);
+bool colBuildBegin(ColBuilder& b, uint32_t date);
+int colBuildStep(ColBuilder& b, uint16_t maxRecords);
+bool colBuildCommit(ColBuilder& b);
+void colBuildAbort(ColBuilder& b);
+
+#endif // COLUMNS_H
@@ -0,0 +1,98 @@
+// compact.cpp - Background compaction of closed history days implementation
+#include "compact.h"
+#include "globals.h"
+#include "logging.h"
+#include "hist.h"
+#include "manifest.h"
+#include "appender.h"
+#include "sd.h"
+#include "columns.h"
+
+static HistCompactor compactor;
+static bool compactActive = false;
+static ColBuilder columns;
+static bool columnsActive = false;
+static uint32_t compactCursor = 0;      // days before this date are known to be compacted
+static uint32_t compactLastCheck = 0;
+static bool compactIdle = false;        // cursor reached yesterday; recheck once a minute
+
+static void compactFinish(int result) {
+    uint32_t date = compactor.hdr.date;
+    if (result == 0 && histCompactCommit(compactor)) {
+        File f = storage.open(compactor.path.c_str(), FILE_READ);
+        uint32_t size = f ? f.size() : 0;
+        if (f) f.close();
+        uint32_t raw = sizeof(HistHeader) + compactor.hdr.count * compactor.src.recSize;
+        manifestUpdate(compactor.path, size);
+        LOGI(LOG_MOD_SD, "SD:Compacted %s %lu -> %lu bytes", compactor.path, raw, size);
+        // The cursor stays on the day so the next pass builds its columns
+    } else {
+        histCompactAbort(compactor);
+        LOGE(LOG_MOD_SD, "SD:Compaction failed for %s", compactor.path);
+        compactCursor = nextDate(date);  // a failed day is retried after the next restart
+    }
+    compactActive = false;
+}
+
+static void columnsFinish(int result) {
+    uint32_t date = columns.hdr.date;
+    if (result == 0 && colBuildCommit(columns)) {
+        LOGI(LOG_MOD_SD, "SD:Columns built for %lu, %lu samples", date, columns.hdr.count);
+    } else {
+        colBuildAbort(columns);
+        LOGE(LOG_MOD_SD, "SD:Column build failed for %lu", date);
+    }
+    compactCursor = nextDate(date);
+    columnsActive = false;
+}
+
+// Called from loop(); each call checks one day or encodes one slice. A
+// closed day is compacted first and then split into columns, so the two
+// never hold the day file open at the same time.
+void compactTick() {
+    if (compactActive) {
+        int result = histCompactStep(compactor, COMPACT_SLICE);
+        if (result <= 0) compactFinish(result);
+        return;
+    }
+    if (columnsActive) {
+        int result = colBuildStep(columns, COMPACT_SLICE);
+        if (result <= 0) columnsFinish(result);
+        return;
+    }
+
+    if (compactIdle && millis() - compactLastCheck < COMPACT_CHECK_MS) return;
+    compactLastCheck = millis();
+    if ((sensorData.errorFlags[0] & ERR_SD) || !timeSynced) return;
+
+    // Oldest sensor day not checked yet, today excluded
+    uint32_t today = histDateOf(myTZ.now());
+    if (compactCursor >= today) {
+        compactIdle = true;
+        return;
+    }
+    std::vector<ManifestEntry> days = manifestRange(MF_SENS, compactCursor, today - 1);
+    if (days.empty()) {
+        compactCursor = today;
+        compactIdle = true;
+        return;
+    }
+    compactIdle = false;
+
+    uint32_t date = days[0].date;
+    String path = histPath(date);
+    if (sensAppender.isOpen && sensAppender.path == path) {
+        compactIdle = true;  // still being appended until the first sample of the new day
+        return;
+    }
+    if (histIsCompact(path.c_str())) {
+#if HIST_COLUMNS
+        if (!colExists(date)) columnsActive = colBuildBegin(columns, date);
+        if (columnsActive) return;
+#endif
+        compactCursor = nextDate(date);
+        return;
+    }
+    compactActive = histCompactBegin(compactor, date);
+    if (!compactActive) compactCursor = nextDate(date);
+}
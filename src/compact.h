@@ -0,0 +1,13 @@
+// compact.h - Background compaction of closed history days header
+#ifndef COMPACT_H
+#define COMPACT_H
+
+#include "config.h"
+
+#define COMPACT_SLICE       32          // records encoded per compactTick()
+#define COMPACT_CHECK_MS    60000UL
+
+// Function declarations
+void compactTick();
+
+#endif // COMPACT_H
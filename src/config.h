@@ -88,7 +88,7 @@ extern const char* apPassword;
 #define HTTP_HEARTBEAT 600000       // 10 minutes
 #define HTTP_SEND_INTERVAL 600000   // 10 minutes
 #define WEATHER_UPDATE_INTERVAL 900000  // 15 minutes
-#define ARCHIVE_TIME 300            // 00:05
+#define ARCHIVE_TIME 300            // 00:05 (s after local midnight), nightly rollup start
 #define HUM_THRESHOLD 60
 #define CO2_HIGH 1000
 #define EEPROM_MARKER 0xAB
@@ -3,6 +3,8 @@
 #include "globals.h"
 #include "http.h"
 #include "icons.h"
+#include "recent.h"
+#include "logging.h"
 #include <Display_ST7789.h>
 #include <Touch_CST328.h>
 #include <LVGL_Driver.h>
@@ -14,6 +16,7 @@
 // LVGL objects definitions
 lv_obj_t* graph_container;
 lv_obj_t* chart;
+lv_obj_t* graph_title;
 lv_obj_t* cards[8];
 lv_obj_t* weather_icon;
 lv_obj_t* wifi_icon;
@@ -21,6 +24,32 @@ lv_obj_t* bulb_icons[3]; // WC, UT, KOP bulb icons
 
 const char* roomNames[8] = {"EXT", "TIME_WIFI", "WC", "UT", "KOP", "DS", "S", "B"};
 
+// Graph screen: last 24 h from the recent sample buffer, one series per room
+#define GRAPH_SERIES 4
+#define GRAPH_SPAN   86400UL
+
+struct GraphDef {
+    const char* title;
+    lv_coord_t yMin, yMax;              // in recent buffer units (histScale, fans in permille)
+    int8_t ch[GRAPH_SERIES];            // -1 = unused series
+    uint32_t color[GRAPH_SERIES];
+};
+
+static const GraphDef graphDefs[] = {
+    {"Temperatura 24h", -100, 400, {HC_EXT_TEMP, HC_DS_TEMP, HC_UT_TEMP, HC_KOP_TEMP},
+     {EXT_COLOR, DS_COLOR, UT_COLOR, KOP_COLOR}},
+    {"Vlaga 24h", 0, 1000, {HC_EXT_HUM, HC_DS_HUM, HC_UT_HUM, HC_KOP_HUM},
+     {EXT_COLOR, DS_COLOR, UT_COLOR, KOP_COLOR}},
+    {"CO2 24h", 400, 2000, {HC_DS_CO2, -1, -1, -1},
+     {DS_COLOR, 0, 0, 0}},
+    {"Ventilatorji 24h", 0, ROLLUP_FAN_SCALE,
+     {RECENT_FAN_BASE, RECENT_FAN_BASE + 1, RECENT_FAN_BASE + 2, RECENT_FAN_BASE + 3},
+     {WC_COLOR, UT_COLOR, KOP_COLOR, DS_COLOR}},
+};
+
+static GraphType currentGraphType = GRAPH_TEMP;
+static lv_chart_series_t* graphSeries[GRAPH_SERIES];
+
 // EXT labels
 lv_obj_t* EXT_label1;
 lv_obj_t* EXT_label2;
@@ -129,8 +158,14 @@ bool initDisplay() {
     lv_obj_center(chart);
     lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
     lv_chart_set_point_count(chart, GRAPH_POINTS);
+    lv_obj_set_style_size(chart, 0, LV_PART_INDICATOR);   // lines only, no point markers
+    for (int i = 0; i < GRAPH_SERIES; i++) {
+        graphSeries[i] = lv_chart_add_series(chart, lv_color_hex(0xFFFFFF), LV_CHART_AXIS_PRIMARY_Y);
+    }
+    graph_title = lv_label_create(graph_container);
+    lv_obj_set_style_text_font(graph_title, FONT_14, 0);
+    lv_obj_align(graph_title, LV_ALIGN_TOP_MID, 0, 0);
     lv_obj_add_event_cb(graph_container, graph_event_cb, LV_EVENT_CLICKED, NULL);
-    // Add series for TEMP, HUM, CO2, FAN
 
     Serial.println("  Display init complete");
     return true;
@@ -404,7 +439,7 @@ static void button_event_cb(lv_event_t * e) {
         lv_anim_set_path_cb(&a, lv_anim_path_ease_in_out);
         lv_anim_start(&a);
     } else if (code == LV_EVENT_SHORT_CLICKED) {
-        Serial.printf("[%lu] gumb [%s] kratek pritisk\n", millis(), roomNames[roomId]);
+        LOGD(LOG_MOD_SYS, "UI:gumb [%s] kratek pritisk", roomNames[roomId]);
         // Perform short action (e.g., turn on fan)
         if (roomId >= ROOM_WC && roomId <= ROOM_DS) {
             String roomStr = (roomId == ROOM_WC) ? "wc" : (roomId == ROOM_UT) ? "ut" : (roomId == ROOM_KOP) ? "kop" : "ds";
@@ -425,7 +460,7 @@ static void button_event_cb(lv_event_t * e) {
         lv_anim_set_path_cb(&a, lv_anim_path_ease_in_out);
         lv_anim_start(&a);
     } else if (code == LV_EVENT_LONG_PRESSED) {
-        Serial.printf("[%lu] gumb [%s] dolg pritisk\n", millis(), roomNames[roomId]);
+        LOGD(LOG_MOD_SYS, "UI:gumb [%s] dolg pritisk", roomNames[roomId]);
         // Perform long action (e.g., disable fan)
         if (roomId >= ROOM_WC && roomId <= ROOM_DS) {
             String roomStr = (roomId == ROOM_WC) ? "wc" : (roomId == ROOM_UT) ? "ut" : (roomId == ROOM_KOP) ? "kop" : "ds";
@@ -587,9 +622,32 @@ void updateCards() {
     // Update window buttons colors - placeholder
 }
 
+// Fills the chart from RAM only; no SD access on the UI path
+static void showGraph(GraphType type) {
+    const GraphDef& def = graphDefs[type];
+    uint32_t toTs = timeSynced ? myTZ.now() : recentLastTs();
+    int32_t values[GRAPH_POINTS];
+
+    lv_label_set_text(graph_title, def.title);
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, def.yMin, def.yMax);
+    for (int i = 0; i < GRAPH_SERIES; i++) {
+        lv_coord_t* y = lv_chart_get_y_array(chart, graphSeries[i]);
+        bool used = def.ch[i] >= 0 &&
+                    recentSeries(def.ch[i], toTs - GRAPH_SPAN + 1, toTs, values, GRAPH_POINTS) == GRAPH_POINTS;
+        lv_chart_hide_series(chart, graphSeries[i], !used);
+        if (!used) continue;
+        lv_chart_set_series_color(chart, graphSeries[i], lv_color_hex(def.color[i]));
+        for (int p = 0; p < GRAPH_POINTS; p++) {
+            y[p] = (values[p] == RECENT_NONE) ? LV_CHART_POINT_NONE
+                                              : (lv_coord_t)constrain(values[p], -LV_COORD_MAX, LV_COORD_MAX);
+        }
+    }
+    lv_chart_refresh(chart);
+}
+
 void cycleGraph() {
-    // Cycle currentGraphType (enum GraphType)
-    // Update lv_chart series
+    currentGraphType = (GraphType)((currentGraphType + 1) % (sizeof(graphDefs) / sizeof(graphDefs[0])));
+    showGraph(currentGraphType);
 }
 
 
@@ -665,8 +723,7 @@ void updateWeatherIcon() {
                 lv_img_set_src(weather_icon, &partlycloudy);
                 break;
         }
-        Serial.printf("[Weather] Code: %d, Lux: %.1f\n",
-                     sensorData.weatherCode, sensorData.extLux);
+        LOGD(LOG_MOD_WEATHER, "Weather:Icon code %d, lux %.1f", sensorData.weatherCode, sensorData.extLux);
     }
 }
 
@@ -685,6 +742,7 @@ static void ext_event_cb(lv_event_t * e) {
     for (int i = 0; i < 8; i++) {
         lv_obj_add_flag(cards[i], LV_OBJ_FLAG_HIDDEN);
     }
+    showGraph(currentGraphType);
     lv_obj_clear_flag(graph_container, LV_OBJ_FLAG_HIDDEN);
     lv_timer_create(return_to_rooms, 30000, NULL);
 }
@@ -0,0 +1,176 @@
+// export.cpp - Streaming CSV export module implementation
+#include "export.h"
+#include "globals.h"
+#include "logging.h"
+#include "sd.h"
+#include "hist.h"
+#include "appender.h"
+#include "merge.h"
+#include "layout.h"
+#include "manifest.h"
+#include <memory>
+
+#define LOGS_CSV_HEADER "Čas (lokalni),Unix čas,Enota,Sporočilo"
+
+// Per-response state; one day file is open at a time (logs merge the one
+// or two files of their window) and at most one formatted line is pending,
+// so memory grows with the range only by its list of day files
+struct ExportState {
+    ExportType type;
+    std::vector<ManifestEntry> days;    // sensor and fan day files of the range
+    size_t day = 0;                     // next entry of days to open
+    uint32_t fromTs;
+    uint32_t toTs;
+    bool fileOpen = false;
+    bool finished = false;
+    File file;
+    HistReader hist;
+    LineMerge merge;        // logs: all day files of the window at once
+    uint32_t rows = 0;
+    char line[EXPORT_LINE_MAX];
+    size_t lineLen = 0;
+    size_t linePos = 0;
+
+    ~ExportState() {
+        if (fileOpen) {
+            if (type == EXPORT_SENS) histClose(hist);
+            else file.close();
+        }
+    }
+};
+
+// Sensor and fan day files; logs are opened up front into the merge
+static String exportPath(ExportType type, uint32_t date) {
+    if (type == EXPORT_SENS) return histPath(date);
+    return layoutPath(MF_FAN, date);
+}
+
+static void exportCloseDay(ExportState& st) {
+    if (!st.fileOpen) return;
+    if (st.type == EXPORT_SENS) histClose(st.hist);
+    else st.file.close();
+    st.fileOpen = false;
+}
+
+static void exportOpenDay(ExportState& st) {
+    String path = exportPath(st.type, st.days[st.day++].date);
+    if (st.type == EXPORT_SENS) {
+        st.fileOpen = histOpen(st.hist, path.c_str(), st.fromTs, st.toTs);
+        return;
+    }
+    st.file = storage.open(path.c_str(), FILE_READ);
+    if (!st.file) return;
+    st.fileOpen = true;
+    if (st.type == EXPORT_FAN) {
+        readLine(st.file, st.line, sizeof(st.line));  // skip the per-file header
+    }
+}
+
+// Formats "unix|unit|message" as a CSV row; false for lines outside the window
+static bool exportLogRow(ExportState& st, const char* raw, uint32_t unixTime) {
+    if (unixTime < st.fromTs || unixTime > st.toTs) return false;
+    const char* pipe1 = strchr(raw, '|');
+    const char* pipe2 = strchr(pipe1 + 1, '|');
+    if (!pipe2) return false;
+
+    char timeStr[24];
+    histFormatTime(unixTime, timeStr, sizeof(timeStr));
+    int n = snprintf(st.line, sizeof(st.line) - 1, "%s,%lu,%.*s,%s",
+                     timeStr, (unsigned long)unixTime, (int)(pipe2 - pipe1 - 1), pipe1 + 1, pipe2 + 1);
+    st.lineLen = min((size_t)max(n, 0), sizeof(st.line) - 2);
+    return true;
+}
+
+// Loads the next CSV row into st.line; false when the export is complete
+static bool exportNextRow(ExportState& st) {
+    while (!st.finished) {
+        if (st.type != EXPORT_LOGS && !st.fileOpen) {
+            if (st.day >= st.days.size()) {
+                st.finished = true;
+                LOGI(LOG_MOD_WEB, "WEB: Export finished, %lu rows", st.rows);
+                return false;
+            }
+            exportOpenDay(st);
+            continue;
+        }
+
+        bool got = false;
+        if (st.type == EXPORT_LOGS) {
+            uint32_t ts;
+            const char* raw = mergeNext(st.merge, ts);
+            if (!raw) {
+                st.finished = true;
+                LOGI(LOG_MOD_WEB, "WEB: Export finished, %lu rows", st.rows);
+                return false;
+            }
+            got = exportLogRow(st, raw, ts);
+        } else if (st.type == EXPORT_SENS) {
+            HistRecord rec;
+            if (histNext(st.hist, rec)) {
+                st.lineLen = histFormatCsv(rec, st.line, sizeof(st.line) - 1);
+                got = true;
+            } else {
+                exportCloseDay(st);
+            }
+        } else {
+            if (readLine(st.file, st.line, sizeof(st.line) - 1)) {
+                st.lineLen = strlen(st.line);
+                got = st.lineLen > 0;
+            } else {
+                exportCloseDay(st);
+            }
+        }
+
+        if (got) {
+            st.line[st.lineLen++] = '\n';
+            st.linePos = 0;
+            st.rows++;
+            return true;
+        }
+    }
+    return false;
+}
+
+AsyncWebServerResponse* beginCsvExport(AsyncWebServerRequest* request, ExportType type,
+                                       uint32_t fromDate, uint32_t toDate,
+                                       uint32_t fromTs, uint32_t toTs) {
+    if (type != EXPORT_LOGS) appenderSyncAll();  // make buffered samples visible
+
+    std::shared_ptr<ExportState> st = std::make_shared<ExportState>();
+    st->type = type;
+    st->fromTs = fromTs;
+    st->toTs = toTs;
+    st->finished = (fromDate == 0 || toDate == 0 || fromDate > toDate);
+    // Only the days that have a file; the chunk callback runs on the
+    // async_tcp task and must not probe every date of a sparse range
+    if (type != EXPORT_LOGS && !st->finished) {
+        st->days = manifestRange(type == EXPORT_SENS ? MF_SENS : MF_FAN, fromDate, toDate);
+    }
+    if (type == EXPORT_LOGS && !st->finished) {
+        mergeInit(st->merge, mergeLogKey, logReadLine);
+        for (const String& name : listLogFiles(fromDate, toDate)) {
+            File f;
+            uint32_t endPos;
+            if (logOpenWindow(parseDateFromName(name), fromTs, toTs, f, endPos)) {
+                mergeAdd(st->merge, f, endPos);
+            }
+        }
+    }
+
+    const char* header = (type == EXPORT_SENS) ? HIST_CSV_HEADER : (type == EXPORT_FAN) ? FAN_CSV_HEADER : LOGS_CSV_HEADER;
+    st->lineLen = snprintf(st->line, sizeof(st->line), "%s\n", header);
+
+    // Rows are formatted straight into the TCP send buffer; a row that does
+    // not fit stays pending in st->line for the next chunk
+    return request->beginChunkedResponse("text/csv", [st](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+        size_t written = 0;
+        while (written < maxLen) {
+            if (st->linePos >= st->lineLen && !exportNextRow(*st)) break;
+            size_t n = min(st->lineLen - st->linePos, maxLen - written);
+            memcpy(buffer + written, st->line + st->linePos, n);
+            st->linePos += n;
+            written += n;
+        }
+        return written;
+    });
+}
@@ -0,0 +1,17 @@
+// export.h - Streaming CSV export module header
+#ifndef EXPORT_H
+#define EXPORT_H
+
+#include "config.h"
+#include <ESPAsyncWebServer.h>
+
+#define EXPORT_LINE_MAX 512
+
+enum ExportType { EXPORT_SENS, EXPORT_FAN, EXPORT_LOGS };
+
+// Function declarations
+AsyncWebServerResponse* beginCsvExport(AsyncWebServerRequest* request, ExportType type,
+                                       uint32_t fromDate, uint32_t toDate,
+                                       uint32_t fromTs = 0, uint32_t toTs = UINT32_MAX);
+
+#endif // EXPORT_H
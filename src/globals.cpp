@@ -27,7 +27,6 @@ String currentSensFile = "";
 String currentFanFile = "";
 String currentLogFile = "";
 String lastDate = "";
-String logBuffer = "";
 uint32_t lastHistorySave = 0;
 bool loggingInitialized = false;
 
@@ -33,7 +33,6 @@ extern String currentSensFile;
 extern String currentFanFile;
 extern String currentLogFile;
 extern String lastDate;
-extern String logBuffer;
 extern uint32_t lastHistorySave;
 extern bool loggingInitialized;
 
@@ -0,0 +1,633 @@
+// hist.cpp - Binary sensor history module implementation
+#include "hist.h"
+#include "globals.h"
+#include "logging.h"
+#include "sd.h"
+#include "appender.h"
+#include "layout.h"
+#include "manifest.h"
+#include "tier.h"
+#include <vector>
+#include <algorithm>
+
+// x10 for temperatures and humidities, x1 for the rest
+const uint8_t histScale[HIST_CHANNELS] = {10, 10, 1, 1, 1, 10, 10, 1, 10, 10, 10, 10, 1, 1};
+
+// State of the day file currently being appended
+static String histFile = "";
+static HistHeader histHdr;
+static uint32_t histRecords = 0;
+static uint32_t histLastTs = 0;
+
+uint32_t histDateOf(uint32_t ts) {
+    tmElements_t tm;
+    breakTime(ts, tm);
+    return (tm.Year + 1970) * 10000UL + tm.Month * 100UL + tm.Day;
+}
+
+String histPath(uint32_t date) {
+    return layoutPath(MF_SENS, date);
+}
+
+static int32_t histScaled(float value, uint8_t ch) {
+    return (int32_t)lroundf(value * histScale[ch]);
+}
+
+void histFromSensorData(HistRecord& rec, uint32_t ts) {
+    rec.ts = ts;
+    rec.v[HC_EXT_TEMP] = histScaled(sensorData.extTemp, HC_EXT_TEMP);
+    rec.v[HC_EXT_HUM] = histScaled(sensorData.extHumidity, HC_EXT_HUM);
+    rec.v[HC_EXT_PRES] = histScaled(sensorData.extPressure, HC_EXT_PRES);
+    rec.v[HC_EXT_VOC] = histScaled(sensorData.extVOC, HC_EXT_VOC);
+    rec.v[HC_EXT_LUX] = histScaled(sensorData.extLux, HC_EXT_LUX);
+    rec.v[HC_DS_TEMP] = histScaled(sensorData.localTemp, HC_DS_TEMP);
+    rec.v[HC_DS_HUM] = histScaled(sensorData.localHumidity, HC_DS_HUM);
+    rec.v[HC_DS_CO2] = histScaled(sensorData.localCO2, HC_DS_CO2);
+    rec.v[HC_UT_TEMP] = histScaled(sensorData.utTemp, HC_UT_TEMP);
+    rec.v[HC_UT_HUM] = histScaled(sensorData.utHumidity, HC_UT_HUM);
+    rec.v[HC_KOP_TEMP] = histScaled(sensorData.bathroomTemp, HC_KOP_TEMP);
+    rec.v[HC_KOP_HUM] = histScaled(sensorData.bathroomHumidity, HC_KOP_HUM);
+    rec.v[HC_WC_PRES] = histScaled(sensorData.bathroomPressure, HC_WC_PRES);
+    rec.v[HC_WEATHER] = sensorData.weatherCode;
+}
+
+float histValue(const HistRecord& rec, uint8_t ch) {
+    return (float)rec.v[ch] / histScale[ch];
+}
+
+static void histInitHeader(HistHeader& hdr, uint32_t ts) {
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = HIST_MAGIC;
+    hdr.version = HIST_VERSION;
+    hdr.recordSize = HIST_FRAME_SIZE;
+    hdr.channels = HIST_CHANNELS;
+    hdr.date = histDateOf(ts);
+    hdr.dayStart = ts - (ts % 86400UL);
+    for (int h = 0; h < HIST_HOURS; h++) hdr.hourIndex[h] = HIST_NO_INDEX;
+}
+
+static bool histReadHeader(File& f, HistHeader& hdr) {
+    if (f.size() < sizeof(HistHeader)) return false;
+    f.seek(0);
+    if (f.read((uint8_t*)&hdr, sizeof(hdr)) != sizeof(hdr)) return false;
+    return hdr.magic == HIST_MAGIC && hdr.channels == HIST_CHANNELS &&
+           (hdr.recordSize == HIST_FRAME_SIZE || hdr.recordSize == sizeof(HistRecord));
+}
+
+// v1 frames carry no CRC and are always accepted
+static bool histFrameValid(const uint8_t* frame, uint16_t recSize) {
+    if (recSize != HIST_FRAME_SIZE) return true;
+    uint16_t crc;
+    memcpy(&crc, frame + sizeof(HistRecord), sizeof(crc));
+    return crc == calcCRC16(frame, sizeof(HistRecord));
+}
+
+static uint32_t histReadTs(File& f, uint16_t recSize, uint32_t index) {
+    uint32_t ts = 0;
+    f.seek(sizeof(HistHeader) + index * recSize);
+    f.read((uint8_t*)&ts, sizeof(ts));
+    return ts;
+}
+
+// Checks only the last HIST_RECOVER_MAX frames, so the cost does not grow
+// with the file. Returns the record count up to the last valid frame and
+// restores hour index entries whose header patch was lost with the tail.
+static uint32_t histScanTail(File& f, HistHeader& hdr, uint32_t& lastTs) {
+    uint32_t records = (f.size() - sizeof(HistHeader)) / hdr.recordSize;
+    uint32_t first = records > HIST_RECOVER_MAX ? records - HIST_RECOVER_MAX : 0;
+    uint32_t keep = first;
+    lastTs = first > 0 ? histReadTs(f, hdr.recordSize, first - 1) : 0;
+
+    uint8_t frame[HIST_FRAME_SIZE];
+    f.seek(sizeof(HistHeader) + first * hdr.recordSize);
+    for (uint32_t i = first; i < records; i++) {
+        if (f.read(frame, hdr.recordSize) != hdr.recordSize) break;
+        uint32_t ts;
+        memcpy(&ts, frame, sizeof(ts));
+        if (!histFrameValid(frame, hdr.recordSize) || ts < hdr.dayStart ||
+            ts - hdr.dayStart >= 86400UL || (i > 0 && ts <= lastTs)) {
+            continue;
+        }
+        uint32_t hour = (ts - hdr.dayStart) / 3600;
+        if (hdr.hourIndex[hour] == HIST_NO_INDEX) hdr.hourIndex[hour] = i;
+        keep = i + 1;
+        lastTs = ts;
+    }
+    for (int h = 0; h < HIST_HOURS; h++) {
+        if (hdr.hourIndex[h] != HIST_NO_INDEX && hdr.hourIndex[h] >= keep) hdr.hourIndex[h] = HIST_NO_INDEX;
+    }
+    return keep;
+}
+
+// Truncates a raw day file to its last valid record; false if the file is
+// missing or not a raw day file
+static bool histRecoverFile(const String& path, HistHeader& hdr, uint32_t& records, uint32_t& lastTs) {
+    File f = storage.open(path.c_str(), "r+");
+    if (!f) return false;
+    if (!histReadHeader(f, hdr)) {
+        f.close();
+        return false;
+    }
+    HistHeader before = hdr;
+    uint32_t size = f.size();
+    records = histScanTail(f, hdr, lastTs);
+    uint32_t end = sizeof(HistHeader) + records * hdr.recordSize;
+    if (memcmp(&before, &hdr, sizeof(hdr)) != 0) {
+        f.seek(0);
+        f.write((const uint8_t*)&hdr, sizeof(hdr));
+    }
+    f.close();
+    if (size == end) return true;
+
+    // Appends at the computed offset would overwrite the tail anyway; the
+    // truncate keeps readers from seeing it until then
+    if (!tierTruncate(path, end)) {
+        LOGE(LOG_MOD_SD, "SD:Truncate failed for %s", path);
+    }
+    manifestUpdate(path, end);
+    LOGW(LOG_MOD_SD, "SD:Recovered %s dropped %lu tail bytes", path, size - end);
+    return true;
+}
+
+bool histRecover(const String& path) {
+    HistHeader hdr;
+    uint32_t records, lastTs;
+    return histRecoverFile(path, hdr, records, lastTs);
+}
+
+// Switches the sens appender to the day file of ts, creating it if needed
+static bool histPrepareDay(uint32_t ts) {
+    String path = histPath(histDateOf(ts));
+    if (path == histFile && sensAppender.isOpen && sensAppender.path == path) return true;
+
+    if (storage.exists(path.c_str())) {
+        if (histRecoverFile(path, histHdr, histRecords, histLastTs)) {
+            if (!appenderOpen(sensAppender, path, sizeof(HistHeader) + histRecords * histHdr.recordSize)) return false;
+            histFile = path;
+            return true;
+        }
+        if (histIsCompact(path.c_str())) {
+            LOGW(LOG_MOD_SD, "SD:Sens sample for a compacted day - skipped");
+            return false;
+        }
+        LOGW(LOG_MOD_SD, "SD:Invalid sensor history header, recreating %s", path);
+    }
+
+    histInitHeader(histHdr, ts);
+    if (!appenderOpen(sensAppender, path, 0) || !appenderWrite(sensAppender, &histHdr, sizeof(histHdr))) {
+        LOGE(LOG_MOD_SD, "SD:Open fail for new sensor history file");
+        return false;
+    }
+    histRecords = 0;
+    histLastTs = 0;
+    histFile = path;
+    return true;
+}
+
+enum HistAppendResult {
+    HIST_APPENDED,
+    HIST_OUT_OF_ORDER,
+    HIST_WRITE_FAILED
+};
+
+// HIST_OUT_OF_ORDER leaves the file as it was; HIST_WRITE_FAILED means the
+// record could not be stored
+static HistAppendResult histAppendRecord(const HistRecord& rec) {
+    if (!histPrepareDay(rec.ts)) return HIST_WRITE_FAILED;
+
+    // Range queries binary search on ts, so records must stay in order
+    if (histRecords > 0 && rec.ts <= histLastTs) {
+        LOGW(LOG_MOD_SD, "SD:Sens sample out of order - skipped");
+        return HIST_OUT_OF_ORDER;
+    }
+
+    // Pre-v2 files of the current day keep their CRC-less layout
+    uint8_t frame[HIST_FRAME_SIZE];
+    memcpy(frame, &rec, sizeof(rec));
+    uint16_t crc = calcCRC16(frame, sizeof(rec));
+    memcpy(frame + sizeof(rec), &crc, sizeof(crc));
+    if (!appenderWrite(sensAppender, frame, histHdr.recordSize)) {
+        LOGE(LOG_MOD_SD, "SD:Write fail for sensor history");
+        return HIST_WRITE_FAILED;
+    }
+
+    // The header is rewritten together with the next flush
+    uint32_t hour = (rec.ts - histHdr.dayStart) / 3600;
+    if (hour < HIST_HOURS && histHdr.hourIndex[hour] == HIST_NO_INDEX) {
+        histHdr.hourIndex[hour] = histRecords;
+        appenderPatch(sensAppender, 0, &histHdr, sizeof(histHdr));
+    }
+
+    histRecords++;
+    histLastTs = rec.ts;
+    return HIST_APPENDED;
+}
+
+bool histAppend(const HistRecord& rec) {
+    return histAppendRecord(rec) == HIST_APPENDED;
+}
+
+static bool histReadZHeader(File& f, HistZHeader& hdr) {
+    if (f.size() < sizeof(HistZHeader)) return false;
+    f.seek(0);
+    if (f.read((uint8_t*)&hdr, sizeof(hdr)) != sizeof(hdr)) return false;
+    return hdr.magic == HISTZ_MAGIC && hdr.channels == HIST_CHANNELS;
+}
+
+bool histIsCompact(const char* path) {
+    File f = storage.open(path, FILE_READ);
+    if (!f) return false;
+    uint32_t magic = 0;
+    f.read((uint8_t*)&magic, sizeof(magic));
+    f.close();
+    return magic == HISTZ_MAGIC;
+}
+
+// Starts a compacted reader at the hour block of fromTs; histNext() skips
+// the records of that hour that lie before fromTs
+static bool histOpenCompact(HistReader& r, uint32_t fromTs) {
+    HistZHeader hdr;
+    if (!histReadZHeader(r.file, hdr)) return false;
+    r.compact = true;
+    r.count = hdr.count;
+    r.dayStart = hdr.dayStart;
+    memcpy(r.hourCount, hdr.hourCount, sizeof(r.hourCount));
+    r.zLen = 0;
+    r.zPos = 0;
+
+    uint32_t h = (fromTs > hdr.dayStart) ? (fromTs - hdr.dayStart) / 3600 : 0;
+    for (uint32_t i = 0; i < h && i < HIST_HOURS; i++) r.pos += hdr.hourCount[i];
+    while (h < HIST_HOURS && hdr.hourCount[h] == 0) h++;
+    if (h >= HIST_HOURS) {
+        r.pos = r.count;
+        return true;
+    }
+    r.hour = h;
+    r.blockLeft = hdr.hourCount[h];
+    r.prev.ts = hdr.dayStart + h * 3600UL;
+    memset(r.prev.v, 0, sizeof(r.prev.v));
+    r.file.seek(hdr.hourOffset[h]);
+    return true;
+}
+
+bool histOpen(HistReader& r, const char* path, uint32_t fromTs, uint32_t toTs) {
+    r.count = 0;
+    r.pos = 0;
+    r.fromTs = fromTs;
+    r.toTs = toTs;
+    r.bufLen = 0;
+    r.bufPos = 0;
+    r.compact = false;
+    r.recSize = sizeof(HistRecord);
+    r.file = storage.open(path, FILE_READ);
+    if (!r.file) return false;
+
+    uint32_t magic = 0;
+    r.file.read((uint8_t*)&magic, sizeof(magic));
+    if (magic == HISTZ_MAGIC) {
+        if (histOpenCompact(r, fromTs)) return true;
+        r.file.close();
+        return false;
+    }
+
+    HistHeader hdr;
+    if (!histReadHeader(r.file, hdr)) {
+        r.file.close();
+        return false;
+    }
+    r.recSize = hdr.recordSize;
+    r.count = (r.file.size() - sizeof(HistHeader)) / r.recSize;
+
+    // Narrow to the hour bucket of fromTs, then binary search inside it
+    uint32_t lo = 0, hi = r.count;
+    if (fromTs > hdr.dayStart) {
+        uint32_t hour = (fromTs - hdr.dayStart) / 3600;
+        if (hour >= HIST_HOURS) {
+            lo = r.count;
+        } else {
+            for (uint32_t h = hour + 1; h < HIST_HOURS; h++) {
+                if (hdr.hourIndex[h] != HIST_NO_INDEX) {
+                    hi = min((uint32_t)hdr.hourIndex[h], r.count);
+                    break;
+                }
+            }
+            lo = (hdr.hourIndex[hour] != HIST_NO_INDEX) ? min((uint32_t)hdr.hourIndex[hour], hi) : hi;
+        }
+    }
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (histReadTs(r.file, r.recSize, mid) < fromTs) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    r.pos = lo;
+    r.file.seek(sizeof(HistHeader) + lo * r.recSize);
+    return true;
+}
+
+static bool histZByte(HistReader& r, uint8_t& b) {
+    if (r.zPos >= r.zLen) {
+        r.zLen = r.file.read(r.buf, sizeof(r.buf));
+        r.zPos = 0;
+        if (r.zLen == 0) return false;
+    }
+    b = r.buf[r.zPos++];
+    return true;
+}
+
+static bool histZVarint(HistReader& r, uint32_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        uint8_t b;
+        if (!histZByte(r, b)) return false;
+        value |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static bool histNextCompact(HistReader& r, HistRecord& rec) {
+    while (r.pos < r.count) {
+        while (r.blockLeft == 0) {
+            if (++r.hour >= HIST_HOURS) {
+                r.pos = r.count;
+                return false;
+            }
+            r.blockLeft = r.hourCount[r.hour];
+            r.prev.ts = r.dayStart + r.hour * 3600UL;
+            memset(r.prev.v, 0, sizeof(r.prev.v));
+        }
+
+        uint32_t delta;
+        if (!histZVarint(r, delta)) break;
+        rec.ts = r.prev.ts + delta;
+        for (uint8_t ch = 0; ch < HIST_CHANNELS; ch++) {
+            uint32_t zz;
+            if (!histZVarint(r, zz)) {
+                r.pos = r.count;
+                return false;
+            }
+            rec.v[ch] = r.prev.v[ch] + (int32_t)((zz >> 1) ^ (~(zz & 1) + 1));
+        }
+        r.prev = rec;
+        r.blockLeft--;
+        r.pos++;
+
+        if (rec.ts > r.toTs) break;
+        if (rec.ts >= r.fromTs) return true;
+    }
+    r.pos = r.count;
+    return false;
+}
+
+bool histNext(HistReader& r, HistRecord& rec) {
+    if (r.compact) return histNextCompact(r, rec);
+    while (true) {
+        if (r.bufPos >= r.bufLen) {
+            if (!r.file || r.pos >= r.count) return false;
+            uint32_t want = min((uint32_t)(sizeof(r.buf) / r.recSize), r.count - r.pos);
+            size_t got = r.file.read(r.buf, want * r.recSize);
+            r.bufLen = got / r.recSize;
+            r.bufPos = 0;
+            if (r.bufLen == 0) return false;
+        }
+        const uint8_t* frame = r.buf + r.bufPos * r.recSize;
+        r.bufPos++;
+        r.pos++;
+        if (!histFrameValid(frame, r.recSize)) continue;  // bit rot mid-file: skip the record
+        memcpy(&rec, frame, sizeof(rec));
+        if (rec.ts > r.toTs) {
+            r.pos = r.count;
+            r.bufLen = 0;
+            return false;
+        }
+        return true;
+    }
+}
+
+void histClose(HistReader& r) {
+    if (r.file) r.file.close();
+}
+
+size_t histFormatTime(uint32_t ts, char* out, size_t len) {
+    tmElements_t tm;
+    breakTime(ts, tm);
+    int n = snprintf(out, len, "%02u:%02u:%02u %02u.%02u.%02u",
+                     tm.Hour, tm.Minute, tm.Second, tm.Day, tm.Month, (tm.Year + 1970) % 100);
+    return n < 0 ? 0 : min((size_t)n, len - 1);
+}
+
+size_t histFormatValue(const HistRecord& rec, uint8_t ch, char* out, size_t len) {
+    int n;
+    if (histScale[ch] == 1) {
+        n = snprintf(out, len, "%ld", (long)rec.v[ch]);
+    } else {
+        n = snprintf(out, len, "%.1f", histValue(rec, ch));
+    }
+    return n < 0 ? 0 : min((size_t)n, len - 1);
+}
+
+size_t histFormatCsv(const HistRecord& rec, char* out, size_t len) {
+    size_t n = histFormatTime(rec.ts, out, len);
+    for (uint8_t ch = 0; ch < HIST_CHANNELS && n + 1 < len; ch++) {
+        out[n++] = ',';
+        n += histFormatValue(rec, ch, out + n, len - n);
+    }
+    out[n] = '\0';
+    return n;
+}
+
+// Parses one legacy CSV line ("H:i:s d.m.y,v1,...,v14") into a record
+static bool histParseCsvLine(const char* line, HistRecord& rec) {
+    int h, mi, s, d, mo, y;
+    if (sscanf(line, "%d:%d:%d %d.%d.%d", &h, &mi, &s, &d, &mo, &y) != 6) return false;
+    rec.ts = makeTime(h, mi, s, d, mo, 2000 + y);
+
+    const char* p = strchr(line, ',');
+    for (uint8_t ch = 0; ch < HIST_CHANNELS; ch++) {
+        if (!p) return false;
+        char* end;
+        float value = strtof(p + 1, &end);
+        if (end == p + 1) return false;
+        rec.v[ch] = histScaled(value, ch);
+        p = strchr(end, ',');
+    }
+    return true;
+}
+
+// One-time conversion of history_sens_*.csv day files into the binary format
+void histMigrateCsv() {
+    if (sensorData.errorFlags[0] & ERR_SD) return;
+
+    std::vector<String> legacy;
+    File root = storage.open("/");
+    if (!root) return;
+    File entry = root.openNextFile();
+    while (entry) {
+        String name = entry.name();
+        entry.close();
+        if (!name.startsWith("/")) name = "/" + name;
+        if (name.startsWith("/history_sens_") && name.endsWith(".csv")) {
+            legacy.push_back(name);
+        }
+        entry = root.openNextFile();
+    }
+    root.close();
+    if (legacy.empty()) return;
+
+    // A file is removed only once every row is stored; rows converted before
+    // a failure come back out of order on the next attempt and are skipped
+    std::sort(legacy.begin(), legacy.end());
+    for (const String& name : legacy) {
+        File csv = storage.open(name.c_str(), FILE_READ);
+        if (!csv) continue;
+        uint32_t converted = 0, skipped = 0, failed = 0;
+        char line[256];
+        while (readLine(csv, line, sizeof(line))) {
+            HistRecord rec;
+            if (!histParseCsvLine(line, rec)) {
+                skipped++;  // header, millis: timestamps and broken lines
+                continue;
+            }
+            HistAppendResult result = histAppendRecord(rec);
+            if (result == HIST_APPENDED) {
+                converted++;
+            } else if (result == HIST_OUT_OF_ORDER) {
+                skipped++;
+            } else {
+                failed++;
+                break;      // card full or failing: keep the rest for the next boot
+            }
+        }
+        csv.close();
+        if (failed > 0) {
+            LOGE(LOG_MOD_SD, "SD:Migration of %s stopped after %lu rows, file kept", name, converted);
+            return;
+        }
+        storage.remove(name.c_str());
+        LOGI(LOG_MOD_SD, "SD:Migrated %s rows=%lu skipped=%lu", name, converted, skipped);
+    }
+}
+
+static void histZFlushOut(HistCompactor& c) {
+    if (c.oLen == 0) return;
+    c.out.write(c.obuf, c.oLen);
+    c.outPos += c.oLen;
+    c.oLen = 0;
+}
+
+static void histZPut(HistCompactor& c, uint32_t value) {
+    if ((uint32_t)c.oLen + 5 > (uint32_t)sizeof(c.obuf)) histZFlushOut(c);
+    while (value >= 0x80) {
+        c.obuf[c.oLen++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    c.obuf[c.oLen++] = (uint8_t)value;
+}
+
+// Opens the raw day file and the .tmp output; false if there is nothing to do
+bool histCompactBegin(HistCompactor& c, uint32_t date) {
+    c.path = histPath(date);
+    c.tmpPath = c.path + ".tmp";
+    if (!histOpen(c.src, c.path.c_str()) || c.src.compact) {
+        histClose(c.src);
+        return false;
+    }
+
+    memset(&c.hdr, 0, sizeof(c.hdr));
+    c.hdr.magic = HISTZ_MAGIC;
+    c.hdr.version = HISTZ_VERSION;
+    c.hdr.channels = HIST_CHANNELS;
+    c.hdr.date = date;
+    c.hdr.dayStart = dateToEpoch(date);
+    c.hour = -1;
+    c.oLen = 0;
+
+    c.out = storage.open(c.tmpPath.c_str(), FILE_WRITE);
+    if (!c.out) {
+        histClose(c.src);
+        return false;
+    }
+    // The header is written last, once the hour blocks are known
+    c.out.write((const uint8_t*)&c.hdr, sizeof(c.hdr));
+    c.outPos = sizeof(c.hdr);
+    return true;
+}
+
+// Encodes up to maxRecords; 1 = more to do, 0 = done, -1 = failed
+int histCompactStep(HistCompactor& c, uint16_t maxRecords) {
+    HistRecord rec;
+    for (uint16_t i = 0; i < maxRecords; i++) {
+        if (!histNext(c.src, rec)) {
+            histZFlushOut(c);
+            c.out.seek(0);
+            bool ok = c.out.write((const uint8_t*)&c.hdr, sizeof(c.hdr)) == sizeof(c.hdr);
+            c.out.close();
+            histClose(c.src);
+            return ok ? 0 : -1;
+        }
+        if (rec.ts < c.hdr.dayStart || rec.ts - c.hdr.dayStart >= 86400UL) continue;
+
+        int8_t hour = (rec.ts - c.hdr.dayStart) / 3600;
+        if (hour != c.hour) {
+            histZFlushOut(c);
+            c.hour = hour;
+            c.hdr.hourOffset[hour] = c.outPos;
+            c.prev.ts = c.hdr.dayStart + hour * 3600UL;
+            memset(c.prev.v, 0, sizeof(c.prev.v));
+        }
+        if (c.hdr.hourCount[hour] == UINT16_MAX) continue;
+
+        histZPut(c, rec.ts - c.prev.ts);
+        for (uint8_t ch = 0; ch < HIST_CHANNELS; ch++) {
+            int32_t d = rec.v[ch] - c.prev.v[ch];
+            histZPut(c, ((uint32_t)d << 1) ^ (uint32_t)(d >> 31));
+        }
+        c.prev = rec;
+        c.hdr.hourCount[hour]++;
+        c.hdr.count++;
+    }
+    return 1;
+}
+
+// Replaces the raw day file; a journal lets histCompactRecover() finish
+// the swap after a reset between the remove and the rename
+bool histCompactCommit(HistCompactor& c) {
+    File jnl = storage.open(HISTZ_JOURNAL, FILE_WRITE);
+    if (!jnl) return false;
+    jnl.write((const uint8_t*)&c.hdr.date, sizeof(c.hdr.date));
+    jnl.close();
+
+    bool ok = storage.remove(c.path.c_str()) && storage.rename(c.tmpPath.c_str(), c.path.c_str());
+    storage.remove(HISTZ_JOURNAL);
+    return ok;
+}
+
+void histCompactAbort(HistCompactor& c) {
+    if (c.out) c.out.close();
+    histClose(c.src);
+    storage.remove(c.tmpPath.c_str());
+}
+
+void histCompactRecover() {
+    if (!storage.exists(HISTZ_JOURNAL)) return;
+    File jnl = storage.open(HISTZ_JOURNAL, FILE_READ);
+    uint32_t date = 0;
+    if (jnl) {
+        jnl.read((uint8_t*)&date, sizeof(date));
+        jnl.close();
+    }
+    if (date) {
+        String path = histPath(date);
+        String tmpPath = path + ".tmp";
+        if (storage.exists(tmpPath.c_str())) {
+            if (storage.exists(path.c_str())) storage.remove(path.c_str());
+            storage.rename(tmpPath.c_str(), path.c_str());
+            LOGI(LOG_MOD_SD, "SD:Finished interrupted compaction of %s", path);
+        }
+    }
+    storage.remove(HISTZ_JOURNAL);
+}
@@ -0,0 +1,126 @@
+// hist.h - Binary sensor history module header
+#ifndef HIST_H
+#define HIST_H
+
+#include "config.h"
+#include "storage.h"
+
+#define HIST_MAGIC          0x31534852UL  // "RHS1"
+#define HIST_VERSION        2             // v2: CRC16 after every record
+#define HIST_CHANNELS       14
+#define HIST_HOURS          24
+#define HIST_NO_INDEX       0xFFFF
+#define HIST_READ_BATCH     8             // records per SD read in histNext()
+#define HIST_FRAME_SIZE     (sizeof(HistRecord) + sizeof(uint16_t))
+#define HIST_RECOVER_MAX    64            // tail frames checked when a day file is opened
+#define HISTZ_MAGIC         0x315A5352UL  // "RSZ1"
+#define HISTZ_VERSION       1
+#define HISTZ_OUT_BUF       256
+#define HISTZ_JOURNAL       "/compact.jnl"
+
+#define HIST_CSV_HEADER "Čas zapisa,Temperatura zunaj,Vlaga zunaj,Tlak zunaj,VOC zunaj,Svetloba zunaj,Temperatura DS,Vlaga DS,CO2 DS,Temperatura UT,Vlaga UT,Temperatura KOP,Vlaga KOP,Tlak WC,Vremenski code"
+
+// Channel order matches the columns of the legacy history_sens CSV
+enum HistChannel {
+    HC_EXT_TEMP = 0, HC_EXT_HUM, HC_EXT_PRES, HC_EXT_VOC, HC_EXT_LUX,
+    HC_DS_TEMP, HC_DS_HUM, HC_DS_CO2,
+    HC_UT_TEMP, HC_UT_HUM,
+    HC_KOP_TEMP, HC_KOP_HUM,
+    HC_WC_PRES, HC_WEATHER
+};
+
+// One sample; values are stored as value * histScale[ch]
+struct __attribute__((packed)) HistRecord {
+    uint32_t ts;                    // local epoch seconds (myTZ.now())
+    int32_t v[HIST_CHANNELS];
+};
+
+// Day file header; hourIndex holds the first record number of each hour.
+// In v2 files every record is followed by calcCRC16() of its bytes and
+// recordSize is the frame size; v1 files (no CRC) are still read and appended.
+struct __attribute__((packed)) HistHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t recordSize;            // bytes per record frame on disk
+    uint8_t channels;
+    uint8_t reserved[3];
+    uint32_t date;                  // YYYYMMDD
+    uint32_t dayStart;              // local epoch of 00:00:00
+    uint16_t hourIndex[HIST_HOURS];
+};
+
+// Header of a compacted (closed) day. Records are grouped in hourly blocks;
+// each record is a varint ts delta followed by zigzag varint value deltas,
+// and every block restarts from ts = hour start and all values 0
+struct __attribute__((packed)) HistZHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t channels;
+    uint8_t reserved;
+    uint32_t date;                  // YYYYMMDD
+    uint32_t dayStart;
+    uint32_t count;
+    uint32_t hourOffset[HIST_HOURS];    // file offset of each hour block
+    uint16_t hourCount[HIST_HOURS];     // records in each hour block
+};
+
+// Sequential reader over one day file, positioned by histOpen()
+struct HistReader {
+    File file;
+    uint32_t count;                 // records in file
+    uint32_t pos;                   // index of the next record returned
+    uint32_t fromTs;
+    uint32_t toTs;
+    uint16_t recSize;               // frame size of a raw file
+    uint8_t buf[HIST_READ_BATCH * HIST_FRAME_SIZE];
+    uint8_t bufLen;
+    uint8_t bufPos;
+    // Compacted files only
+    bool compact;
+    uint32_t dayStart;
+    uint8_t hour;                   // current hour block
+    uint16_t blockLeft;
+    uint16_t hourCount[HIST_HOURS];
+    uint16_t zLen;
+    uint16_t zPos;
+    HistRecord prev;
+};
+
+// Incremental rewrite of one closed day into the compacted format
+struct HistCompactor {
+    HistReader src;
+    File out;
+    String path;
+    String tmpPath;
+    HistZHeader hdr;
+    HistRecord prev;
+    int8_t hour;
+    uint32_t outPos;
+    uint8_t obuf[HISTZ_OUT_BUF];
+    uint16_t oLen;
+};
+
+extern const uint8_t histScale[HIST_CHANNELS];
+
+// Function declarations
+bool histAppend(const HistRecord& rec);
+void histFromSensorData(HistRecord& rec, uint32_t ts);
+float histValue(const HistRecord& rec, uint8_t ch);
+bool histOpen(HistReader& r, const char* path, uint32_t fromTs = 0, uint32_t toTs = UINT32_MAX);
+bool histNext(HistReader& r, HistRecord& rec);
+void histClose(HistReader& r);
+bool histRecover(const String& path);
+size_t histFormatTime(uint32_t ts, char* out, size_t len);
+size_t histFormatValue(const HistRecord& rec, uint8_t ch, char* out, size_t len);
+size_t histFormatCsv(const HistRecord& rec, char* out, size_t len);
+uint32_t histDateOf(uint32_t ts);
+String histPath(uint32_t date);
+void histMigrateCsv();
+bool histIsCompact(const char* path);
+bool histCompactBegin(HistCompactor& c, uint32_t date);
+int histCompactStep(HistCompactor& c, uint16_t maxRecords);
+bool histCompactCommit(HistCompactor& c);
+void histCompactAbort(HistCompactor& c);
+void histCompactRecover();
+
+#endif // HIST_H
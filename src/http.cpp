@@ -3,6 +3,14 @@
 #include "globals.h"
 #include "sd.h"
 #include "logging.h"
+#include "appender.h"
+#include "recent.h"
+#include "tier.h"
+#include "jobs.h"
+#include "retention.h"
+#include "series.h"
+#include "live.h"
+#include "api.h"
 #include <WiFi.h>
 #include <AsyncTCP.h>
 #include <ESPAsyncWebServer.h>
@@ -14,11 +22,22 @@ AsyncWebServer server(80);
 // Flag to track first HTTP attempt after boot (longer timeout)
 static bool firstHttpAttempt = true;
 
-// Forward declaration for lambda functions
-extern void logEvent(String content);
+static void sendApiPage(AsyncWebServerRequest *request, ApiResource resource) {
+    if (sensorData.errorFlags[0] & ERR_SD) {
+        request->send(503, "application/json", "{\"error\":\"SD unavailable\"}");
+        return;
+    }
+    ApiPage page;
+    const char *error = apiPageArgs(request, resource, page);
+    if (error) {
+        request->send(400, "application/json", String("{\"error\":\"") + error + "\"}");
+        return;
+    }
+    request->send(beginApiPage(request, page));
+}
 
 bool setupServer() {
-    logEvent("HTTP:Setting up server endpoints");
+    LOGD(LOG_MOD_HTTP, "HTTP:Setting up server endpoints");
     // Endpoint for receiving data from external unit
     server.on("/data", HTTP_POST,
         [](AsyncWebServerRequest *request){},
@@ -30,11 +49,11 @@ bool setupServer() {
                 body += (char)data[i];
             }
             if (index + len == total) {
-                Serial.println("HTTP: Received /data body: " + body);
+                LOGD(LOG_MOD_HTTP, "HTTP:Recv /data body: %s", body);
                 DynamicJsonDocument doc(256);
                 DeserializationError error = deserializeJson(doc, body);
                 if (error) {
-                    Serial.println("HTTP: JSON parse error: " + String(error.c_str()));
+                    LOGW(LOG_MOD_HTTP, "HTTP:JSON parse error: %s", error.c_str());
                     request->send(400, "text/plain", "Invalid JSON");
                     return;
                 }
@@ -43,14 +62,12 @@ bool setupServer() {
                 sensorData.extPressure = doc["pressure"] | 0.0f;
                 sensorData.extVOC = doc["voc"] | 0.0f;
                 sensorData.extLux = doc["lux"] | 0.0f;
-                Serial.println("HTTP: Parsed values: temp=" + String(sensorData.extTemp, 1) + " hum=" + String(sensorData.extHumidity, 1) + " pressure=" + String(sensorData.extPressure, 1) + " voc=" + String(sensorData.extVOC, 0) + " lux=" + String(sensorData.extLux, 0));
                 lastSEWReceive = millis();
+                recentRecord();
                 request->send(200, "application/json", "{\"status\":\"OK\"}");
-                logEvent("HTTP:Recv SEW temp=" + String(sensorData.extTemp, 1) +
-                         " hum=" + String(sensorData.extHumidity, 1) +
-                         " pressure=" + String(sensorData.extPressure, 1) +
-                         " voc=" + String(sensorData.extVOC, 0) +
-                         " lux=" + String(sensorData.extLux, 0));
+                LOGD(LOG_MOD_HTTP, "HTTP:Recv SEW temp=%.1f hum=%.1f pressure=%.1f voc=%.0f lux=%.0f",
+                     sensorData.extTemp, sensorData.extHumidity, sensorData.extPressure, sensorData.extVOC,
+                     sensorData.extLux);
             }
         }
     );
@@ -60,6 +77,120 @@ bool setupServer() {
         request->send(200, "text/plain", "pong");
     });
 
+    // SD appender flush statistics
+    server.on("/api/appender", HTTP_GET, [](AsyncWebServerRequest *request){
+        request->send(200, "application/json", appenderStatsJson());
+    });
+
+    server.on("/api/tier", HTTP_GET, [](AsyncWebServerRequest *request){
+        request->send(200, "application/json", tierStatsJson());
+    });
+
+    server.on("/api/retention", HTTP_GET, [](AsyncWebServerRequest *request){
+        request->send(200, "application/json", retentionJson());
+    });
+
+    server.on("/api/logstats", HTTP_GET, [](AsyncWebServerRequest *request){
+        request->send(200, "application/json", logStatsJson());
+    });
+
+    // Live log records and sensor values as Server-Sent Events ("log" and
+    // "sensor"); the /logs page tails it
+    server.on("/api/live", HTTP_GET, [](AsyncWebServerRequest *request){
+        AsyncWebServerResponse *response = beginLiveStream(request);
+        if (!response) {
+            request->send(503, "application/json", "{\"error\":\"too many live clients\"}");
+            return;
+        }
+        request->send(response);
+    });
+
+    server.on("/api/livestats", HTTP_GET, [](AsyncWebServerRequest *request){
+        request->send(200, "application/json", liveStatsJson());
+    });
+
+    // Per-module log thresholds: /api/loglevel lists them,
+    // /api/loglevel?module=HTTP&level=debug (or module=all) sets them until reboot
+    server.on("/api/loglevel", HTTP_GET | HTTP_POST, [](AsyncWebServerRequest *request){
+        if (request->hasArg("module") || request->hasArg("level")) {
+            String moduleStr = request->arg("module");
+            int level = logLevelByName(request->arg("level"));
+            int module = moduleStr.equalsIgnoreCase("all") ? LOG_MODULES : logModuleByName(moduleStr);
+            if (module < 0 || level < 0) {
+                request->send(400, "application/json", "{\"error\":\"unknown module or level\"}");
+                return;
+            }
+            for (uint8_t m = 0; m < LOG_MODULES; m++) {
+                if (module == LOG_MODULES || m == module) logSetLevel(m, level);
+            }
+            LOGI(LOG_MOD_WEB, "WEB: Log level %s set to %s", moduleStr, request->arg("level"));
+        }
+        request->send(200, "application/json", logLevelsJson());
+    });
+
+    // /api/jobs lists recent jobs, /api/jobs/<id> reports one (the handler
+    // also matches sub-paths of its URI)
+    server.on("/api/jobs", HTTP_GET, [](AsyncWebServerRequest *request){
+        String url = request->url();
+        if (url == "/api/jobs" || url == "/api/jobs/") {
+            request->send(200, "application/json", jobsJson());
+            return;
+        }
+        String json;
+        uint32_t id = strtoul(url.c_str() + strlen("/api/jobs/"), NULL, 10);
+        if (!jobJson(id, json)) {
+            request->send(404, "application/json", "{\"error\":\"unknown job\"}");
+            return;
+        }
+        request->send(200, "application/json", json);
+    });
+
+    // Recent samples from the RAM ring buffer (no SD access)
+    server.on("/api/recent", HTTP_GET, [](AsyncWebServerRequest *request){
+        String hoursStr = request->arg("hours");
+        String pointsStr = request->arg("points");
+        uint32_t hours = hoursStr.length() > 0 ? max(1L, hoursStr.toInt()) : 24;
+        uint32_t span = min((uint32_t)(hours * 3600UL), recentSpan());
+        uint16_t points = pointsStr.length() > 0 ? pointsStr.toInt() : RECENT_JSON_POINTS;
+        uint32_t toTs = timeSynced ? myTZ.now() : recentLastTs();
+        request->send(200, "application/json", recentJson(toTs - span + 1, toTs, points, request->arg("ch")));
+    });
+
+    // One channel over a range: /api/series?ch=localCO2&from=<epoch>&to=<epoch>
+    // [&points=N]; closed days are read from their column files
+    server.on("/api/series", HTTP_GET, [](AsyncWebServerRequest *request){
+        if (sensorData.errorFlags[0] & ERR_SD) {
+            request->send(503, "application/json", "{\"error\":\"SD unavailable\"}");
+            return;
+        }
+        int ch = seriesChannel(request->arg("ch"));
+        if (ch < 0) {
+            request->send(400, "application/json", "{\"error\":\"unknown channel\"}");
+            return;
+        }
+        String toStr = request->arg("to");
+        String fromStr = request->arg("from");
+        uint32_t toTs = toStr.length() > 0 ? (uint32_t)toStr.toInt() : (uint32_t)myTZ.now();
+        uint32_t fromTs = fromStr.length() > 0 ? (uint32_t)fromStr.toInt() : toTs - 86399UL;
+        if (fromTs > toTs || toTs - fromTs > SERIES_MAX_SPAN) {
+            request->send(400, "application/json", "{\"error\":\"invalid range\"}");
+            return;
+        }
+        uint16_t points = constrain(request->arg("points").toInt(), 0L, (long)SERIES_MAX_POINTS);
+        request->send(beginSeries(request, ch, fromTs, toTs, points));
+    });
+
+    // Paged history and logs: /api/v1/history and /api/v1/logs with
+    // [from=<epoch>&to=<epoch>][&fields=a,b][&limit=N][&cursor=<next>]; the
+    // next page is asked for with the same arguments plus the "next" cursor
+    server.on("/api/v1/history", HTTP_GET, [](AsyncWebServerRequest *request){
+        sendApiPage(request, API_HISTORY);
+    });
+
+    server.on("/api/v1/logs", HTTP_GET, [](AsyncWebServerRequest *request){
+        sendApiPage(request, API_LOGS);
+    });
+
     // STATUS_UPDATE endpoint
     server.on("/api/status-update", HTTP_POST, [](AsyncWebServerRequest *request){
         String body = request->arg("plain");
@@ -67,7 +198,7 @@ bool setupServer() {
         DeserializationError error = deserializeJson(doc, body);
         if (error) {
             request->send(400, "text/plain", "Invalid JSON");
-            logEvent("HTTP:Invalid STATUS_UPDATE JSON");
+            LOGW(LOG_MOD_HTTP, "HTTP:Invalid STATUS_UPDATE JSON");
             return;
         }
         if (doc.containsKey("fanStates")) {
@@ -93,8 +224,9 @@ bool setupServer() {
         if (doc.containsKey("errorFlags")) {
             for (int i = 0; i < 5; i++) sensorData.errorFlags[i] = doc["errorFlags"][i].as<uint8_t>();
         }
-        logEvent("HTTP:STATUS_UPDATE received power=" + String(sensorData.currentPower, 1));
+        LOGD(LOG_MOD_HTTP, "HTTP:STATUS_UPDATE received power=%.1f", sensorData.currentPower);
         lastStatusUpdate = millis();
+        recentRecord();
         request->send(200, "application/json", "{\"status\":\"OK\"}");
         extern void updateCards();
         updateCards();
@@ -108,51 +240,44 @@ bool setupServer() {
         DeserializationError error = deserializeJson(doc, body);
         if (error) {
             request->send(400, "text/plain", "Invalid JSON");
-            logEvent("HTTP:Invalid LOGS JSON");
+            LOGW(LOG_MOD_HTTP, "HTTP:Invalid LOGS JSON");
             return;
         }
 
         String logsContent = doc["logs"] | "";
         if (logsContent.length() == 0) {
             request->send(400, "text/plain", "No logs content");
-            logEvent("HTTP:No logs content in request");
+            LOGW(LOG_MOD_HTTP, "HTTP:No logs content in request");
             return;
         }
 
-        logEvent("HTTP:Received " + String(logsContent.length()) + " bytes of CEW logs");
-
-        // Append CEW logs to current date file
-        String currentDate = myTZ.dateTime("Ymd");
-        String logFileName = "/logs_" + currentDate + ".txt";
+        LOGD(LOG_MOD_HTTP, "HTTP:Received %u bytes of CEW logs", logsContent.length());
 
-        File logFile = SD_MMC.open(logFileName.c_str(), FILE_APPEND);
-        if (!logFile) {
-            logEvent("HTTP:Failed to open log file for CEW logs: " + logFileName);
-            request->send(500, "text/plain", "Failed to open log file");
+        // Into the current day file through the log writer, with its own lines
+        size_t queued = logAppendLines(logsContent.c_str(), logsContent.length());
+        if (queued == 0) {
+            LOGE(LOG_MOD_HTTP, "HTTP:Log queue full, CEW logs refused");
+            request->send(503, "text/plain", "Log queue full");
             return;
         }
-
-        size_t bytesWritten = logFile.print(logsContent);
-        logFile.close();
-
-        if (bytesWritten > 0) {
-            logEvent("HTTP:Appended " + String(bytesWritten) + " bytes of CEW logs to " + logFileName);
-            // Flush REW buffer after receiving CEW logs
-            extern void flushBufferToSD();
-            flushBufferToSD();
+        if (queued < logsContent.length()) {
+            LOGW(LOG_MOD_HTTP, "HTTP:Log queue full, %u of %u bytes of CEW logs queued", queued,
+                 logsContent.length());
         } else {
-            logEvent("HTTP:Failed to write CEW logs to file");
+            LOGI(LOG_MOD_HTTP, "HTTP:Queued %u bytes of CEW logs", queued);
         }
+        // Flush REW buffer after receiving CEW logs
+        logRequestFlush();
 
         request->send(200, "application/json", "{\"status\":\"OK\"}");
     });
 
     setupWebEndpoints();
 
-    logEvent("HTTP:Starting server");
+    LOGD(LOG_MOD_HTTP, "HTTP:Starting server");
     server.begin();
     webServerRunning = true;
-    logEvent("HTTP:Server started");
+    LOGI(LOG_MOD_HTTP, "HTTP:Server started");
     return true;
 }
 
@@ -163,10 +288,10 @@ void handleClient() {
 
 
 void sendToCEW(String method, String endpoint, String jsonPayload) {
-    logEvent("HTTP:Send " + method + " to " + endpoint + " payload=" + jsonPayload);
+    LOGD(LOG_MOD_HTTP, "HTTP:Send %s to %s payload=%s", method, endpoint, jsonPayload);
 
     if (!connection_ok || WiFi.status() != WL_CONNECTED) {
-        logEvent("HTTP:Not sent - connection not OK or WiFi err");
+        LOGW(LOG_MOD_HTTP, "HTTP:Not sent - connection not OK or WiFi err");
         sensorData.errorFlags[0] |= ERR_HTTP;
         return;
     }
@@ -180,7 +305,7 @@ void sendToCEW(String method, String endpoint, String jsonPayload) {
     http.setConnectTimeout(timeout);
     String url = "http://" + String(CEW_IP) + endpoint;
     if (!http.begin(url)) {
-        logEvent("HTTP:Begin failed for " + url);
+        LOGE(LOG_MOD_HTTP, "HTTP:Begin failed for %s", url);
         connection_ok = false;
         return;
     }
@@ -191,17 +316,17 @@ void sendToCEW(String method, String endpoint, String jsonPayload) {
     } else if (method == "GET") {
         httpCode = http.GET();
     } else {
-        logEvent("HTTP:Invalid method " + method);
+        LOGE(LOG_MOD_HTTP, "HTTP:Invalid method %s", method);
         http.end();
         return;
     }
     if (httpCode == HTTP_CODE_OK) {
         lastSuccessfulHeartbeat = millis();
         connection_ok = true;
-        logEvent("HTTP:Send OK to " + endpoint);
+        LOGD(LOG_MOD_HTTP, "HTTP:Send OK to %s", endpoint);
         sensorData.errorFlags[0] &= ~ERR_HTTP;
     } else {
-        logEvent("HTTP:Send failed code=" + String(httpCode) + " to " + endpoint);
+        LOGW(LOG_MOD_HTTP, "HTTP:Send failed code=%d to %s", httpCode, endpoint);
         delay(1000);
         yield();
         // 1x retry
@@ -213,9 +338,9 @@ void sendToCEW(String method, String endpoint, String jsonPayload) {
         if (httpCode == HTTP_CODE_OK) {
             lastSuccessfulHeartbeat = millis();
             connection_ok = true;
-            logEvent("HTTP:Send OK (retry) to " + endpoint);
+            LOGI(LOG_MOD_HTTP, "HTTP:Send OK (retry) to %s", endpoint);
         } else {
-            logEvent("HTTP:Not sent - CEW offline");
+            LOGE(LOG_MOD_HTTP, "HTTP:Not sent - CEW offline");
             connection_ok = false;
             sensorData.errorFlags[0] |= ERR_HTTP;
         }
@@ -236,7 +361,7 @@ bool sendHeartbeat() {
 
     String url = "http://" + String(CEW_IP) + "/api/ping";
     if (!http.begin(url)) {
-        logEvent("HTTP:Heartbeat begin failed");
+        LOGE(LOG_MOD_HTTP, "HTTP:Heartbeat begin failed");
         return false;
     }
     int httpCode = http.GET();
@@ -245,27 +370,27 @@ bool sendHeartbeat() {
         lastSuccessfulHeartbeat = millis();
         sensorData.errorFlags[0] &= ~ERR_HTTP;
         connection_ok = true;
-        logEvent("HTTP:Heartbeat success");
+        LOGD(LOG_MOD_HTTP, "HTTP:Heartbeat success");
         return true;
     } else {
-        logEvent("HTTP:Heartbeat failed code=" + String(httpCode) + " (timeout=" + String(timeout) + "ms)");
+        LOGW(LOG_MOD_HTTP, "HTTP:Heartbeat failed code=%d (timeout=%dms)", httpCode, timeout);
         connection_ok = false;
         return false;
     }
 }
 
 void fetchWeather() {
-    logEvent("Weather:Starting weather fetch");
+    LOGD(LOG_MOD_WEATHER, "Weather:Starting weather fetch");
     if (WiFi.status() != WL_CONNECTED) {
-        logEvent("Weather:Skipped - WiFi not connected");
+        LOGW(LOG_MOD_WEATHER, "Weather:Skipped - WiFi not connected");
         return;
     }
 
     HTTPClient http;
-    logEvent("Weather:Requesting from " + String(METEO_URL));
+    LOGD(LOG_MOD_WEATHER, "Weather:Requesting from %s", METEO_URL);
     http.begin(METEO_URL);
     int httpResponseCode = http.GET();
-    logEvent("Weather:HTTP response code: " + String(httpResponseCode));
+    LOGD(LOG_MOD_WEATHER, "Weather:HTTP response code: %d", httpResponseCode);
 
     if (httpResponseCode > 0) {
         String payload = http.getString();
@@ -273,13 +398,13 @@ void fetchWeather() {
         deserializeJson(doc, payload);
         int weatherCode = doc["current"]["weather_code"];
         sensorData.weatherCode = weatherCode;
-        logEvent("Weather:Received weather code: " + String(weatherCode));
+        LOGD(LOG_MOD_WEATHER, "Weather:Received weather code: %d", weatherCode);
 
         // Update weather icon immediately
         extern void updateWeatherIcon();
         updateWeatherIcon();
     } else {
-        logEvent("Weather:Failed to fetch weather data");
+        LOGE(LOG_MOD_WEATHER, "Weather:Failed to fetch weather data");
         sensorData.errorFlags[0] |= ERR_HTTP;
     }
     http.end();
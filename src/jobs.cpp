@@ -0,0 +1,216 @@
+// jobs.cpp - Background SD maintenance jobs implementation
+#include "jobs.h"
+#include "globals.h"
+#include "logging.h"
+#include "layout.h"
+#include "logsearch.h"
+#include "storage.h"
+#include <ArduinoJson.h>
+
+#define JOB_QUEUE_MAX 4             // unfinished jobs accepted at once
+
+static std::vector<Job> jobs;
+static uint32_t jobNextId = 1;
+
+// Jobs are submitted from AsyncTCP handlers and worked off in loop()
+static SemaphoreHandle_t jobLock = NULL;
+
+static void lockJobs() {
+    if (jobLock) xSemaphoreTakeRecursive(jobLock, portMAX_DELAY);
+}
+
+static void unlockJobs() {
+    if (jobLock) xSemaphoreGiveRecursive(jobLock);
+}
+
+void initJobs() {
+    if (!jobLock) jobLock = xSemaphoreCreateRecursiveMutex();
+}
+
+static bool jobFinished(const Job& job) {
+    return job.state == JOB_DONE || job.state == JOB_FAILED;
+}
+
+static const char* jobTypeName(uint8_t type) {
+    return type == JOB_RETENTION ? "retention" : "delete";
+}
+
+static const char* jobStateName(uint8_t state) {
+    static const char* names[] = {"queued", "running", "done", "failed"};
+    return state <= JOB_FAILED ? names[state] : "unknown";
+}
+
+// Drops the oldest finished jobs beyond JOB_HISTORY
+static void jobPrune() {
+    size_t finished = 0;
+    for (const Job& job : jobs) finished += jobFinished(job);
+    for (size_t i = 0; i < jobs.size() && finished > JOB_HISTORY;) {
+        if (jobFinished(jobs[i])) {
+            jobs.erase(jobs.begin() + i);
+            finished--;
+        } else {
+            i++;
+        }
+    }
+}
+
+static uint32_t jobSubmit(uint8_t type, uint8_t typeMask, uint32_t beforeDate, const std::vector<ManifestEntry>* files) {
+    lockJobs();
+    size_t active = 0;
+    for (const Job& job : jobs) active += !jobFinished(job);
+    if (active >= JOB_QUEUE_MAX) {
+        unlockJobs();
+        return JOB_NONE;
+    }
+    jobPrune();
+    Job job;
+    job.id = jobNextId++;
+    job.type = type;
+    job.state = JOB_QUEUED;
+    job.typeMask = typeMask;
+    job.beforeDate = beforeDate;
+    job.next = 0;
+    job.removed = 0;
+    job.failed = 0;
+    job.bytes = 0;
+    job.submitMs = millis();
+    job.startMs = 0;
+    job.endMs = 0;
+    if (files) job.work = *files;
+    jobs.push_back(job);
+    uint32_t id = job.id;
+    unlockJobs();
+    return id;
+}
+
+// Queues removal of the day files of every type in typeMask dated before
+// beforeDate. Returns the job id, or JOB_NONE when the queue is full.
+uint32_t jobSubmitDelete(uint8_t typeMask, uint32_t beforeDate, uint8_t type) {
+    return jobSubmit(type, typeMask, beforeDate, NULL);
+}
+
+// Queues removal of the given day files, in list order
+uint32_t jobSubmitFiles(const std::vector<ManifestEntry>& files, uint8_t type) {
+    return jobSubmit(type, 0, 0, &files);
+}
+
+bool jobPending(uint32_t id) {
+    bool pending = false;
+    lockJobs();
+    for (const Job& job : jobs) {
+        if (job.id == id) pending = !jobFinished(job);
+    }
+    unlockJobs();
+    return pending;
+}
+
+// The manifest is read when the job starts, not when it is submitted, so
+// the AsyncTCP handler only queues
+static void jobStart(Job& job) {
+    for (uint8_t t = 0; t < MF_TYPES && job.beforeDate > 0; t++) {
+        if (!(job.typeMask & (1 << t))) continue;
+        std::vector<ManifestEntry> files = manifestRange(t, 0, job.beforeDate - 1);
+        job.work.insert(job.work.end(), files.begin(), files.end());
+    }
+    job.state = JOB_RUNNING;
+    job.startMs = millis();
+}
+
+static bool jobRemove(const ManifestEntry& e) {
+    String path = layoutPath(e.type, e.date);
+    if (!storage.remove(path.c_str())) return false;
+    if (e.type == MF_LOGS) {
+        storage.remove(logIndexPath(e.date).c_str());
+        storage.remove(logSearchPath(e.date).c_str());
+    }
+    if (e.type == MF_SENS) storage.remove(layoutColumnsPath(e.date).c_str());
+    manifestRemove(path);
+    return true;
+}
+
+static void jobFinish(Job& job) {
+    job.state = job.removed == 0 && job.failed > 0 ? JOB_FAILED : JOB_DONE;
+    job.endMs = millis();
+    std::vector<ManifestEntry>().swap(job.work);
+    LOGI(LOG_MOD_SD, "JOB:%lu %s %s, removed %lu failed %lu in %lu ms", job.id,
+         jobTypeName(job.type), jobStateName(job.state), job.removed, job.failed, job.endMs - job.startMs);
+}
+
+// Works off a few files of the oldest unfinished job
+void jobsTick() {
+    if (sensorData.errorFlags[0] & ERR_SD) return;
+    lockJobs();
+    Job* job = NULL;
+    for (Job& j : jobs) {
+        if (!jobFinished(j)) {
+            job = &j;
+            break;
+        }
+    }
+    if (!job) {
+        unlockJobs();
+        return;
+    }
+    if (job->state == JOB_QUEUED) jobStart(*job);
+
+    uint32_t start = millis();
+    for (int n = 0; n < JOB_FILES_PER_TICK && job->next < job->work.size(); n++) {
+        const ManifestEntry& e = job->work[job->next++];
+        if (jobRemove(e)) {
+            job->removed++;
+            job->bytes += e.size;
+        } else {
+            job->failed++;
+        }
+        if (millis() - start >= JOB_TICK_BUDGET_MS) break;
+    }
+    if (job->next >= job->work.size()) jobFinish(*job);
+    unlockJobs();
+}
+
+static void jobToJson(const Job& job, JsonObject o) {
+    o["id"] = job.id;
+    o["type"] = jobTypeName(job.type);
+    o["state"] = jobStateName(job.state);
+    o["before"] = job.beforeDate;
+    bool started = job.state != JOB_QUEUED;
+    size_t total = started ? (jobFinished(job) ? job.removed + job.failed : job.work.size()) : 0;
+    o["total"] = total;
+    o["done"] = job.removed + job.failed;
+    o["removed"] = job.removed;
+    o["failed"] = job.failed;
+    o["bytes"] = job.bytes;
+    o["progress"] = total ? (job.removed + job.failed) * 100 / total : (jobFinished(job) ? 100 : 0);
+    uint32_t elapsed = started ? (jobFinished(job) ? job.endMs : millis()) - job.startMs : 0;
+    o["queuedMs"] = started ? job.startMs - job.submitMs : millis() - job.submitMs;
+    o["elapsedMs"] = elapsed;
+    o["filesPerSec"] = elapsed ? (float)(job.removed + job.failed) * 1000.0f / elapsed : 0.0f;
+    o["bytesPerSec"] = elapsed ? (uint32_t)((uint64_t)job.bytes * 1000 / elapsed) : 0;
+}
+
+bool jobJson(uint32_t id, String& json) {
+    JsonDocument doc;
+    bool found = false;
+    lockJobs();
+    for (const Job& job : jobs) {
+        if (job.id == id) {
+            jobToJson(job, doc.to<JsonObject>());
+            found = true;
+            break;
+        }
+    }
+    unlockJobs();
+    if (found) serializeJson(doc, json);
+    return found;
+}
+
+String jobsJson() {
+    JsonDocument doc;
+    JsonArray arr = doc.to<JsonArray>();
+    lockJobs();
+    for (const Job& job : jobs) jobToJson(job, arr.add<JsonObject>());
+    unlockJobs();
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
@@ -0,0 +1,45 @@
+// jobs.h - Background SD maintenance jobs header
+#ifndef JOBS_H
+#define JOBS_H
+
+#include "config.h"
+#include "manifest.h"
+#include <vector>
+
+#define JOB_FILES_PER_TICK  4             // files removed per jobsTick()
+#define JOB_TICK_BUDGET_MS  20            // stop a tick early past this
+#define JOB_HISTORY         8             // finished jobs kept for /api/jobs
+#define JOB_NONE            0
+
+enum JobType : uint8_t { JOB_DELETE, JOB_RETENTION };
+enum JobState : uint8_t { JOB_QUEUED, JOB_RUNNING, JOB_DONE, JOB_FAILED };
+
+// A deletion over a snapshot of the manifest taken when the job starts, or
+// over an explicit list (typeMask 0); the entries are worked off from the
+// front, a few per loop() pass
+struct Job {
+    uint32_t id;
+    uint8_t type;
+    uint8_t state;
+    uint8_t typeMask;               // bit per ManifestType
+    uint32_t beforeDate;            // files dated before this are removed
+    std::vector<ManifestEntry> work;
+    size_t next;
+    uint32_t removed;
+    uint32_t failed;
+    uint32_t bytes;                 // manifest size of the removed files
+    uint32_t submitMs;
+    uint32_t startMs;
+    uint32_t endMs;
+};
+
+// Function declarations
+void initJobs();
+uint32_t jobSubmitDelete(uint8_t typeMask, uint32_t beforeDate, uint8_t type = JOB_DELETE);
+uint32_t jobSubmitFiles(const std::vector<ManifestEntry>& files, uint8_t type);
+bool jobPending(uint32_t id);
+void jobsTick();
+bool jobJson(uint32_t id, String& json);
+String jobsJson();
+
+#endif // JOBS_H
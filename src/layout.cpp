@@ -0,0 +1,158 @@
+// layout.cpp - SD year/month directory layout implementation
+#include "layout.h"
+#include "globals.h"
+#include "logging.h"
+#include "storage.h"
+#include <vector>
+
+static const char* const layoutPrefix[MF_TYPES] = {"sens_", "fan_", "logs_"};
+static const char* const layoutSuffix[MF_TYPES] = {".bin", ".csv", ".txt"};
+
+// Month directory created last; saves an exists() per file open
+static String layoutLastDir = "";
+
+String layoutYearDir(uint16_t year) {
+    char out[8];
+    snprintf(out, sizeof(out), "/%04u", year);
+    return String(out);
+}
+
+String layoutMonthDir(uint32_t date) {
+    char out[12];
+    snprintf(out, sizeof(out), "/%04lu/%02lu", (unsigned long)(date / 10000), (unsigned long)((date / 100) % 100));
+    return String(out);
+}
+
+static String layoutFile(uint32_t date, const char* prefix, const char* suffix) {
+    char name[24];
+    snprintf(name, sizeof(name), "/%s%02lu%s", prefix, (unsigned long)(date % 100), suffix);
+    return layoutMonthDir(date) + String(name);
+}
+
+String layoutPath(uint8_t type, uint32_t date) {
+    if (type >= MF_TYPES) return "";
+    return layoutFile(date, layoutPrefix[type], layoutSuffix[type]);
+}
+
+String layoutLogIndexPath(uint32_t date) {
+    return layoutFile(date, layoutPrefix[MF_LOGS], ".idx");
+}
+
+// Keyword index of a day log (logsearch.h); removed together with logs_DD.txt
+String layoutLogSearchPath(uint32_t date) {
+    return layoutFile(date, layoutPrefix[MF_LOGS], ".sdx");
+}
+
+// Column file of a sensor day; removed together with sens_DD.bin
+String layoutColumnsPath(uint32_t date) {
+    return layoutFile(date, "cols_", ".bin");
+}
+
+static bool layoutDigits(const char* p, int n, uint32_t& value) {
+    value = 0;
+    for (int i = 0; i < n; i++) {
+        if (p[i] < '0' || p[i] > '9') return false;
+        value = value * 10 + (p[i] - '0');
+    }
+    return true;
+}
+
+// Parses "/YYYY/MM/<prefix>DD<suffix>"; false for anything else
+bool layoutParse(const String& path, uint8_t& type, uint32_t& date) {
+    const char* p = path.c_str();
+    uint32_t year, month, day;
+    if (p[0] != '/' || !layoutDigits(p + 1, 4, year) || p[5] != '/' ||
+        !layoutDigits(p + 6, 2, month) || p[8] != '/') {
+        return false;
+    }
+    p += 9;
+    for (uint8_t t = 0; t < MF_TYPES; t++) {
+        size_t len = strlen(layoutPrefix[t]);
+        if (strncmp(p, layoutPrefix[t], len) != 0) continue;
+        if (!layoutDigits(p + len, 2, day) || strcmp(p + len + 2, layoutSuffix[t]) != 0) return false;
+        type = t;
+        date = year * 10000 + month * 100 + day;
+        return true;
+    }
+    return false;
+}
+
+// Creates the parent directories of a file path if they are missing
+bool layoutEnsureDir(const String& path) {
+    int slash = path.lastIndexOf('/');
+    if (slash <= 0) return true;
+    String dir = path.substring(0, slash);
+    if (dir == layoutLastDir) return true;
+
+    int pos = 1;
+    while (pos > 0) {
+        pos = dir.indexOf('/', pos + 1);
+        String part = pos < 0 ? dir : dir.substring(0, pos);
+        if (!storage.exists(part.c_str()) && !storage.mkdir(part.c_str())) {
+            LOGE(LOG_MOD_SD, "SD:Mkdir failed for %s", part);
+            return false;
+        }
+    }
+    layoutLastDir = dir;
+    return true;
+}
+
+// Flat-root name of the pre-layout scheme mapped to its new path
+static String layoutFlatTarget(const String& name) {
+    static const struct { const char* prefix; const char* suffix; int8_t type; } flat[] = {
+        {"/history_sens_", ".bin", MF_SENS},
+        {"/fan_history_", ".csv", MF_FAN},
+        {"/logs_", ".txt", MF_LOGS},
+        {"/logs_", ".idx", -1},
+    };
+    const char* p = name.c_str();
+    for (const auto& f : flat) {
+        size_t len = strlen(f.prefix);
+        uint32_t date;
+        if (strncmp(p, f.prefix, len) != 0 || !layoutDigits(p + len, 8, date) ||
+            strcmp(p + len + 8, f.suffix) != 0) {
+            continue;
+        }
+        return f.type < 0 ? layoutLogIndexPath(date) : layoutPath(f.type, date);
+    }
+
+    uint32_t year;
+    if (name.startsWith("/rollup_") && name.length() == 18 && layoutDigits(p + 10, 4, year) &&
+        name.endsWith(".bin")) {
+        return layoutYearDir(year) + name.substring(0, 9) + String(".bin");  // "/rollup_h.bin"
+    }
+    return "";
+}
+
+// One-time move of flat root day files into /YYYY/MM/; renames stay on the
+// same FAT volume, so no data is copied
+void layoutMigrate() {
+    if (sensorData.errorFlags[0] & ERR_SD) return;
+
+    std::vector<String> flat;
+    File root = storage.open("/");
+    if (!root) return;
+    File entry = root.openNextFile();
+    while (entry) {
+        String name = entry.name();
+        bool isDir = entry.isDirectory();
+        entry.close();
+        if (!name.startsWith("/")) name = "/" + name;
+        if (!isDir && layoutFlatTarget(name).length() > 0) flat.push_back(name);
+        entry = root.openNextFile();
+    }
+    root.close();
+    if (flat.empty()) return;
+
+    uint32_t moved = 0, failed = 0;
+    for (const String& name : flat) {
+        String target = layoutFlatTarget(name);
+        if (layoutEnsureDir(target) && !storage.exists(target.c_str()) &&
+            storage.rename(name.c_str(), target.c_str())) {
+            moved++;
+        } else {
+            failed++;
+        }
+    }
+    LOGI(LOG_MOD_SD, "SD:Layout migration moved=%u failed=%u", moved, failed);
+}
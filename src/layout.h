@@ -0,0 +1,22 @@
+// layout.h - SD year/month directory layout header
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+#include "config.h"
+#include "manifest.h"
+
+// Day files live in /YYYY/MM/<prefix>DD<suffix>, e.g. /2026/10/sens_17.bin;
+// per-year files (rollups) in /YYYY/
+
+// Function declarations
+String layoutYearDir(uint16_t year);
+String layoutMonthDir(uint32_t date);
+String layoutPath(uint8_t type, uint32_t date);
+String layoutLogIndexPath(uint32_t date);
+String layoutLogSearchPath(uint32_t date);
+String layoutColumnsPath(uint32_t date);
+bool layoutParse(const String& path, uint8_t& type, uint32_t& date);
+bool layoutEnsureDir(const String& path);
+void layoutMigrate();
+
+#endif // LAYOUT_H
@@ -0,0 +1,193 @@
+// live.cpp - Live log and sensor stream (Server-Sent Events) implementation
+#include "live.h"
+#include "globals.h"
+#include "logging.h"
+#include "hist.h"
+#include "recent.h"
+#include <atomic>
+#include <memory>
+
+// Events are written once into a shared ring; every connection only keeps
+// its read position, so a client costs a few bytes however far behind it is
+// until it falls out of the ring and is dropped
+static char liveRing[LIVE_BACKLOG_SIZE];
+static uint32_t liveHead = 0;           // bytes ever written; ring offset is liveHead % size
+static SemaphoreHandle_t liveLock = NULL;
+
+static std::atomic<uint8_t> liveClients(0);
+static std::atomic<bool> liveSensorWanted(false);
+static int32_t liveSensorLast[RECENT_CHANNELS];
+
+static uint32_t statConnects = 0;
+static uint32_t statRefused = 0;
+static uint32_t statDropped = 0;
+static uint32_t statEvents = 0;
+static uint32_t statSentBytes = 0;
+
+// Per-connection state, released with the response when the socket closes
+struct LiveClient {
+    uint32_t pos;           // next ring byte to send
+    uint32_t lastSendMs;
+    bool hello = true;
+    bool dropped = false;
+
+    ~LiveClient() {
+        liveClients--;
+    }
+};
+
+void initLive() {
+    if (!liveLock) liveLock = xSemaphoreCreateMutex();
+}
+
+// Appends one whole event; called from the log writer task and the loop
+static void liveWrite(const char* event, size_t len) {
+    if (!liveLock || len > LIVE_BACKLOG_SIZE) return;
+    xSemaphoreTake(liveLock, portMAX_DELAY);
+    size_t at = liveHead % LIVE_BACKLOG_SIZE;
+    size_t first = min(len, (size_t)LIVE_BACKLOG_SIZE - at);
+    memcpy(liveRing + at, event, first);
+    memcpy(liveRing, event + first, len - first);
+    liveHead += len;
+    statEvents++;
+    xSemaphoreGive(liveLock);
+}
+
+// Copies up to maxLen pending bytes for one client; false once it has
+// fallen further behind than the ring holds
+static bool liveRead(LiveClient& client, uint8_t* buffer, size_t maxLen, size_t& n) {
+    n = 0;
+    uint32_t lag = liveHead - client.pos;
+    if (lag > LIVE_BACKLOG_SIZE) return false;
+    n = min((size_t)lag, maxLen);
+    size_t at = client.pos % LIVE_BACKLOG_SIZE;
+    size_t first = min(n, (size_t)LIVE_BACKLOG_SIZE - at);
+    memcpy(buffer, liveRing + at, first);
+    memcpy(buffer + first, liveRing, n - first);
+    client.pos += n;
+    return true;
+}
+
+// text/event-stream as a chunked response. The filler runs on the async TCP
+// task: new bytes go out as they arrive, RESPONSE_TRY_AGAIN parks the
+// connection until the next poll, and returning 0 ends the stream of a
+// client that could not keep up (the browser reconnects at the live edge).
+AsyncWebServerResponse* beginLiveStream(AsyncWebServerRequest* request) {
+    if (!liveLock) return NULL;
+    if (liveClients.fetch_add(1) >= LIVE_MAX_CLIENTS) {
+        liveClients--;
+        statRefused++;
+        return NULL;
+    }
+    std::shared_ptr<LiveClient> st = std::make_shared<LiveClient>();
+    xSemaphoreTake(liveLock, portMAX_DELAY);
+    st->pos = liveHead;
+    xSemaphoreGive(liveLock);
+    st->lastSendMs = millis();
+    statConnects++;
+    liveSensorWanted = true;  // current values without waiting for a change
+
+    AsyncWebServerResponse* response = request->beginChunkedResponse("text/event-stream",
+        [st](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+            if (st->dropped) return 0;
+            if (maxLen < 16) return RESPONSE_TRY_AGAIN;
+            uint32_t now = millis();
+            size_t n = 0;
+
+            // Sent right away so the headers go out with it
+            if (st->hello) {
+                st->hello = false;
+                st->lastSendMs = now;
+                n = snprintf((char*)buffer, maxLen, "retry: %d\n\n", LIVE_RETRY_MS);
+                statSentBytes += n;
+                return n;
+            }
+
+            if (xSemaphoreTake(liveLock, 0) != pdTRUE) return RESPONSE_TRY_AGAIN;
+            bool keptUp = liveRead(*st, buffer, maxLen, n);
+            xSemaphoreGive(liveLock);
+            if (!keptUp) {
+                st->dropped = true;
+                statDropped++;
+                LOGW(LOG_MOD_HTTP, "LIVE:Client too slow, dropped");
+                return 0;
+            }
+
+            // An idle stream still sends now and then, so a vanished peer
+            // times out instead of holding a slot
+            if (n == 0) {
+                if (now - st->lastSendMs < LIVE_PING_MS) return RESPONSE_TRY_AGAIN;
+                memcpy(buffer, ":\n\n", 3);
+                n = 3;
+            }
+            st->lastSendMs = now;
+            statSentBytes += n;
+            return n;
+        });
+    response->addHeader("Cache-Control", "no-cache");
+    return response;
+}
+
+// "event: log" with "level|unix|unit|message", from the log writer task
+void liveLog(uint8_t level, const char* line, size_t len) {
+    if (liveClients.load() == 0) return;
+    char event[LIVE_LINE_MAX + 32];
+    size_t n = snprintf(event, sizeof(event), "event: log\ndata: %u|", level);
+    len = min(len, sizeof(event) - n - 2);
+    for (size_t i = 0; i < len; i++) {
+        char c = line[i];
+        event[n++] = (c == '\n' || c == '\r') ? ' ' : c;
+    }
+    event[n++] = '\n';
+    event[n++] = '\n';
+    liveWrite(event, n);
+}
+
+static void liveAppendValue(String& json, uint8_t ch, int32_t v) {
+    char num[16];
+    if (ch >= RECENT_FAN_BASE || histScale[ch] == 1) {
+        snprintf(num, sizeof(num), "%ld", (long)v);
+    } else {
+        snprintf(num, sizeof(num), "%.1f", (float)v / histScale[ch]);
+    }
+    json += num;
+}
+
+// "event: sensor" with the recent.h channels whenever one of them changed;
+// fans are 0/1 here rather than the duty of the stored series
+void liveTick() {
+    static uint32_t lastCheck = 0;
+    if (liveClients.load() == 0) return;
+    uint32_t now = millis();
+    if (!liveSensorWanted && now - lastCheck < LIVE_SENSOR_MS) return;
+    lastCheck = now;
+
+    HistRecord rec;
+    histFromSensorData(rec, myTZ.now());
+    int32_t values[RECENT_CHANNELS];
+    for (uint8_t ch = 0; ch < HIST_CHANNELS; ch++) values[ch] = rec.v[ch];
+    for (uint8_t i = 0; i < ROLLUP_FAN_CHANNELS; i++) {
+        values[RECENT_FAN_BASE + i] = sensorData.fanStates[i] == 1 ? 1 : 0;
+    }
+    if (!liveSensorWanted.exchange(false) && memcmp(values, liveSensorLast, sizeof(values)) == 0) return;
+    memcpy(liveSensorLast, values, sizeof(values));
+
+    String event;
+    event.reserve(48 + RECENT_CHANNELS * 24);
+    event += "event: sensor\ndata: {\"ts\":" + String(rec.ts);
+    for (uint8_t ch = 0; ch < RECENT_CHANNELS; ch++) {
+        event += ",\"";
+        event += recentChannelName(ch);
+        event += "\":";
+        liveAppendValue(event, ch, values[ch]);
+    }
+    event += "}\n\n";
+    liveWrite(event.c_str(), event.length());
+}
+
+String liveStatsJson() {
+    return "{\"clients\":" + String(liveClients.load()) + ",\"maxClients\":" + String(LIVE_MAX_CLIENTS) +
+           ",\"connects\":" + String(statConnects) + ",\"refused\":" + String(statRefused) +
+           ",\"dropped\":" + String(statDropped) + ",\"events\":" + String(statEvents) +
+           ",\"written\":" + String(liveHead) + ",\"sent\":" + String(statSentBytes) + "}";
+}
@@ -0,0 +1,22 @@
+// live.h - Live log and sensor stream (Server-Sent Events) header
+#ifndef LIVE_H
+#define LIVE_H
+
+#include "config.h"
+#include <ESPAsyncWebServer.h>
+
+#define LIVE_BACKLOG_SIZE   8192            // shared event ring; a client further behind is dropped
+#define LIVE_MAX_CLIENTS    4
+#define LIVE_SENSOR_MS      2000UL          // sensorData is compared this often
+#define LIVE_PING_MS        15000UL         // comment line on an idle stream
+#define LIVE_RETRY_MS       3000            // browser reconnect delay after a drop
+#define LIVE_LINE_MAX       320
+
+// Function declarations
+void initLive();
+AsyncWebServerResponse* beginLiveStream(AsyncWebServerRequest* request);
+void liveLog(uint8_t level, const char* line, size_t len);
+void liveTick();
+String liveStatsJson();
+
+#endif // LIVE_H
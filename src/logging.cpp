@@ -2,115 +2,769 @@
 #include "logging.h"
 #include "globals.h"
 #include "sd.h"
-#include <SD_MMC.h>
+#include "manifest.h"
+#include "layout.h"
+#include "storage.h"
+#include "tier.h"
+#include "logring.h"
+#include "logthrottle.h"
+#include "live.h"
+#include "logsearch.h"
+#include <atomic>
+#include <map>
 
 uint32_t lastFlush = 0;
 
+// Writer side: records popped from the ring wait here for the next SD
+// append. Only the writer task touches these.
+static char logOut[LOG_BUFFER_MAX];
+static size_t logOutLen = 0;
+static uint8_t logRec[LOG_RING_LINE_MAX];
+static char logLine[LOG_RING_LINE_MAX + 32];
+static uint32_t logSdDropped = 0;
+static uint32_t logDropsReported = 0;
+static uint32_t logLimitedReported[LOG_MODULES] = {0};
+static TaskHandle_t logWriterTask = NULL;
+static std::atomic<bool> logFlushWanted(false);
+static std::atomic<bool> logStorageAttached(false);
+
+// Stall metrics: what producers pay per event, and how long the writer
+// spends on UART and SD (which nobody else waits for any more)
+static std::atomic<uint32_t> logPushMaxUs(0);
+static std::atomic<uint32_t> logPushTotalUs(0);
+static std::atomic<uint32_t> logPushCount(0);
+static uint32_t logSerialMaxUs = 0;
+static uint32_t logFlushMaxUs = 0;
+static uint32_t logFlushLastUs = 0;
+static uint32_t logFlushCount = 0;
+static uint32_t logFlushBytes = 0;
+
+// LOG_AT() formats seen since boot (lock-free push from any task) and the
+// persisted dictionary of every format seen before, for older records
+static std::atomic<LogFormat*> logFormats(NULL);
+static std::atomic<uint32_t> logFormatsAdded(0);
+static uint32_t logFormatsChecked = 0;
+static std::map<uint32_t, String> logDict;
+static bool logDictLoaded = false;
+static SemaphoreHandle_t logDictLock = NULL;
+
+// Run-time threshold per module; byte stores, read without a lock
+uint8_t logThreshold[LOG_MODULES] = {LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL,
+                                     LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL, LOG_DEFAULT_LEVEL};
+static const char* const logModuleNames[LOG_MODULES] = {"SYS", "Sensor", "HTTP", "SD", "WiFi", "Weather", "WEB"};
+static const char* const logLevelNames[] = {"off", "err", "warn", "info", "debug"};
+
+// Index of the day file flushBufferToSD() currently appends to
+static LogIndex logIndex = {0, 0, {0}};
+
+String logIndexPath(uint32_t date) {
+    return layoutLogIndexPath(date);
+}
+
+static void logIndexInit(LogIndex& idx, uint32_t date) {
+    idx.magic = LOG_INDEX_MAGIC;
+    idx.date = date;
+    for (int h = 0; h < LOG_INDEX_HOURS; h++) idx.hourOffset[h] = LOG_NO_OFFSET;
+}
+
+static bool logIndexRead(uint32_t date, LogIndex& idx) {
+    String path = logIndexPath(date);
+    if (!storage.exists(path.c_str())) return false;
+    File f = storage.open(path.c_str(), FILE_READ);
+    if (!f) return false;
+    bool ok = f.read((uint8_t*)&idx, sizeof(idx)) == sizeof(idx);
+    f.close();
+    return ok && idx.magic == LOG_INDEX_MAGIC && idx.date == date;
+}
+
+static uint32_t logGet32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void logSet32(uint8_t* p, uint32_t v) {
+    p[0] = v;
+    p[1] = v >> 8;
+    p[2] = v >> 16;
+    p[3] = v >> 24;
+}
+
+// Bytes of the record or line starting at p, 0 if it is incomplete
+static size_t logEntrySize(const char* p, size_t len) {
+    if ((uint8_t)p[0] == LOG_REC_MARK) {
+        if (len < 3) return 0;
+        size_t size = 3 + ((uint8_t)p[1] | ((uint8_t)p[2] << 8));
+        return size <= len ? size : 0;
+    }
+    const char* nl = (const char*)memchr(p, '\n', len);
+    return nl ? nl - p + 1 : 0;
+}
+
+// Timestamp of a record or "unix|..." line; false for millis stamps
+static bool logEntryTs(const char* p, size_t len, uint32_t& ts) {
+    if ((uint8_t)p[0] == LOG_REC_MARK) {
+        if (len < LOG_REC_HEAD || (p[3] & LOG_REC_UNSYNCED)) return false;
+        ts = logGet32((const uint8_t*)p + 4);
+        return true;
+    }
+    // The buffer is not terminated; stay within len
+    size_t i = 0;
+    ts = 0;
+    while (i < len && i < 10 && p[i] >= '0' && p[i] <= '9') ts = ts * 10 + (p[i++] - '0');
+    return i > 0 && i < len && p[i] == '|';
+}
+
+// Notes the first offset of every hour in buf, which will be written at base
+static bool logIndexScan(LogIndex& idx, const char* buf, size_t len, uint32_t base) {
+    uint32_t dayStart = dateToEpoch(idx.date);
+    bool changed = false;
+    size_t pos = 0;
+    while (pos < len) {
+        // Entries stamped with millis before the time sync carry no hour
+        const char* p = buf + pos;
+        uint32_t ts;
+        if (logEntryTs(p, len - pos, ts) && ts >= dayStart && ts - dayStart < 86400UL) {
+            uint32_t h = (ts - dayStart) / 3600;
+            if (idx.hourOffset[h] == LOG_NO_OFFSET) {
+                idx.hourOffset[h] = base + pos;
+                changed = true;
+            }
+        }
+        size_t size = logEntrySize(p, len - pos);
+        if (size == 0) break;
+        pos += size;
+    }
+    return changed;
+}
+
+static void logDrain();
+
+static void logWriterLoop(void*) {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LOG_WRITER_IDLE_MS));
+        logDrain();
+    }
+}
+
+// Starts the writer task; records logged before it runs wait in the ring
 void initLogging() {
-    logBuffer = "";
+    if (!logDictLock) logDictLock = xSemaphoreCreateRecursiveMutex();
+    logOutLen = 0;
     lastFlush = millis();
     loggingInitialized = true;
-    cleanupOldLogs();
+    if (!logWriterTask) {
+        xTaskCreatePinnedToCore(logWriterLoop, "logWriter", LOG_WRITER_STACK, NULL, LOG_WRITER_PRIO,
+                                &logWriterTask, LOG_WRITER_CORE);
+    }
+}
+
+// SD appends and the format dictionary wait for initSD()
+void logAttachStorage() {
+    logStorageAttached = true;
+    logRequestFlush();
+}
+
+static void logNoteStall(uint32_t startUs) {
+    uint32_t us = micros() - startUs;
+    logPushTotalUs.fetch_add(us, std::memory_order_relaxed);
+    logPushCount.fetch_add(1, std::memory_order_relaxed);
+    uint32_t max = logPushMaxUs.load(std::memory_order_relaxed);
+    while (us > max && !logPushMaxUs.compare_exchange_weak(max, us, std::memory_order_relaxed)) {
+    }
+}
+
+// Wakes the writer early once the ring is half full
+static void logWake() {
+    if (logWriterTask && logRingUsed() >= LOG_RING_SIZE / 2) xTaskNotifyGive(logWriterTask);
+}
+
+LogFormat::LogFormat(uint32_t id, const char* fmt) : id(id), fmt(fmt), next(NULL), saved(false) {
+    LogFormat* head = logFormats.load(std::memory_order_relaxed);
+    do {
+        next = head;
+    } while (!logFormats.compare_exchange_weak(head, this, std::memory_order_release, std::memory_order_relaxed));
+    logFormatsAdded.fetch_add(1, std::memory_order_release);
+}
+
+// Arguments that do not fit are left out whole
+static bool logPutVarint(LogArgs& a, uint64_t v) {
+    uint8_t tmp[10];
+    size_t n = 0;
+    while (v >= 0x80) {
+        tmp[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    tmp[n++] = (uint8_t)v;
+    if (a.len + n > a.cap) return false;
+    memcpy(a.buf + a.len, tmp, n);
+    a.len += n;
+    return true;
+}
+
+void logPut(LogArgs& a, long long v) {
+    logPutVarint(a, ((uint64_t)v << 1) ^ (uint64_t)(v >> 63));
+}
+
+void logPut(LogArgs& a, double v) {
+    float f = (float)v;
+    if (a.len + sizeof(f) > a.cap) return;
+    memcpy(a.buf + a.len, &f, sizeof(f));
+    a.len += sizeof(f);
+}
+
+void logPut(LogArgs& a, const char* v) {
+    size_t n = v ? strlen(v) : 0;
+    if (a.len + 2 > a.cap) return;
+    if (n > a.cap - a.len - 2) n = a.cap - a.len - 2;
+    if (!logPutVarint(a, n)) return;
+    memcpy(a.buf + a.len, v, n);
+    a.len += n;
+}
+
+static void logFillHeader(uint8_t* rec, uint32_t id, uint8_t flags, size_t len) {
+    rec[0] = LOG_REC_MARK;
+    rec[1] = (len - 3) & 0xFF;
+    rec[2] = (len - 3) >> 8;
+    rec[3] = flags | (timeSynced ? 0 : LOG_REC_UNSYNCED);
+    logSet32(rec + 4, timeSynced ? (uint32_t)myTZ.now() : (uint32_t)millis());
+    logSet32(rec + 8, id);
+}
+
+// Safe from any task: pushes one record into the lock-free ring; no heap,
+// no locks and no I/O
+void logCommit(uint32_t id, uint8_t flags, uint8_t* rec, size_t len) {
+    uint32_t start = micros();
+    if (logThrottle(id, flags, rec + LOG_REC_HEAD, len - LOG_REC_HEAD) != LOG_THROTTLE_PASS) {
+        logNoteStall(start);
+        return;
+    }
+    logFillHeader(rec, id, flags, len);
+    const char* parts[1] = {(const char*)rec};
+    size_t lens[1] = {len};
+    logRingPush(parts, lens, 1);
+    logWake();
+    logNoteStall(start);
+}
+
+// Free text (LOG_TEXT_ID) for messages without a LOG_AT() format
+void logText(uint8_t level, uint8_t module, const char* content) {
+    if (level > LOG_MIN_LEVEL || !logEnabled(module, level)) return;
+    uint32_t start = micros();
+    uint8_t rec[LOG_REC_HEAD];
+    size_t len = strlen(content);
+    size_t room = LOG_RING_LINE_MAX - LOG_REC_HEAD;
+    if (len > room) len = room;
+    if (logThrottle(LOG_TEXT_ID, LOG_REC_FLAGS(level, module), (const uint8_t*)content, len) != LOG_THROTTLE_PASS) {
+        logNoteStall(start);
+        return;
+    }
+    logFillHeader(rec, LOG_TEXT_ID, LOG_REC_FLAGS(level, module), LOG_REC_HEAD + len);
+    const char* parts[2] = {(const char*)rec, content};
+    size_t lens[2] = {LOG_REC_HEAD, len};
+    logRingPush(parts, lens, 2);
+    logWake();
+    logNoteStall(start);
+}
+
+void logEvent(const char* content) {
+    logText(LOG_LVL_INFO, LOG_MOD_SYS, content);
+}
+
+void logEvent(const String& content) {
+    logText(LOG_LVL_INFO, LOG_MOD_SYS, content.c_str());
+}
+
+// Text lines from other units ("unix|unit|message", CEW) take the ring like
+// every record, so the writer stays the only one appending to the day file.
+// Returns the bytes of text taken; a full ring drops the rest.
+size_t logAppendLines(const char* text, size_t len) {
+    size_t pos = 0;
+    while (pos < len) {
+        const char* nl = (const char*)memchr(text + pos, '\n', len - pos);
+        size_t end = nl ? nl - text : len;
+        size_t n = min(end - pos, (size_t)LOG_RING_LINE_MAX - 1);
+        // A leading record mark would be read back as a binary record
+        if (n > 0 && (uint8_t)text[pos] != LOG_REC_MARK) {
+            const char* parts[2] = {text + pos, "\n"};
+            size_t lens[2] = {n, 1};
+            if (!logRingPush(parts, lens, 2)) break;
+        }
+        pos = nl ? end + 1 : len;
+    }
+    logWake();
+    return pos;
+}
+
+static bool logVarint(const uint8_t*& p, const uint8_t* end, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t b = *p++;
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+static const char* logFormatOf(uint32_t id, String& held) {
+    for (LogFormat* f = logFormats.load(std::memory_order_acquire); f; f = f->next) {
+        if (f->id == id) return f->fmt;
+    }
+    if (logDictLock) xSemaphoreTakeRecursive(logDictLock, portMAX_DELAY);
+    auto it = logDict.find(id);
+    if (it != logDict.end()) held = it->second;
+    if (logDictLock) xSemaphoreGiveRecursive(logDictLock);
+    return held.length() > 0 ? held.c_str() : NULL;
 }
 
-void logEvent(String content) {
-    // Add timestamp internally
-    String timestamp;
-    if (timeSynced) {
-        timestamp = String(myTZ.now());
+// Expands the arguments after the header following the conversions of fmt
+static size_t logFormatArgs(const char* fmt, const uint8_t* p, const uint8_t* end, char* out, size_t cap) {
+    size_t n = 0;
+    while (*fmt && n + 1 < cap) {
+        if (*fmt != '%') {
+            out[n++] = *fmt++;
+            continue;
+        }
+        if (fmt[1] == '%') {
+            out[n++] = '%';
+            fmt += 2;
+            continue;
+        }
+        // Copy flags, width and precision, drop length modifiers
+        char spec[16];
+        size_t k = 0;
+        spec[k++] = *fmt++;
+        while (*fmt && strchr("-+ #0123456789.*", *fmt) && k < sizeof(spec) - 4) spec[k++] = *fmt++;
+        while (*fmt && strchr("hlLqjzt", *fmt)) fmt++;
+        char conv = *fmt ? *fmt++ : 'd';
+        int w = 0;
+        if (strchr("diuxXoc", conv)) {
+            uint64_t zz;
+            if (!logVarint(p, end, zz)) break;
+            long long v = (long long)(zz >> 1) ^ -(long long)(zz & 1);
+            if (conv != 'c') {
+                spec[k++] = 'l';
+                spec[k++] = 'l';
+            }
+            spec[k++] = conv;
+            spec[k] = '\0';
+            w = conv == 'c' ? snprintf(out + n, cap - n, spec, (int)v) : snprintf(out + n, cap - n, spec, v);
+        } else if (strchr("feEgGaA", conv)) {
+            float f;
+            if (end - p < (int)sizeof(f)) break;
+            memcpy(&f, p, sizeof(f));
+            p += sizeof(f);
+            spec[k++] = conv;
+            spec[k] = '\0';
+            w = snprintf(out + n, cap - n, spec, (double)f);
+        } else if (conv == 's') {
+            uint64_t len;
+            if (!logVarint(p, end, len) || (uint64_t)(end - p) < len) break;
+            spec[k++] = '.';
+            spec[k++] = '*';
+            spec[k++] = 's';
+            spec[k] = '\0';
+            w = snprintf(out + n, cap - n, spec, (int)len, (const char*)p);
+            p += len;
+        } else {
+            continue;
+        }
+        n += min((size_t)max(w, 0), cap - n - 1);
+    }
+    out[n] = '\0';
+    return n;
+}
+
+// Turns a record into its "unix|R|message" text line (no newline)
+size_t logDecode(const uint8_t* rec, size_t len, char* out, size_t cap) {
+    if (cap == 0) return 0;
+    if (len < LOG_REC_HEAD || rec[0] != LOG_REC_MARK) {
+        out[0] = '\0';
+        return 0;
+    }
+    uint32_t ts = logGet32(rec + 4);
+    uint32_t id = logGet32(rec + 8);
+    int n = snprintf(out, cap, (rec[3] & LOG_REC_UNSYNCED) ? "M%lu|R|" : "%lu|R|", (unsigned long)ts);
+    size_t pos = min((size_t)max(n, 0), cap - 1);
+    const uint8_t* p = rec + LOG_REC_HEAD;
+    const uint8_t* end = rec + len;
+
+    // A repeat summary wraps the id and arguments of the original message
+    uint64_t count = 0, seconds = 0;
+    bool repeat = id == LOG_REPEAT_ID;
+    if (repeat) {
+        if (!logVarint(p, end, count) || !logVarint(p, end, seconds) || end - p < 4) {
+            out[pos] = '\0';
+            return pos;
+        }
+        id = logGet32(p);
+        p += 4;
+    }
+
+    if (id == LOG_TEXT_ID) {
+        size_t m = min((size_t)(end - p), cap - pos - 1);
+        memcpy(out + pos, p, m);
+        pos += m;
+        out[pos] = '\0';
     } else {
-        timestamp = "M" + String(millis());
+        String held;
+        const char* fmt = logFormatOf(id, held);
+        if (!fmt) {
+            n = snprintf(out + pos, cap - pos, "?%08lx (%u B)", (unsigned long)id, (unsigned)(end - p));
+            pos += min((size_t)max(n, 0), cap - pos - 1);
+        } else {
+            pos += logFormatArgs(fmt, p, end, out + pos, cap - pos);
+        }
     }
+    if (repeat) {
+        n = snprintf(out + pos, cap - pos, " [%lu times in %lu s]", (unsigned long)count, (unsigned long)seconds);
+        pos += min((size_t)max(n, 0), cap - pos - 1);
+    }
+    return pos;
+}
 
-    String logLine = timestamp + "|R|" + content + "\n";
+// Next entry of a day log file as text: binary records are decoded, text
+// lines (CEW, older files) are returned as they are
+bool logReadLine(File& f, char* line, size_t cap) {
+    uint8_t flags;
+    return logReadEntry(f, line, cap, flags);
+}
 
-    // Always to Serial
-    Serial.print(logLine);
+// logReadLine() that also returns the record flags (0 for text lines)
+bool logReadEntry(File& f, char* line, size_t cap, uint8_t& flags) {
+    flags = 0;
+    int c = f.read();
+    if (c < 0) return false;
+    if (c != LOG_REC_MARK) {
+        if (c == '\n' || cap < 2) {
+            line[0] = '\0';
+            return true;
+        }
+        line[0] = (char)c;
+        readLine(f, line + 1, cap - 1);
+        return true;
+    }
+    uint8_t rec[LOG_RING_LINE_MAX];
+    rec[0] = (uint8_t)c;
+    if (f.read(rec + 1, 2) != 2) return false;
+    size_t size = 3 + (rec[1] | (rec[2] << 8));
+    if (size > sizeof(rec)) {
+        f.seek(f.position() + size - 3);
+        line[0] = '\0';
+        return true;
+    }
+    if (f.read(rec + 3, size - 3) != size - 3) return false;
+    if (size >= LOG_REC_HEAD) flags = rec[3];
+    logDecode(rec, size, line, cap);
+    return true;
+}
 
-    // Add to RAM buffer if logging initialized
-    if (loggingInitialized) {
-        logBuffer += logLine;
+// Loads LOG_DICT_PATH once the card is readable
+static void logLoadDict() {
+    File f = storage.open(LOG_DICT_PATH, FILE_READ);
+    xSemaphoreTakeRecursive(logDictLock, portMAX_DELAY);
+    if (f) {
+        char line[LOG_REC_MAX];
+        while (readLine(f, line, sizeof(line))) {
+            char* end;
+            uint32_t id = strtoul(line, &end, 16);
+            if (end != line && *end == '|') logDict[id] = String(end + 1);
+        }
+        f.close();
+    }
+    xSemaphoreGiveRecursive(logDictLock);
+    logDictLoaded = true;
+}
 
-        // Check if buffer is full or timeout exceeded
-        if (logBuffer.length() > LOG_BUFFER_MAX ||
-            (millis() - lastFlush > 300000)) {  // 5 min timeout
-            flushBufferToSD();
+// Appends formats registered since the last pass that the dictionary lacks
+static void logSaveFormats() {
+    uint32_t added = logFormatsAdded.load(std::memory_order_acquire);
+    if (added == logFormatsChecked || !logStorageAttached || (sensorData.errorFlags[0] & ERR_SD)) return;
+    if (!logDictLoaded) logLoadDict();
+    File f;
+    for (LogFormat* fmt = logFormats.load(std::memory_order_acquire); fmt; fmt = fmt->next) {
+        if (fmt->saved) continue;
+        xSemaphoreTakeRecursive(logDictLock, portMAX_DELAY);
+        bool known = logDict.count(fmt->id) > 0;
+        xSemaphoreGiveRecursive(logDictLock);
+        if (!known) {
+            if (!f) f = tierOpen(LOG_DICT_PATH, false);
+            if (!f || !f.seek(f.size())) return;  // retried on a later pass
+            char hex[12];
+            snprintf(hex, sizeof(hex), "%08lx|", (unsigned long)fmt->id);
+            f.print(hex);
+            f.print(fmt->fmt);
+            f.print("\n");
+            xSemaphoreTakeRecursive(logDictLock, portMAX_DELAY);
+            logDict[fmt->id] = String(fmt->fmt);
+            xSemaphoreGiveRecursive(logDictLock);
         }
+        fmt->saved = true;
     }
+    if (f) f.close();
+    logFormatsChecked = added;
+}
+
+// Asks the writer to append the pending lines to SD on its next pass
+void logRequestFlush() {
+    logFlushWanted = true;
+    if (logWriterTask) xTaskNotifyGive(logWriterTask);
 }
 
-void flushBufferToSD() {
-    if (sensorData.errorFlags[0] & ERR_SD) {
+static void flushBufferToSD() {
+    if (!logStorageAttached) return;
+    if ((sensorData.errorFlags[0] & ERR_SD) && !tierReady()) {
         Serial.println("[LOG] SD ERR - skipping flush");
         return;
     }
 
-    if (logBuffer.length() == 0) {
+    if (logOutLen == 0) {
         return;  // Nothing to flush
     }
 
+    uint32_t start = micros();
+
     // Create filename based on current date
     String currentDate = myTZ.dateTime("Ymd");
-    String logFileName = "/logs_" + currentDate + ".txt";
+    String logFileName = layoutPath(MF_LOGS, currentDate.toInt());
 
-    // Open file for append
-    File logFile = SD_MMC.open(logFileName.c_str(), FILE_APPEND);
-    if (!logFile) {
+    // Append through the hot tier; the card gets the text in bulk
+    File logFile = tierOpen(logFileName, false);
+    if (!logFile || !logFile.seek(logFile.size())) {
         Serial.println("[LOG] Failed to open log file: " + logFileName);
         return;
     }
 
+    // Hour offsets are taken from the buffer before it is appended
+    uint32_t date = currentDate.toInt();
+    uint32_t base = logFile.size();
+    if (logIndex.date != date && !logIndexRead(date, logIndex)) {
+        logIndexInit(logIndex, date);
+    }
+    LogIndex next = logIndex;
+    bool indexChanged = logIndexScan(next, logOut, logOutLen, base);
+
     // Write buffer to file
-    size_t bytesWritten = logFile.print(logBuffer);
+    size_t bytesWritten = logFile.write((const uint8_t*)logOut, logOutLen);
+    manifestUpdate(logFileName, logFile.size());
     logFile.close();
 
+    // Offsets staged without the card are relative to its unknown size
+    bool cardUp = !(sensorData.errorFlags[0] & ERR_SD);
+    bool indexable = cardUp && bytesWritten == logOutLen;
+    if (indexable) {
+        // The day file may still be staged, so its directory may be missing;
+        // layoutEnsureDir() caches for the loop task and is not used here
+        String monthDir = layoutMonthDir(date);
+        if (!storage.exists(monthDir.c_str())) {
+            storage.mkdir(layoutYearDir(date / 10000).c_str());
+            storage.mkdir(monthDir.c_str());
+        }
+    }
+    if (indexChanged && indexable) {
+        logIndex = next;
+        File idxFile = storage.open(logIndexPath(date).c_str(), FILE_WRITE);
+        if (idxFile) {
+            idxFile.write((const uint8_t*)&logIndex, sizeof(logIndex));
+            idxFile.close();
+        }
+    }
+    if (bytesWritten > 0) logSearchFlush(date, base, logOutLen, indexable);
+
     if (bytesWritten > 0) {
-        Serial.printf("[LOG] Flushed %d bytes to %s\n", bytesWritten, logFileName.c_str());
-        logBuffer = "";  // Clear buffer
+        Serial.printf("[LOG] Flushed %u bytes to %s\n", (unsigned)bytesWritten, logFileName.c_str());
+        logOutLen = 0;  // Clear buffer
         lastFlush = millis();
+        logFlushLastUs = micros() - start;
+        logFlushMaxUs = max(logFlushMaxUs, logFlushLastUs);
+        logFlushCount++;
+        logFlushBytes += bytesWritten;
     } else {
         Serial.println("[LOG] Failed to write to log file");
     }
 }
 
-void cleanupOldLogs() {
-    if (sensorData.errorFlags[0] & ERR_SD) {
-        return;
+// Queues one line for SD at offset at of the buffer; while the card cannot
+// take a flush a full buffer drops new lines (they still reached Serial)
+static bool logStage(const char* line, size_t len, size_t& at) {
+    if (!loggingInitialized) return false;
+    if (logOutLen + len > sizeof(logOut) || logSearchFull()) flushBufferToSD();
+    if (logOutLen + len > sizeof(logOut)) {
+        logSdDropped++;
+        return false;
+    }
+    at = logOutLen;
+    memcpy(logOut + logOutLen, line, len);
+    logOutLen += len;
+    return true;
+}
+
+// Records stay binary for SD; Serial and live clients get the decoded text
+static void logEmit(const uint8_t* rec, size_t n) {
+    size_t len = logDecode(rec, n, logLine, sizeof(logLine) - 1);
+    liveLog(LOG_REC_LEVEL(rec[3]), logLine, len);
+    logLine[len++] = '\n';
+    uint32_t start = micros();
+    Serial.write((const uint8_t*)logLine, len);
+    logSerialMaxUs = max(logSerialMaxUs, (uint32_t)(micros() - start));
+    size_t at;
+    if (logStage((const char*)rec, n, at)) logSearchAdd(at, LOG_REC_LEVEL(rec[3]), logLine, len - 1);
+}
+
+// Text lines go to SD unchanged and are indexed without a level
+static void logEmitLine(const char* line, size_t n) {
+    size_t at;
+    if (!logStage(line, n, at)) return;
+    memcpy(logLine, line, n - 1);
+    logLine[n - 1] = '\0';
+    logSearchAdd(at, 0, logLine, n - 1);
+}
+
+// Writer notices bypass the ring and the throttle
+static void logEmitText(uint8_t flags, const char* msg) {
+    size_t len = min(strlen(msg), sizeof(logRec) - LOG_REC_HEAD);
+    logFillHeader(logRec, LOG_TEXT_ID, flags, LOG_REC_HEAD + len);
+    memcpy(logRec + LOG_REC_HEAD, msg, len);
+    logEmit(logRec, LOG_REC_HEAD + len);
+}
+
+static void logEmitRepeat(const LogRepeat& r) {
+    LogArgs a = {logRec, LOG_REC_HEAD, sizeof(logRec)};
+    logPutVarint(a, r.count);
+    logPutVarint(a, r.seconds);
+    logSet32(logRec + a.len, r.id);
+    a.len += 4;
+    memcpy(logRec + a.len, r.args, r.argsLen);
+    a.len += r.argsLen;
+    logFillHeader(logRec, LOG_REPEAT_ID, r.flags & ~LOG_REC_UNSYNCED, a.len);
+    logEmit(logRec, a.len);
+}
+
+// One pass of the writer task, the single consumer of the ring: Serial
+// first, then the SD buffer, which is appended once it is 3/4 full, every
+// LOG_FLUSH_MS or on request. Records logged while flushing land in the ring
+// and are picked up by the next pass.
+static void logDrain() {
+    size_t n;
+    while ((n = logRingPop((char*)logRec, sizeof(logRec))) > 0) {
+        if (logRec[0] == LOG_REC_MARK) logEmit(logRec, n);
+        else logEmitLine((const char*)logRec, n);
     }
 
-    File root = SD_MMC.open("/");
-    if (!root) {
-        Serial.println("[LOG] Failed to open root directory");
-        return;
+    // Summaries of repeats whose window closed, then what was lost
+    LogRepeat repeat;
+    while (logThrottleExpired(repeat)) logEmitRepeat(repeat);
+
+    char notice[64];
+    LogRingStats stats;
+    logRingStats(stats);
+    if (stats.dropped != logDropsReported) {
+        snprintf(notice, sizeof(notice), "LOG:Ring full, %lu lines dropped",
+                 (unsigned long)(stats.dropped - logDropsReported));
+        logDropsReported = stats.dropped;
+        logEmitText(LOG_REC_FLAGS(LOG_LVL_WARN, LOG_MOD_SYS), notice);
+    }
+    for (uint8_t m = 0; m < LOG_MODULES; m++) {
+        uint32_t limited = logThrottleLimited(m);
+        if (limited == logLimitedReported[m]) continue;
+        snprintf(notice, sizeof(notice), "LOG:%s rate limited, %lu lines dropped", logModuleNames[m],
+                 (unsigned long)(limited - logLimitedReported[m]));
+        logLimitedReported[m] = limited;
+        logEmitText(LOG_REC_FLAGS(LOG_LVL_WARN, m), notice);
+    }
+    logSaveFormats();
+
+    if (loggingInitialized && logOutLen > 0 &&
+        (logOutLen >= LOG_FLUSH_AT || millis() - lastFlush > LOG_FLUSH_MS || logFlushWanted.exchange(false))) {
+        flushBufferToSD();
+    }
+}
+
+const char* logLevelName(uint8_t level) {
+    return level <= LOG_LVL_DEBUG ? logLevelNames[level] : "?";
+}
+
+const char* logModuleName(uint8_t module) {
+    return module < LOG_MODULES ? logModuleNames[module] : "?";
+}
+
+int logModuleByName(const String& name) {
+    for (uint8_t m = 0; m < LOG_MODULES; m++) {
+        if (name.equalsIgnoreCase(logModuleNames[m])) return m;
+    }
+    return -1;
+}
+
+// "err".."debug", "off" or the number
+int logLevelByName(const String& name) {
+    for (uint8_t l = 0; l <= LOG_LVL_DEBUG; l++) {
+        if (name.equalsIgnoreCase(logLevelNames[l])) return l;
+    }
+    if (name.length() == 1 && name[0] >= '0' && name[0] <= '0' + LOG_LVL_DEBUG) return name[0] - '0';
+    return -1;
+}
+
+// Levels above LOG_MIN_LEVEL are accepted but cannot show anything
+bool logSetLevel(uint8_t module, uint8_t level) {
+    if (module >= LOG_MODULES || level > LOG_LVL_DEBUG) return false;
+    logThreshold[module] = level;
+    return true;
+}
+
+String logLevelsJson() {
+    String json = "{\"compiled\":\"" + String(logLevelNames[LOG_MIN_LEVEL]) + "\",\"modules\":{";
+    for (uint8_t m = 0; m < LOG_MODULES; m++) {
+        if (m > 0) json += ",";
+        json += "\"" + String(logModuleNames[m]) + "\":\"" + String(logLevelNames[logThreshold[m]]) + "\"";
     }
+    json += "}}";
+    return json;
+}
 
-    File file = root.openNextFile();
-    while (file) {
-        String fileName = file.name();
-        file.close();
-
-        // Check if it's a log file
-        if (fileName.startsWith("/logs_") && fileName.endsWith(".txt")) {
-            // Extract date from filename (logs_YYYYMMDD.txt)
-            String dateStr = fileName.substring(6, 14);  // Extract YYYYMMDD
-
-            // Calculate age in days
-            // For simplicity, just check if it's older than 7 days
-            // In production, this should be more sophisticated
-            uint32_t fileDate = dateStr.toInt();
-            uint32_t currentDate = myTZ.dateTime("Ymd").toInt();
-
-            if (currentDate - fileDate > 7) {
-                // Delete old log file
-                if (SD_MMC.remove(fileName.c_str())) {
-                    Serial.println("[LOG] Deleted old log: " + fileName);
-                } else {
-                    Serial.println("[LOG] Failed to delete: " + fileName);
-                }
+String logStatsJson() {
+    LogRingStats stats;
+    logRingStats(stats);
+    String json = "{\"ringSize\":" + String(LOG_RING_SIZE) + ",\"ringUsed\":" + String(logRingUsed()) +
+                  ",\"ringHighWater\":" + String(stats.highWater) + ",\"pushed\":" + String(stats.pushed) +
+                  ",\"dropped\":" + String(stats.dropped) + ",\"droppedBytes\":" + String(stats.droppedBytes) +
+                  ",\"truncated\":" + String(stats.truncated) + ",\"sdPending\":" + String(logOutLen) +
+                  ",\"sdDropped\":" + String(logSdDropped);
+    uint32_t pushes = logPushCount.load(std::memory_order_relaxed);
+    uint32_t pushUs = logPushTotalUs.load(std::memory_order_relaxed);
+    json += ",\"pushMaxUs\":" + String(logPushMaxUs.load(std::memory_order_relaxed)) +
+            ",\"pushAvgUs\":" + String(pushes ? (float)pushUs / pushes : 0.0f, 2) +
+            ",\"serialMaxUs\":" + String(logSerialMaxUs) + ",\"flushes\":" + String(logFlushCount) +
+            ",\"flushBytes\":" + String(logFlushBytes) + ",\"flushLastUs\":" + String(logFlushLastUs) +
+            ",\"flushMaxUs\":" + String(logFlushMaxUs);
+    if (logWriterTask) json += ",\"writerStackFree\":" + String(uxTaskGetStackHighWaterMark(logWriterTask));
+    json += ",\"throttle\":" + logThrottleJson() + ",\"search\":" + logSearchJson() + "}";
+    return json;
+}
+
+// Opens the day log positioned near fromTs; lines from endPos on are past toTs.
+// Without an index the whole file is covered.
+bool logOpenWindow(uint32_t date, uint32_t fromTs, uint32_t toTs, File& f, uint32_t& endPos) {
+    String path = layoutPath(MF_LOGS, date);
+    f = storage.open(path.c_str(), FILE_READ);
+    if (!f) return false;
+    uint32_t start = 0;
+    endPos = f.size();
+
+    LogIndex idx;
+    if (logIndexRead(date, idx)) {
+        // Offsets grow with the hour, so take the last hour starting at or
+        // before fromTs and the first hour starting after toTs
+        uint32_t dayStart = dateToEpoch(date);
+        for (int h = 0; h < LOG_INDEX_HOURS; h++) {
+            uint32_t off = idx.hourOffset[h];
+            if (off == LOG_NO_OFFSET || off > endPos) continue;
+            uint32_t hourStart = dayStart + h * 3600UL;
+            if (hourStart <= fromTs) {
+                start = max(start, off);
+            } else if (hourStart > toTs) {
+                endPos = min(endPos, off);
             }
         }
-
-        file = root.openNextFile();
     }
-    root.close();
-}
\ No newline at end of file
+    if (start > endPos) start = endPos;
+    f.seek(start);
+    return true;
+}
@@ -3,11 +3,162 @@
 #define LOGGING_H
 
 #include <Arduino.h>
+#include <FS.h>
+
+#define LOG_INDEX_MAGIC     0x3158444CUL    // "LDX1"
+#define LOG_INDEX_HOURS     24
+#define LOG_NO_OFFSET       UINT32_MAX
+#define LOG_FLUSH_AT        (LOG_BUFFER_MAX * 3 / 4)    // SD append threshold
+#define LOG_FLUSH_MS        300000UL                    // or after this long
+
+// The writer task drains the ring to Serial and SD away from the UI, which
+// runs in loop() on the other core
+#define LOG_WRITER_CORE     0
+#define LOG_WRITER_PRIO     (tskIDLE_PRIORITY + 1)
+#define LOG_WRITER_STACK    6144
+#define LOG_WRITER_IDLE_MS  50              // wake-up period without a nudge
+
+// Binary records share the day files with text lines ("unix|unit|message",
+// e.g. from CEW), which never start with LOG_REC_MARK:
+//   mark, payload length (u16), flags, ts (u32), format id (u32), arguments
+// Integers are zigzag varints, floats 4 bytes, strings a plain varint length and
+// the bytes. Format id LOG_TEXT_ID carries a plain message instead;
+// LOG_REPEAT_ID a varint count and seconds followed by the id and arguments
+// of a message that repeated (logthrottle.h).
+#define LOG_REC_MARK        0x1E
+#define LOG_REC_HEAD        12
+#define LOG_REC_MAX         256           // LOG_AT() record, arguments are cut to fit
+#define LOG_REC_UNSYNCED    0x01          // ts holds millis()
+#define LOG_REC_LEVEL(f)    (((f) >> 1) & 0x07)
+#define LOG_REC_MODULE(f)   ((f) >> 4)
+#define LOG_REC_FLAGS(level, module) (((level) << 1) | ((module) << 4))
+#define LOG_TEXT_ID         0
+#define LOG_REPEAT_ID       1
+#define LOG_DICT_PATH       "/logfmt.dict"  // "<id hex>|<format>" lines for decoders
+
+// Severities, most severe first; 0 marks records written before levels
+#define LOG_LVL_ERR         1
+#define LOG_LVL_WARN        2
+#define LOG_LVL_INFO        3
+#define LOG_LVL_DEBUG       4
+
+// Calls above this level are compiled out with their arguments; the rest are
+// filtered at run time by the per-module threshold (/api/loglevel)
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL       LOG_LVL_DEBUG
+#endif
+#define LOG_DEFAULT_LEVEL   LOG_LVL_INFO
+
+// Modules, matching the message prefixes; storage helpers (TIER, JOB, RET,
+// ROLLUP) count as SD
+#define LOG_MOD_SYS         0
+#define LOG_MOD_SENSOR      1
+#define LOG_MOD_HTTP        2
+#define LOG_MOD_SD          3
+#define LOG_MOD_WIFI        4
+#define LOG_MOD_WEATHER     5
+#define LOG_MOD_WEB         6
+#define LOG_MODULES         7
+
+extern uint8_t logThreshold[LOG_MODULES];
+
+inline bool logEnabled(uint8_t module, uint8_t level) {
+    return level <= logThreshold[module];
+}
+
+// FNV-1a over the format string, evaluated by the compiler; 0 and 1 are
+// reserved
+constexpr uint32_t logHash(const char* s, uint32_t h = 2166136261UL) {
+    return *s ? logHash(s + 1, (uint32_t)((h ^ (uint8_t)*s) * 16777619UL)) : (h > LOG_REPEAT_ID ? h : h + 2);
+}
+
+// A LOG_AT() call site; registers itself the first time it runs so the writer
+// can decode its records and persist the format
+struct LogFormat {
+    uint32_t id;
+    const char* fmt;
+    LogFormat* next;
+    bool saved;
+    LogFormat(uint32_t id, const char* fmt);
+};
+
+struct LogArgs {
+    uint8_t* buf;
+    size_t len;
+    size_t cap;
+};
+
+// Sidecar logs_YYYYMMDD.idx: byte offset of the first line of each hour
+struct LogIndex {
+    uint32_t magic;
+    uint32_t date;
+    uint32_t hourOffset[LOG_INDEX_HOURS];
+};
 
 // Function declarations
-void logEvent(String msg);
-void flushBufferToSD();
+void logPut(LogArgs& a, long long v);
+void logPut(LogArgs& a, double v);
+void logPut(LogArgs& a, const char* v);
+inline void logPut(LogArgs& a, int v) { logPut(a, (long long)v); }
+inline void logPut(LogArgs& a, unsigned v) { logPut(a, (long long)v); }
+inline void logPut(LogArgs& a, long v) { logPut(a, (long long)v); }
+inline void logPut(LogArgs& a, unsigned long v) { logPut(a, (long long)v); }
+inline void logPut(LogArgs& a, unsigned long long v) { logPut(a, (long long)v); }
+inline void logPut(LogArgs& a, bool v) { logPut(a, (long long)v); }
+inline void logPut(LogArgs& a, float v) { logPut(a, (double)v); }
+inline void logPut(LogArgs& a, const String& v) { logPut(a, v.c_str()); }
+void logCommit(uint32_t id, uint8_t flags, uint8_t* rec, size_t len);
+size_t logDecode(const uint8_t* rec, size_t len, char* out, size_t cap);
+bool logReadLine(File& f, char* line, size_t cap);
+bool logReadEntry(File& f, char* line, size_t cap, uint8_t& flags);
+void logText(uint8_t level, uint8_t module, const char* msg);
+void logEvent(const char* msg);
+void logEvent(const String& msg);
+size_t logAppendLines(const char* text, size_t len);
+const char* logLevelName(uint8_t level);
+const char* logModuleName(uint8_t module);
+int logModuleByName(const String& name);
+int logLevelByName(const String& name);
+bool logSetLevel(uint8_t module, uint8_t level);
+String logLevelsJson();
+void logRequestFlush();
+void logAttachStorage();
+String logStatsJson();
 void initLogging();
-void cleanupOldLogs();
+String logIndexPath(uint32_t date);
+bool logOpenWindow(uint32_t date, uint32_t fromTs, uint32_t toTs, File& f, uint32_t& endPos);
+
+inline void logPack(LogArgs&) {}
+
+template <typename T, typename... Rest>
+inline void logPack(LogArgs& a, const T& v, const Rest&... rest) {
+    logPut(a, v);
+    logPack(a, rest...);
+}
+
+template <typename... Args>
+void logRecord(const LogFormat& f, uint8_t flags, const Args&... args) {
+    uint8_t rec[LOG_REC_MAX];
+    LogArgs a = {rec, LOG_REC_HEAD, sizeof(rec)};
+    logPack(a, args...);
+    logCommit(f.id, flags, rec, a.len);
+}
+
+// Structured log event: LOGI(LOG_MOD_SD, "SD:Sens saved to %s", path). The
+// format must be a literal; only the id and the binary arguments are
+// recorded. Integer conversions take any integer type, %f/%e/%g floats, %s
+// char* or String. Arguments are not evaluated when the level is filtered.
+#define LOG_AT(level, module, fmt, ...) do { \
+    if ((level) <= LOG_MIN_LEVEL && logEnabled(module, level)) { \
+        static constexpr uint32_t logId_ = logHash(fmt); \
+        static LogFormat logFmt_(logId_, fmt); \
+        logRecord(logFmt_, LOG_REC_FLAGS(level, module), ##__VA_ARGS__); \
+    } \
+} while (0)
+
+#define LOGE(module, fmt, ...) LOG_AT(LOG_LVL_ERR, module, fmt, ##__VA_ARGS__)
+#define LOGW(module, fmt, ...) LOG_AT(LOG_LVL_WARN, module, fmt, ##__VA_ARGS__)
+#define LOGI(module, fmt, ...) LOG_AT(LOG_LVL_INFO, module, fmt, ##__VA_ARGS__)
+#define LOGD(module, fmt, ...) LOG_AT(LOG_LVL_DEBUG, module, fmt, ##__VA_ARGS__)
 
 #endif // LOGGING_H
\ No newline at end of file
@@ -0,0 +1,118 @@
+// logring.cpp - Lock-free multi-producer log ring implementation
+#include "logring.h"
+#include <atomic>
+#include <string.h>
+
+#define RING_MASK (LOG_RING_SIZE - 1)
+
+// Free space is kept zeroed, so a header slot that a producer has reserved
+// but not yet published reads as 0 (uncommitted)
+static uint8_t ringData[LOG_RING_SIZE] __attribute__((aligned(LOG_RING_ALIGN)));
+static std::atomic<uint32_t> ringHead(0);   // reserved up to here
+static std::atomic<uint32_t> ringTail(0);   // consumed up to here
+
+static std::atomic<uint32_t> statPushed(0);
+static std::atomic<uint32_t> statDropped(0);
+static std::atomic<uint32_t> statDroppedBytes(0);
+static std::atomic<uint32_t> statTruncated(0);
+static std::atomic<uint32_t> statHighWater(0);
+
+static inline std::atomic<uint32_t>* ringHeader(uint32_t pos) {
+    return reinterpret_cast<std::atomic<uint32_t>*>(ringData + (pos & RING_MASK));
+}
+
+static inline uint32_t ringRecordSize(uint32_t len) {
+    return (sizeof(uint32_t) + len + LOG_RING_ALIGN - 1) & ~(uint32_t)(LOG_RING_ALIGN - 1);
+}
+
+static void ringCopyIn(uint32_t pos, const char* src, size_t len) {
+    uint32_t off = pos & RING_MASK;
+    size_t first = len < LOG_RING_SIZE - off ? len : LOG_RING_SIZE - off;
+    memcpy(ringData + off, src, first);
+    if (len > first) memcpy(ringData, src + first, len - first);
+}
+
+static void ringCopyOut(uint32_t pos, char* dst, size_t len) {
+    uint32_t off = pos & RING_MASK;
+    size_t first = len < LOG_RING_SIZE - off ? len : LOG_RING_SIZE - off;
+    memcpy(dst, ringData + off, first);
+    if (len > first) memcpy(dst + first, ringData, len - first);
+}
+
+static void ringZero(uint32_t pos, size_t len) {
+    uint32_t off = pos & RING_MASK;
+    size_t first = len < LOG_RING_SIZE - off ? len : LOG_RING_SIZE - off;
+    memset(ringData + off, 0, first);
+    if (len > first) memset(ringData, 0, len - first);
+}
+
+// Appends the concatenation of parts as one record. Never blocks and never
+// allocates; false (and a drop counted) when the ring is full. Safe from any
+// task, not from ISRs.
+bool logRingPush(const char* const* parts, const size_t* lens, uint8_t count) {
+    size_t len = 0;
+    for (uint8_t i = 0; i < count; i++) len += lens[i];
+    if (len > LOG_RING_LINE_MAX) {
+        len = LOG_RING_LINE_MAX;
+        statTruncated.fetch_add(1, std::memory_order_relaxed);
+    }
+    uint32_t need = ringRecordSize(len);
+
+    uint32_t head = ringHead.load(std::memory_order_relaxed);
+    uint32_t tail;
+    do {
+        tail = ringTail.load(std::memory_order_acquire);
+        if (head + need - tail > LOG_RING_SIZE) {
+            statDropped.fetch_add(1, std::memory_order_relaxed);
+            statDroppedBytes.fetch_add(len, std::memory_order_relaxed);
+            return false;
+        }
+    } while (!ringHead.compare_exchange_weak(head, head + need, std::memory_order_acq_rel,
+                                             std::memory_order_relaxed));
+
+    uint32_t used = head + need - tail;
+    uint32_t high = statHighWater.load(std::memory_order_relaxed);
+    while (used > high && !statHighWater.compare_exchange_weak(high, used, std::memory_order_relaxed)) {
+    }
+
+    uint32_t pos = head + sizeof(uint32_t);
+    size_t left = len;
+    for (uint8_t i = 0; i < count && left > 0; i++) {
+        size_t n = lens[i] < left ? lens[i] : left;
+        ringCopyIn(pos, parts[i], n);
+        pos += n;
+        left -= n;
+    }
+    ringHeader(head)->store(LOG_RING_COMMITTED | len, std::memory_order_release);
+    statPushed.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// Copies the oldest record to out (cut to cap) and releases it; 0 when the
+// ring is empty or its oldest record is still being written. Single consumer.
+size_t logRingPop(char* out, size_t cap) {
+    uint32_t tail = ringTail.load(std::memory_order_relaxed);
+    if (tail == ringHead.load(std::memory_order_acquire)) return 0;
+    uint32_t hdr = ringHeader(tail)->load(std::memory_order_acquire);
+    if (!(hdr & LOG_RING_COMMITTED)) return 0;
+
+    uint32_t len = hdr & ~LOG_RING_COMMITTED;
+    size_t n = len < cap ? len : cap;
+    ringCopyOut(tail + sizeof(uint32_t), out, n);
+    uint32_t size = ringRecordSize(len);
+    ringZero(tail, size);
+    ringTail.store(tail + size, std::memory_order_release);
+    return n;
+}
+
+uint32_t logRingUsed() {
+    return ringHead.load(std::memory_order_relaxed) - ringTail.load(std::memory_order_relaxed);
+}
+
+void logRingStats(LogRingStats& stats) {
+    stats.pushed = statPushed.load(std::memory_order_relaxed);
+    stats.dropped = statDropped.load(std::memory_order_relaxed);
+    stats.droppedBytes = statDroppedBytes.load(std::memory_order_relaxed);
+    stats.truncated = statTruncated.load(std::memory_order_relaxed);
+    stats.highWater = statHighWater.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,32 @@
+// logring.h - Lock-free multi-producer log ring header
+#ifndef LOGRING_H
+#define LOGRING_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define LOG_RING_SIZE       16384         // bytes, power of two
+#define LOG_RING_ALIGN      4             // records start on a word boundary
+#define LOG_RING_COMMITTED  0x80000000UL  // header bit set once the payload is in place
+#define LOG_RING_LINE_MAX   1024          // longer records are cut
+
+// Records are a 32-bit header (LOG_RING_COMMITTED | payload length) and the
+// payload, padded to LOG_RING_ALIGN; payloads wrap around the end of the
+// storage, headers never do. Producers reserve space with a CAS on the head
+// and publish by storing the header; the single consumer reads committed
+// records from the tail, clears their headers and releases the space.
+struct LogRingStats {
+    uint32_t pushed;
+    uint32_t dropped;               // records rejected because the ring was full
+    uint32_t droppedBytes;
+    uint32_t truncated;
+    uint32_t highWater;             // most bytes in use at once
+};
+
+// Function declarations
+bool logRingPush(const char* const* parts, const size_t* lens, uint8_t count);
+size_t logRingPop(char* out, size_t cap);
+uint32_t logRingUsed();
+void logRingStats(LogRingStats& stats);
+
+#endif // LOGRING_H
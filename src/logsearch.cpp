@@ -0,0 +1,391 @@
+// logsearch.cpp - Keyword and severity index of the day logs implementation
+#include "logsearch.h"
+#include "globals.h"
+#include "logging.h"
+#include "logring.h"
+#include "layout.h"
+#include "storage.h"
+#include "manifest.h"
+#include "hist.h"
+#include <algorithm>
+
+struct LogSearchPair {
+    uint16_t hash;
+    uint16_t entry;
+};
+
+// Segment being built from the records staged for the next SD flush; only
+// the log writer task touches these
+static uint16_t lsOffset[LOG_SEARCH_ENTRIES];
+static uint8_t lsLevel[LOG_SEARCH_ENTRIES];
+static LogSearchPair lsPairs[LOG_SEARCH_POSTINGS];
+static uint16_t lsEntries = 0;
+static uint16_t lsPairCount = 0;
+static uint32_t lsFromTs = 0;
+static uint32_t lsToTs = 0;
+static size_t lsCutAt = SIZE_MAX;       // first staged record left out, coverage ends there
+
+static uint32_t statSegments = 0;
+static uint32_t statIndexBytes = 0;
+static uint32_t statQueries = 0;
+static uint32_t statRecordsRead = 0;
+static uint32_t statBytesScanned = 0;
+static uint32_t statLastQueryMs = 0;
+
+String logSearchPath(uint32_t date) {
+    return layoutLogSearchPath(date);
+}
+
+static bool logSearchWordChar(uint8_t c) {
+    return isalnum(c) || c == '_' || c >= 0x80;
+}
+
+// Calls fn(word, len) for the words of text (letters, digits, '_' and UTF-8
+// bytes) until it returns false
+template <typename Fn>
+static void logSearchWords(const char* text, size_t len, Fn fn) {
+    size_t i = 0;
+    while (i < len) {
+        while (i < len && !logSearchWordChar(text[i])) i++;
+        size_t start = i;
+        while (i < len && logSearchWordChar(text[i])) i++;
+        if (i - start >= LOG_SEARCH_WORD_MIN && !fn(text + start, i - start)) return;
+    }
+}
+
+// FNV-1a of the lower-cased word, folded to 16 bits
+static uint16_t logSearchHash(const char* word, size_t len) {
+    uint32_t h = 2166136261UL;
+    for (size_t i = 0; i < len; i++) h = (h ^ (uint8_t)tolower((uint8_t)word[i])) * 16777619UL;
+    return (uint16_t)(h ^ (h >> 16));
+}
+
+// "unix|unit|message": stamp, and where the message starts; false for
+// "M<millis>" stamps and lines without the fields
+static bool logSearchSplit(const char* line, uint32_t& ts, const char*& unit, const char*& msg) {
+    char* end;
+    ts = strtoul(line, &end, 10);
+    if (end == line || *end != '|') return false;
+    unit = end + 1;
+    msg = strchr(unit, '|');
+    if (!msg) return false;
+    msg++;
+    return true;
+}
+
+bool logSearchFull() {
+    return lsEntries >= LOG_SEARCH_ENTRIES || lsPairCount + LOG_SEARCH_WORDS > LOG_SEARCH_POSTINGS;
+}
+
+// Notes a record staged at offset at of the SD buffer; line is its decoded text
+void logSearchAdd(size_t at, uint8_t level, const char* line, size_t len) {
+    if (lsCutAt != SIZE_MAX) return;
+    if (logSearchFull() || at > UINT16_MAX) {
+        lsCutAt = at;
+        return;
+    }
+    uint16_t e = lsEntries++;
+    lsOffset[e] = at;
+    lsLevel[e] = level;
+
+    // Records stamped with millis are indexed too, but carry no time
+    uint32_t ts;
+    const char* unit;
+    const char* msg;
+    if (logSearchSplit(line, ts, unit, msg)) {
+        if (lsFromTs == 0 || ts < lsFromTs) lsFromTs = ts;
+        if (ts > lsToTs) lsToTs = ts;
+    } else {
+        const char* pipe = strchr(line, '|');
+        pipe = pipe ? strchr(pipe + 1, '|') : NULL;
+        msg = pipe ? pipe + 1 : line;
+    }
+
+    uint16_t first = lsPairCount;
+    logSearchWords(msg, line + len - msg, [&](const char* word, size_t n) {
+        uint16_t h = logSearchHash(word, n);
+        for (uint16_t i = first; i < lsPairCount; i++) {
+            if (lsPairs[i].hash == h) return true;
+        }
+        lsPairs[lsPairCount++] = {h, e};
+        return lsPairCount - first < LOG_SEARCH_WORDS;
+    });
+}
+
+static void logSearchReset() {
+    lsEntries = 0;
+    lsPairCount = 0;
+    lsFromTs = 0;
+    lsToTs = 0;
+    lsCutAt = SIZE_MAX;
+}
+
+// Appends the built segment for the length bytes just written at base of
+// the day file, or drops it when write is false (the flush went to the hot
+// tier, whose offsets are not the card's)
+void logSearchFlush(uint32_t date, uint32_t base, uint32_t length, bool write) {
+    if (!write || lsEntries == 0) {
+        logSearchReset();
+        return;
+    }
+
+    // Postings of a word end up in entry order
+    std::sort(lsPairs, lsPairs + lsPairCount, [](const LogSearchPair& a, const LogSearchPair& b) {
+        return a.hash != b.hash ? a.hash < b.hash : a.entry < b.entry;
+    });
+    uint16_t terms = 0;
+    for (uint16_t i = 0; i < lsPairCount; i++) {
+        if (i == 0 || lsPairs[i].hash != lsPairs[i - 1].hash) terms++;
+    }
+
+    LogSearchHead head = {LOG_SEARCH_MAGIC, base, (uint32_t)min((size_t)length, lsCutAt), lsFromTs, lsToTs,
+                          lsEntries, terms, lsPairCount, 0};
+    String path = logSearchPath(date);
+    File f = storage.open(path.c_str(), FILE_APPEND);
+    if (!f) {
+        logSearchReset();
+        return;
+    }
+    uint32_t before = f.size();
+    size_t expect = sizeof(head) + lsEntries * 3 + terms * sizeof(LogSearchTerm) + lsPairCount * 2;
+    size_t written = f.write((const uint8_t*)&head, sizeof(head));
+    written += f.write((const uint8_t*)lsOffset, lsEntries * 2);
+    written += f.write(lsLevel, lsEntries);
+
+    uint16_t chunk[32];
+    uint8_t n = 0;
+    for (uint16_t i = 0; i < lsPairCount; i++) {
+        if (i > 0 && lsPairs[i].hash == lsPairs[i - 1].hash) continue;
+        LogSearchTerm term = {lsPairs[i].hash, i};
+        written += f.write((const uint8_t*)&term, sizeof(term));
+    }
+    for (uint16_t i = 0; i < lsPairCount; i++) {
+        chunk[n++] = lsPairs[i].entry;
+        if (n == 32 || i + 1 == lsPairCount) {
+            written += f.write((const uint8_t*)chunk, n * 2);
+            n = 0;
+        }
+    }
+    f.close();
+
+    // A torn segment would hide every later one from readers
+    if (written != expect) {
+        storageTruncate(path, before);
+    } else {
+        statSegments++;
+        statIndexBytes += written;
+    }
+    logSearchReset();
+}
+
+// Query words, lower-cased, and their hashes
+struct LogSearchTerms {
+    uint8_t count = 0;
+    String word[LOG_SEARCH_TERMS];
+    uint16_t hash[LOG_SEARCH_TERMS];
+};
+
+// Every query word appears as a whole word of msg
+static bool logSearchMatch(const LogSearchTerms& t, const char* msg) {
+    if (t.count == 0) return true;
+    uint32_t found = 0;
+    logSearchWords(msg, strlen(msg), [&](const char* word, size_t n) {
+        for (uint8_t i = 0; i < t.count; i++) {
+            if (t.word[i].length() == n && strncasecmp(word, t.word[i].c_str(), n) == 0) found |= 1UL << i;
+        }
+        return found != (1UL << t.count) - 1;
+    });
+    return found == (1UL << t.count) - 1;
+}
+
+// Reads the entry at the file position and adds it to hits if it matches
+static void logSearchTake(File& f, const LogQuery& query, const LogSearchTerms& t, std::vector<LogHit>& hits) {
+    char line[LOG_RING_LINE_MAX + 32];
+    uint8_t flags;
+    uint32_t pos = f.position();
+    if (!logReadEntry(f, line, sizeof(line), flags)) return;
+    statRecordsRead++;
+    statBytesScanned += f.position() - pos;
+
+    uint32_t ts;
+    const char* unit;
+    const char* msg;
+    uint8_t level = LOG_REC_LEVEL(flags);
+    if (!logSearchSplit(line, ts, unit, msg) || ts < query.fromTs || ts > query.toTs) return;
+    if (query.level > 0 && (level == 0 || level > query.level)) return;
+    if (!logSearchMatch(t, msg)) return;
+
+    LogHit hit;
+    hit.ts = ts;
+    hit.level = level;
+    hit.unit = String(unit).substring(0, msg - unit - 1);
+    hit.message = String(msg);
+    hits.push_back(hit);
+}
+
+// Unindexed bytes [from, to): read in order, newest matches kept
+static void logSearchScan(File& f, uint32_t from, uint32_t to, const LogQuery& query, const LogSearchTerms& t,
+                          std::vector<LogHit>& hits, size_t need) {
+    if (from >= to) return;
+    std::vector<LogHit> found;
+    f.seek(from);
+    while (f.position() < to) {
+        uint32_t pos = f.position();
+        logSearchTake(f, query, t, found);
+        if (f.position() == pos) break;
+        if (found.size() > need * 2) found.erase(found.begin(), found.end() - need);
+    }
+    if (found.size() > need) found.erase(found.begin(), found.end() - need);
+    hits.insert(hits.end(), found.rbegin(), found.rend());
+}
+
+// Entries of one segment that can match: all words' postings intersected,
+// then the level. False if the body is unreadable.
+static bool logSearchCandidates(File& sx, const LogSearchHead& h, const LogQuery& query, const LogSearchTerms& t,
+                                std::vector<uint16_t>& offsets, std::vector<uint16_t>& entries) {
+    offsets.resize(h.entries);
+    std::vector<uint8_t> levels(h.entries);
+    if (sx.read((uint8_t*)offsets.data(), h.entries * 2) != h.entries * 2) return false;
+    if (sx.read(levels.data(), h.entries) != h.entries) return false;
+
+    entries.clear();
+    if (t.count == 0) {
+        for (uint16_t e = 0; e < h.entries; e++) entries.push_back(e);
+    } else {
+        std::vector<LogSearchTerm> terms(h.terms);
+        if (sx.read((uint8_t*)terms.data(), h.terms * sizeof(LogSearchTerm)) != h.terms * sizeof(LogSearchTerm)) {
+            return false;
+        }
+        uint32_t postings = sx.position();
+        for (uint8_t i = 0; i < t.count; i++) {
+            auto it = std::lower_bound(terms.begin(), terms.end(), t.hash[i],
+                                       [](const LogSearchTerm& a, uint16_t hash) { return a.hash < hash; });
+            if (it == terms.end() || it->hash != t.hash[i]) {
+                entries.clear();
+                return true;
+            }
+            uint16_t end = (it + 1 == terms.end()) ? h.postings : (it + 1)->first;
+            if (it->first > end || end > h.postings) return false;
+            std::vector<uint16_t> list(end - it->first);
+            sx.seek(postings + it->first * 2);
+            if (sx.read((uint8_t*)list.data(), list.size() * 2) != list.size() * 2) return false;
+            if (i == 0) {
+                entries.swap(list);
+            } else {
+                std::vector<uint16_t> both;
+                std::set_intersection(entries.begin(), entries.end(), list.begin(), list.end(),
+                                      std::back_inserter(both));
+                entries.swap(both);
+            }
+            if (entries.empty()) return true;
+        }
+    }
+
+    if (query.level > 0) {
+        entries.erase(std::remove_if(entries.begin(), entries.end(), [&](uint16_t e) {
+            return e >= h.entries || levels[e] == 0 || levels[e] > query.level;
+        }), entries.end());
+    }
+    return true;
+}
+
+// Newest need matches of one day file appended to hits, newest first
+static void logSearchDay(uint32_t date, const LogQuery& query, const LogSearchTerms& t, std::vector<LogHit>& hits,
+                         size_t need) {
+    File f;
+    uint32_t winEnd;
+    if (!logOpenWindow(date, query.fromTs, query.toTs, f, winEnd)) return;
+    uint32_t winStart = f.position();
+    uint32_t size = f.size();
+
+    // Segment heads in file order, with where each body starts
+    std::vector<LogSearchHead> heads;
+    std::vector<uint32_t> bodies;
+    File sx = storage.open(logSearchPath(date).c_str(), FILE_READ);
+    if (sx) {
+        uint32_t sxSize = sx.size();
+        uint32_t covered = 0;
+        LogSearchHead h;
+        while (sx.position() + sizeof(h) <= sxSize && sx.read((uint8_t*)&h, sizeof(h)) == sizeof(h)) {
+            uint32_t body = sx.position();
+            uint32_t bodyLen = h.entries * 3 + h.terms * sizeof(LogSearchTerm) + h.postings * 2;
+            if (h.magic != LOG_SEARCH_MAGIC || body + bodyLen > sxSize || h.base < covered ||
+                h.base + h.length > size) {
+                break;
+            }
+            heads.push_back(h);
+            bodies.push_back(body);
+            covered = h.base + h.length;
+            sx.seek(body + bodyLen);
+        }
+    }
+
+    // Newest first: the bytes after the last segment, then each segment and
+    // the gap before it
+    size_t start = hits.size();
+    uint32_t gapEnd = size;
+    std::vector<uint16_t> offsets, entries;
+    for (int i = (int)heads.size(); i >= 0 && hits.size() - start < need; i--) {
+        uint32_t gapStart = i > 0 ? heads[i - 1].base + heads[i - 1].length : 0;
+        logSearchScan(f, max(gapStart, winStart), min(gapEnd, winEnd), query, t, hits, need - (hits.size() - start));
+        if (i == 0 || hits.size() - start >= need) break;
+
+        const LogSearchHead& h = heads[i - 1];
+        gapEnd = h.base;
+        if (h.fromTs == 0 || h.toTs < query.fromTs || h.fromTs > query.toTs) continue;
+        sx.seek(bodies[i - 1]);
+        if (!logSearchCandidates(sx, h, query, t, offsets, entries)) {
+            // Unreadable body: the segment's bytes are scanned instead
+            logSearchScan(f, h.base, h.base + h.length, query, t, hits, need - (hits.size() - start));
+            continue;
+        }
+        for (auto it = entries.rbegin(); it != entries.rend() && hits.size() - start < need; ++it) {
+            uint32_t at = h.base + offsets[*it];
+            if (at >= h.base + h.length) continue;
+            if (f.position() != at) f.seek(at);
+            logSearchTake(f, query, t, hits);
+        }
+    }
+    if (sx) sx.close();
+    f.close();
+}
+
+// Matches of query, newest first, at most query.limit of them; true if
+// there were more
+bool logSearch(const LogQuery& query, std::vector<LogHit>& hits) {
+    uint32_t startMs = millis();
+    LogSearchTerms t;
+    String q = query.q;
+    logSearchWords(q.c_str(), q.length(), [&](const char* word, size_t n) {
+        t.word[t.count] = String(word).substring(0, n);
+        t.word[t.count].toLowerCase();
+        t.hash[t.count] = logSearchHash(word, n);
+        return ++t.count < LOG_SEARCH_TERMS;
+    });
+
+    // Day files are named by local date and take a late flush past midnight;
+    // the UTC dates of the range, widened by a day, cover both
+    std::vector<ManifestEntry> days = manifestRange(MF_LOGS, histDateOf(query.fromTs), histDateOf(query.toTs + 86400UL));
+    size_t need = (size_t)query.limit + 1;
+    bool lastDay = false;
+    for (auto it = days.rbegin(); it != days.rend(); ++it) {
+        logSearchDay(it->date, query, t, hits, need);
+        // One older day may still hold entries newer than this one's oldest
+        if (lastDay) break;
+        if (hits.size() >= need) lastDay = true;
+    }
+
+    std::stable_sort(hits.begin(), hits.end(), [](const LogHit& a, const LogHit& b) { return a.ts > b.ts; });
+    bool more = hits.size() > query.limit;
+    if (more) hits.resize(query.limit);
+    statQueries++;
+    statLastQueryMs = millis() - startMs;
+    return more;
+}
+
+String logSearchJson() {
+    return "{\"segments\":" + String(statSegments) + ",\"indexBytes\":" + String(statIndexBytes) +
+           ",\"pending\":" + String(lsEntries) + ",\"queries\":" + String(statQueries) +
+           ",\"recordsRead\":" + String(statRecordsRead) + ",\"bytesRead\":" + String(statBytesScanned) +
+           ",\"lastQueryMs\":" + String(statLastQueryMs) + "}";
+}
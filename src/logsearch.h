@@ -0,0 +1,68 @@
+// logsearch.h - Keyword and severity index of the day logs header
+#ifndef LOGSEARCH_H
+#define LOGSEARCH_H
+
+#include "config.h"
+#include <FS.h>
+#include <vector>
+
+#define LOG_SEARCH_MAGIC        0x3158534CUL    // "LSX1", one per segment
+#define LOG_SEARCH_ENTRIES      768             // records per segment; a full builder forces a flush
+#define LOG_SEARCH_POSTINGS     3072            // word occurrences per segment
+#define LOG_SEARCH_WORDS        12              // indexed words per record, the first distinct ones
+#define LOG_SEARCH_WORD_MIN     2
+#define LOG_SEARCH_TERMS        8               // words per query
+#define LOG_SEARCH_DAYS         7               // default range without from=
+
+// Sidecar logs_DD.sdx: one segment per SD flush of the writer, covering
+// [base, base + length) of the day file. After the head come
+//   u16 offset[entries] (from base), u8 level[entries],
+//   LogSearchTerm term[terms] sorted by hash, u16 posting[postings]
+// where the postings of term i run up to term i+1's first (entry numbers,
+// ascending). Byte ranges no segment covers (CEW lines, flushes while the
+// card was out, older files) are scanned instead.
+struct LogSearchHead {
+    uint32_t magic;
+    uint32_t base;
+    uint32_t length;
+    uint32_t fromTs;            // synced stamps of the segment, 0 if none
+    uint32_t toTs;
+    uint16_t entries;
+    uint16_t terms;
+    uint16_t postings;
+    uint16_t reserved;
+};
+
+// Words are hashed to 16 bits; a collision only costs reading a record,
+// every hit is checked against its text
+struct LogSearchTerm {
+    uint16_t hash;
+    uint16_t first;
+};
+
+// q: words that must all appear (case-insensitive whole words); level: the
+// least severe level to include, 0 for all
+struct LogQuery {
+    String q;
+    uint8_t level;
+    uint32_t fromTs;
+    uint32_t toTs;
+    uint16_t limit;
+};
+
+struct LogHit {
+    uint32_t ts;
+    uint8_t level;              // 0 for text lines (CEW, older files)
+    String unit;
+    String message;
+};
+
+// Function declarations
+void logSearchAdd(size_t at, uint8_t level, const char* line, size_t len);
+bool logSearchFull();
+void logSearchFlush(uint32_t date, uint32_t base, uint32_t length, bool write);
+bool logSearch(const LogQuery& query, std::vector<LogHit>& hits);
+String logSearchPath(uint32_t date);
+String logSearchJson();
+
+#endif // LOGSEARCH_H
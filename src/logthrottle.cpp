@@ -0,0 +1,136 @@
+// logthrottle.cpp - Log repeat suppression and per-module rate limits implementation
+#include "logthrottle.h"
+#include "logging.h"
+
+// A message seen within the last window; count is the repeats held back
+struct DedupSlot {
+    bool used;
+    uint32_t fp;
+    uint32_t id;
+    uint8_t flags;
+    uint32_t firstMs;
+    uint32_t count;
+    uint8_t args[LOG_DEDUP_ARGS];
+    uint8_t argsLen;
+};
+
+// Token bucket kept as tokens spent, so zero-initialised buckets start full
+struct LogBucket {
+    uint32_t spent;
+    uint32_t lastMs;
+    uint32_t limited;
+};
+
+static DedupSlot dedupSlots[LOG_DEDUP_SLOTS];
+static LogBucket logBuckets[LOG_MODULES];
+static uint32_t statRepeats = 0;
+static uint32_t statSummaries = 0;
+
+// Producers run on both cores; the sections below are short and never block
+static portMUX_TYPE throttleMux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t throttleFingerprint(uint32_t id, const uint8_t* args, size_t len) {
+    uint32_t h = 2166136261UL;
+    for (int i = 0; i < 4; i++) h = (h ^ (uint8_t)(id >> (8 * i))) * 16777619UL;
+    for (size_t i = 0; i < len; i++) h = (h ^ args[i]) * 16777619UL;
+    return h;
+}
+
+static bool throttleSame(const DedupSlot& s, uint32_t fp, uint32_t id, const uint8_t* args, size_t len) {
+    return s.used && s.fp == fp && s.id == id && s.argsLen == len && memcmp(s.args, args, len) == 0;
+}
+
+// Called for every record before it enters the ring. Repeats of a message
+// logged less than LOG_DEDUP_WINDOW_MS ago are only counted; other records
+// spend a token of their module's bucket.
+uint8_t logThrottle(uint32_t id, uint8_t flags, const uint8_t* args, size_t len) {
+    uint32_t now = millis();
+    uint32_t fp = throttleFingerprint(id, args, len);
+    uint8_t module = LOG_REC_MODULE(flags);
+    if (module >= LOG_MODULES) module = LOG_MOD_SYS;
+
+    portENTER_CRITICAL(&throttleMux);
+    DedupSlot* free = NULL;
+    for (uint8_t i = 0; i < LOG_DEDUP_SLOTS; i++) {
+        DedupSlot& s = dedupSlots[i];
+        if (throttleSame(s, fp, id, args, len)) {
+            s.count++;
+            statRepeats++;
+            portEXIT_CRITICAL(&throttleMux);
+            return LOG_THROTTLE_REPEAT;
+        }
+        // Slots without held-back repeats may be reused, oldest first
+        if (!s.used) {
+            if (!free || free->used) free = &s;
+        } else if (s.count == 0 && (!free || (free->used && (int32_t)(s.firstMs - free->firstMs) < 0))) {
+            free = &s;
+        }
+    }
+
+    LogBucket& b = logBuckets[module];
+    uint32_t refill = (now - b.lastMs) / LOG_BUCKET_REFILL_MS;
+    if (refill > 0) {
+        b.spent = b.spent > refill ? b.spent - refill : 0;
+        b.lastMs = b.spent == 0 ? now : b.lastMs + refill * LOG_BUCKET_REFILL_MS;
+    }
+    if (b.spent >= LOG_BUCKET_BURST) {
+        b.limited++;
+        portEXIT_CRITICAL(&throttleMux);
+        return LOG_THROTTLE_LIMITED;
+    }
+    b.spent++;
+
+    if (free && len <= LOG_DEDUP_ARGS) {
+        free->used = true;
+        free->fp = fp;
+        free->id = id;
+        free->flags = flags;
+        free->firstMs = now;
+        free->count = 0;
+        memcpy(free->args, args, len);
+        free->argsLen = len;
+    }
+    portEXIT_CRITICAL(&throttleMux);
+    return LOG_THROTTLE_PASS;
+}
+
+// Releases slots whose window has passed; true with the next one that held
+// back repeats, which the writer turns into a summary record
+bool logThrottleExpired(LogRepeat& out) {
+    uint32_t now = millis();
+    portENTER_CRITICAL(&throttleMux);
+    for (uint8_t i = 0; i < LOG_DEDUP_SLOTS; i++) {
+        DedupSlot& s = dedupSlots[i];
+        if (!s.used || now - s.firstMs < LOG_DEDUP_WINDOW_MS) continue;
+        s.used = false;
+        if (s.count == 0) continue;
+        out.id = s.id;
+        out.flags = s.flags;
+        out.count = s.count;
+        out.seconds = (now - s.firstMs) / 1000;
+        memcpy(out.args, s.args, s.argsLen);
+        out.argsLen = s.argsLen;
+        statSummaries++;
+        portEXIT_CRITICAL(&throttleMux);
+        return true;
+    }
+    portEXIT_CRITICAL(&throttleMux);
+    return false;
+}
+
+uint32_t logThrottleLimited(uint8_t module) {
+    return module < LOG_MODULES ? logBuckets[module].limited : 0;
+}
+
+String logThrottleJson() {
+    uint8_t tracked = 0;
+    for (uint8_t i = 0; i < LOG_DEDUP_SLOTS; i++) tracked += dedupSlots[i].used;
+    String json = "{\"repeats\":" + String(statRepeats) + ",\"summaries\":" + String(statSummaries) +
+                  ",\"tracked\":" + String(tracked) + ",\"limited\":{";
+    for (uint8_t m = 0; m < LOG_MODULES; m++) {
+        if (m > 0) json += ",";
+        json += "\"" + String(logModuleName(m)) + "\":" + String(logBuckets[m].limited);
+    }
+    json += "}}";
+    return json;
+}
@@ -0,0 +1,34 @@
+// logthrottle.h - Log repeat suppression and per-module rate limits header
+#ifndef LOGTHROTTLE_H
+#define LOGTHROTTLE_H
+
+#include <Arduino.h>
+
+#define LOG_DEDUP_SLOTS     16
+#define LOG_DEDUP_ARGS      64              // longer argument blocks are never collapsed
+#define LOG_DEDUP_WINDOW_MS 60000UL         // repeats within this are counted, not logged
+#define LOG_BUCKET_BURST    30              // records a module may log at once
+#define LOG_BUCKET_REFILL_MS 1000UL         // one more record per interval after that
+
+#define LOG_THROTTLE_PASS       0
+#define LOG_THROTTLE_REPEAT     1           // counted for the next summary
+#define LOG_THROTTLE_LIMITED    2           // over the module's rate
+
+// A collapsed message: its id, flags and arguments and how often it
+// repeated after the first record went out
+struct LogRepeat {
+    uint32_t id;
+    uint8_t flags;
+    uint32_t count;
+    uint32_t seconds;
+    uint8_t args[LOG_DEDUP_ARGS];
+    uint8_t argsLen;
+};
+
+// Function declarations
+uint8_t logThrottle(uint32_t id, uint8_t flags, const uint8_t* args, size_t len);
+bool logThrottleExpired(LogRepeat& out);
+uint32_t logThrottleLimited(uint8_t module);
+String logThrottleJson();
+
+#endif // LOGTHROTTLE_H
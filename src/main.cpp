@@ -13,6 +13,14 @@
 #include "http.h"
 #include "sd.h"
 #include "logging.h"
+#include "appender.h"
+#include "rollup.h"
+#include "compact.h"
+#include "recent.h"
+#include "tier.h"
+#include "jobs.h"
+#include "retention.h"
+#include "live.h"
 #include <Touch_CST328.h>
 
 TwoWire WireTouch = TwoWire(TOUCH_I2C_BUS);
@@ -23,38 +31,36 @@ uint8_t point_num = 0;
 uint8_t max_point_num = 1;
 
 bool setupWiFi() {
-    Serial.println("WiFi:Configuring static IP...");
+    LOGD(LOG_MOD_WIFI, "WiFi:Configuring static IP");
     WiFi.config(localIP, gateway, subnet, dns);
-    Serial.println("WiFi:Static IP configured");
+    LOGD(LOG_MOD_WIFI, "WiFi:Static IP configured");
 
     int numNetworks = sizeof(ssidList)/sizeof(ssidList[0]);
-    Serial.printf("WiFi:Trying %d networks...\n", numNetworks);
+    LOGD(LOG_MOD_WIFI, "WiFi:Trying %d networks", numNetworks);
 
     for (int i = 0; i < numNetworks; i++) {
-        Serial.printf("WiFi:Trying network %d: %s\n", i+1, ssidList[i]);
+        LOGI(LOG_MOD_WIFI, "WiFi:Trying network %d: %s", i + 1, ssidList[i]);
         WiFi.begin(ssidList[i], passwordList[i]);
 
         unsigned long start = millis();
         int attempts = 0;
         while (millis() - start < 15000) {  // Increased timeout to 15s
             wl_status_t status = WiFi.status();
-            Serial.printf("WiFi:Status=%d (attempt %d)\n", status, ++attempts);
+            LOGD(LOG_MOD_WIFI, "WiFi:Status=%d (attempt %d)", status, ++attempts);
             if (status == WL_CONNECTED) {
                 wifiSSID = ssidList[i];
-                Serial.printf("WiFi:Connected! IP=%s\n", WiFi.localIP().toString().c_str());
-                logEvent("WiFi:Connected to " + wifiSSID + " IP=" + WiFi.localIP().toString());
+                LOGI(LOG_MOD_WIFI, "WiFi:Connected to %s IP=%s", wifiSSID, WiFi.localIP().toString());
                 sensorData.errorFlags[0] &= ~ERR_WIFI;
                 return true;
             }
             delay(1000);  // Log every second
         }
-        Serial.printf("WiFi:Network %s timeout\n", ssidList[i]);
+        LOGW(LOG_MOD_WIFI, "WiFi:Network %s timeout", ssidList[i]);
         WiFi.disconnect();
         delay(1000);
     }
-    Serial.println("WiFi:All networks failed");
     sensorData.errorFlags[0] |= ERR_WIFI;
-    logEvent("WiFi:Connection failed - all networks tried");
+    LOGE(LOG_MOD_WIFI, "WiFi:Connection failed - all networks tried");
     return false;
 }
 
@@ -82,9 +88,14 @@ void setup() {
     // 3. Early logging initialization
     Serial.println("Initializing logging...");
     initLogging();
-    logEvent("Setup:Logging initialized");
+    LOGI(LOG_MOD_SYS, "Setup:Logging initialized");
     Serial.println("Logging init complete");
 
+    Serial.println("Initializing recent sample buffer...");
+    initRecent();
+    initLive();
+    initJobs();
+
     // 4. Initialize modules (original sequence)
     Serial.println("Initializing I2C...");
     Wire.begin(SDA_PIN, SCL_PIN);
@@ -111,6 +122,7 @@ void setup() {
     } else {
         Serial.println("SD card initialized");
     }
+    logAttachStorage();  // the hot tier takes log flushes even without the card
 
     // 5. WiFi + NTP setup (after hardware init)
     Serial.println("Setting up WiFi...");
@@ -130,6 +142,8 @@ void setup() {
         }
         if (!timeSynced) {
             Serial.println("NTP sync failed");
+        } else {
+            retentionRun();  // needs the SD manifest and a valid date
         }
         Serial.println("NTP setup complete");
         fetchWeather();
@@ -143,14 +157,14 @@ void setup() {
         Serial.println("WEB: Server setup complete, listening");
     }
 
-    logEvent("Setup:Loading settings");
+    LOGI(LOG_MOD_SYS, "Setup:Loading settings");
     loadSettings();
 
     // Enable watchdog
     esp_task_wdt_init(10, true); // 10s timeout, panic on timeout
     esp_task_wdt_add(NULL);
 
-    logEvent("Setup:Complete - system ready");
+    LOGI(LOG_MOD_SYS, "Setup:Complete - system ready");
 }
 
 void loop() {
@@ -159,8 +173,7 @@ void loop() {
     static unsigned long lastHeartbeat = 0;
     static uint32_t lastStatusLog = 0;
     if (now - lastStatusLog > 60000) {
-      Serial.printf("Status - millis: %lu, heap: %d\n", now, ESP.getFreeHeap());
-      Serial.flush();
+      LOGD(LOG_MOD_SYS, "Main:Status millis=%lu heap=%u", now, ESP.getFreeHeap());
       lastStatusLog = now;
     }
 
@@ -168,7 +181,6 @@ void loop() {
     static uint32_t lastLvgl = 0;
     if (now - lastLvgl >= 5) {
         lv_timer_handler();
-        Serial.flush();
         lastLvgl = now;
     }
 
@@ -191,9 +203,30 @@ void loop() {
         lastHistorySave = millis();
     }
 
+    // Flush history appenders that have held data too long
+    appenderTick();
+
+    // Migrate staged writes to SD, remount it after a failure
+    tierTick();
+
+    // Nightly hourly/daily aggregates, one slice per pass
+    rollupTick();
+
+    // Compact closed sensor days, one slice per pass
+    compactTick();
+
+    // Background deletions, a few files per pass
+    jobsTick();
+
+    // Sensor changes for live stream clients
+    liveTick();
+
+    // Age/size quotas and the card high-water mark
+    retentionTick();
+
     // Periodic sensor reset if error
     if ((sensorData.errorFlags[0] & ERR_SENSOR) && now - lastSensorReset >= 60000) {
-        logEvent("Main:Resett sensors due to error");
+        LOGW(LOG_MOD_SYS, "Main:Resett sensors due to error");
         resetSensors();
         lastSensorReset = now;
     }
@@ -204,7 +237,7 @@ void loop() {
         lastWiFiCheck = now;
         if (WiFi.status() != WL_CONNECTED) {
             connection_ok = false;
-            logEvent("WiFi:Disconnected - attempting reconnect");
+            LOGW(LOG_MOD_WIFI, "WiFi:Disconnected - attempting reconnect");
             for (int attempt = 0; attempt < WIFI_RETRY_COUNT; attempt++) {
                 if (setupWiFi()) {
                     sensorData.errorFlags[0] &= ~ERR_WIFI;
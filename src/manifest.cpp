@@ -0,0 +1,169 @@
+// manifest.cpp - In-memory SD day file manifest implementation
+#include "manifest.h"
+#include "globals.h"
+#include "logging.h"
+#include "layout.h"
+#include "storage.h"
+#include <algorithm>
+
+static std::vector<ManifestEntry> manifest;
+static uint64_t manifestTotal[MF_TYPES];   // bytes per type, kept with every change
+
+// Lookups run in AsyncTCP handlers, updates from loop()
+static SemaphoreHandle_t manifestLock = NULL;
+
+static void lockManifest() {
+    if (manifestLock) xSemaphoreTakeRecursive(manifestLock, portMAX_DELAY);
+}
+
+static void unlockManifest() {
+    if (manifestLock) xSemaphoreGiveRecursive(manifestLock);
+}
+
+static bool manifestLess(const ManifestEntry& a, const ManifestEntry& b) {
+    return a.type != b.type ? a.type < b.type : a.date < b.date;
+}
+
+bool manifestParse(const String& path, ManifestEntry& e) {
+    e.size = 0;
+    return layoutParse(path, e.type, e.date);
+}
+
+static bool manifestIsNumber(const String& name, size_t digits) {
+    if (name.length() != digits) return false;
+    for (size_t i = 0; i < digits; i++) {
+        if (name[i] < '0' || name[i] > '9') return false;
+    }
+    return true;
+}
+
+// Base name of a directory entry; older cores return the full path
+static String manifestBaseName(File& entry) {
+    String name = entry.name();
+    int slash = name.lastIndexOf('/');
+    return slash >= 0 ? name.substring(slash + 1) : name;
+}
+
+static void manifestScanMonth(const String& dir) {
+    File month = storage.open(dir.c_str());
+    if (!month) return;
+    File entry = month.openNextFile();
+    while (entry) {
+        ManifestEntry e;
+        if (!entry.isDirectory() && manifestParse(dir + "/" + manifestBaseName(entry), e)) {
+            e.size = entry.size();
+            manifest.push_back(e);
+            manifestTotal[e.type] += e.size;
+        }
+        entry.close();
+        entry = month.openNextFile();
+    }
+    month.close();
+}
+
+// The only directory walk; run once after the card is mounted
+void manifestBuild() {
+    if (!manifestLock) manifestLock = xSemaphoreCreateRecursiveMutex();
+    lockManifest();
+    manifest.clear();
+    manifest.reserve(MANIFEST_RESERVE);
+    for (int t = 0; t < MF_TYPES; t++) manifestTotal[t] = 0;
+    uint32_t start = millis();
+
+    // Only /YYYY/MM/ directories hold day files
+    std::vector<String> months;
+    File root = storage.open("/");
+    if (root) {
+        File yearEntry = root.openNextFile();
+        while (yearEntry) {
+            String year = manifestBaseName(yearEntry);
+            if (yearEntry.isDirectory() && manifestIsNumber(year, 4)) {
+                File monthEntry = yearEntry.openNextFile();
+                while (monthEntry) {
+                    String month = manifestBaseName(monthEntry);
+                    if (monthEntry.isDirectory() && manifestIsNumber(month, 2)) {
+                        months.push_back("/" + year + "/" + month);
+                    }
+                    monthEntry.close();
+                    monthEntry = yearEntry.openNextFile();
+                }
+            }
+            yearEntry.close();
+            yearEntry = root.openNextFile();
+        }
+        root.close();
+    }
+    for (const String& dir : months) manifestScanMonth(dir);
+    std::sort(manifest.begin(), manifest.end(), manifestLess);
+    size_t count = manifest.size();
+    unlockManifest();
+    LOGI(LOG_MOD_SD, "SD:Manifest built, files=%u in %lu ms", count, millis() - start);
+}
+
+// Records a created or grown file; paths outside the manifest are ignored
+void manifestUpdate(const String& path, uint32_t size) {
+    ManifestEntry e;
+    if (!manifestParse(path, e)) return;
+    e.size = size;
+    lockManifest();
+    auto it = std::lower_bound(manifest.begin(), manifest.end(), e, manifestLess);
+    if (it != manifest.end() && it->type == e.type && it->date == e.date) {
+        manifestTotal[e.type] += (int64_t)size - it->size;
+        it->size = size;
+    } else {
+        manifest.insert(it, e);
+        manifestTotal[e.type] += size;
+    }
+    unlockManifest();
+}
+
+void manifestRemove(const String& path) {
+    ManifestEntry e;
+    if (!manifestParse(path, e)) return;
+    lockManifest();
+    auto it = std::lower_bound(manifest.begin(), manifest.end(), e, manifestLess);
+    if (it != manifest.end() && it->type == e.type && it->date == e.date) {
+        manifestTotal[e.type] -= it->size;
+        manifest.erase(it);
+    }
+    unlockManifest();
+}
+
+// Entries of one type with fromDate <= date <= toDate, in date order
+std::vector<ManifestEntry> manifestRange(uint8_t type, uint32_t fromDate, uint32_t toDate) {
+    std::vector<ManifestEntry> out;
+    if (type >= MF_TYPES || fromDate > toDate) return out;
+    ManifestEntry lo = {type, fromDate, 0};
+    lockManifest();
+    auto first = std::lower_bound(manifest.begin(), manifest.end(), lo, manifestLess);
+    auto last = first;
+    while (last != manifest.end() && last->type == type && last->date <= toDate) ++last;
+    out.assign(first, last);    // sized once; exports hold the list for a whole response
+    unlockManifest();
+    return out;
+}
+
+// Up to count entries of one type, oldest first, skipping the first offset
+std::vector<ManifestEntry> manifestOldest(uint8_t type, size_t offset, size_t count) {
+    std::vector<ManifestEntry> out;
+    if (type >= MF_TYPES) return out;
+    ManifestEntry lo = {type, 0, 0};
+    ManifestEntry hi = {(uint8_t)(type + 1), 0, 0};
+    lockManifest();
+    auto first = std::lower_bound(manifest.begin(), manifest.end(), lo, manifestLess);
+    auto last = std::lower_bound(first, manifest.end(), hi, manifestLess);
+    if ((size_t)(last - first) > offset) {
+        first += offset;
+        out.assign(first, first + std::min(count, (size_t)(last - first)));
+    }
+    unlockManifest();
+    return out;
+}
+
+uint64_t manifestBytes(uint8_t type) {
+    if (type >= MF_TYPES) return 0;
+    lockManifest();
+    uint64_t bytes = manifestTotal[type];
+    unlockManifest();
+    return bytes;
+}
@@ -0,0 +1,28 @@
+// manifest.h - In-memory SD day file manifest header
+#ifndef MANIFEST_H
+#define MANIFEST_H
+
+#include "config.h"
+#include <vector>
+
+#define MANIFEST_RESERVE 1024
+
+enum ManifestType : uint8_t { MF_SENS, MF_FAN, MF_LOGS, MF_TYPES };
+
+// One day file; the array is kept sorted by (type, date)
+struct ManifestEntry {
+    uint8_t type;
+    uint32_t date;              // YYYYMMDD
+    uint32_t size;              // bytes, refreshed on appender/log flushes
+};
+
+// Function declarations
+void manifestBuild();
+bool manifestParse(const String& path, ManifestEntry& e);
+void manifestUpdate(const String& path, uint32_t size);
+void manifestRemove(const String& path);
+std::vector<ManifestEntry> manifestRange(uint8_t type, uint32_t fromDate, uint32_t toDate);
+std::vector<ManifestEntry> manifestOldest(uint8_t type, size_t offset, size_t count);
+uint64_t manifestBytes(uint8_t type);
+
+#endif // MANIFEST_H
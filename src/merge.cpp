@@ -0,0 +1,96 @@
+// merge.cpp - Streaming k-way merge of time-ordered text files implementation
+#include "merge.h"
+#include "sd.h"
+#include <ezTime.h>
+#include <algorithm>
+
+// std heap algorithms keep the largest element on top, so invert the order
+static bool mergeAfter(const MergeSource* a, const MergeSource* b) {
+    return a->ts != b->ts ? a->ts > b->ts : a->seq > b->seq;
+}
+
+// Loads the next keyed line of s; false when the source is exhausted
+static bool mergeFill(LineMerge& m, MergeSource& s) {
+    while (s.file.position() < s.endPos && m.read(s.file, s.line, sizeof(s.line))) {
+        if (m.key(s.line, s.ts)) return true;
+    }
+    s.file.close();
+    return false;
+}
+
+static void mergePush(LineMerge& m, MergeSource* s) {
+    m.heap.push_back(s);
+    std::push_heap(m.heap.begin(), m.heap.end(), mergeAfter);
+}
+
+void mergeInit(LineMerge& m, MergeKeyFn key, MergeReadFn read) {
+    mergeClose(m);
+    m.key = key;
+    m.read = read ? read : readLine;
+}
+
+// Takes ownership of f; the file must already be positioned at its first line
+void mergeAdd(LineMerge& m, File f, uint32_t endPos) {
+    if (!f) return;
+    MergeSource* s = new MergeSource();
+    s->file = f;
+    s->endPos = endPos;
+    s->seq = m.sources++;
+    if (mergeFill(m, *s)) {
+        mergePush(m, s);
+    } else {
+        delete s;
+    }
+}
+
+// Next line in ts order, or NULL when all sources are exhausted.
+// The returned buffer stays valid until the following call.
+const char* mergeNext(LineMerge& m, uint32_t& ts) {
+    if (m.last) {
+        if (mergeFill(m, *m.last)) {
+            mergePush(m, m.last);
+        } else {
+            delete m.last;
+        }
+        m.last = NULL;
+    }
+    if (m.heap.empty()) return NULL;
+    std::pop_heap(m.heap.begin(), m.heap.end(), mergeAfter);
+    m.last = m.heap.back();
+    m.heap.pop_back();
+    ts = m.last->ts;
+    return m.last->line;
+}
+
+void mergeClose(LineMerge& m) {
+    for (MergeSource* s : m.heap) {
+        s->file.close();
+        delete s;
+    }
+    m.heap.clear();
+    if (m.last) {
+        m.last->file.close();
+        delete m.last;
+        m.last = NULL;
+    }
+    m.sources = 0;
+}
+
+LineMerge::~LineMerge() {
+    mergeClose(*this);
+}
+
+// "unix|unit|message" log lines, as logReadLine() returns them
+bool mergeLogKey(const char* line, uint32_t& ts) {
+    char* end;
+    ts = strtoul(line, &end, 10);
+    return end != line && *end == '|';
+}
+
+// "H:i:s d.m.y,..." history CSV lines
+bool mergeCsvTimeKey(const char* line, uint32_t& ts) {
+    int h, mi, s, d, mo, y;
+    if (sscanf(line, "%d:%d:%d %d.%d.%d,", &h, &mi, &s, &d, &mo, &y) != 6) return false;
+    ts = makeTime(h, mi, s, d, mo, 2000 + y);
+    return true;
+}
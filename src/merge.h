@@ -0,0 +1,47 @@
+// merge.h - Streaming k-way merge of time-ordered text files header
+#ifndef MERGE_H
+#define MERGE_H
+
+#include "config.h"
+#include <FS.h>
+#include <vector>
+
+#define MERGE_LINE_MAX 512
+
+// Extracts the sort key of a line; false skips the line (headers, "M<millis>" stamps)
+typedef bool (*MergeKeyFn)(const char* line, uint32_t& ts);
+
+// Reads the next line of a source; readLine() for text, logReadLine() for day
+// logs that hold binary records
+typedef bool (*MergeReadFn)(File& f, char* line, size_t cap);
+
+// One open file with its pending line
+struct MergeSource {
+    File file;
+    uint32_t endPos;            // stop reading at this offset
+    uint32_t seq;               // tie-break: earlier files first
+    uint32_t ts;
+    char line[MERGE_LINE_MAX];
+};
+
+// Min-heap of sources keyed by the pending line's ts
+struct LineMerge {
+    MergeKeyFn key;
+    MergeReadFn read;
+    std::vector<MergeSource*> heap;
+    MergeSource* last;          // source of the line returned last, refilled on the next call
+    uint32_t sources;
+
+    LineMerge() : key(NULL), read(NULL), last(NULL), sources(0) {}
+    ~LineMerge();
+};
+
+// Function declarations
+void mergeInit(LineMerge& m, MergeKeyFn key, MergeReadFn read = NULL);
+void mergeAdd(LineMerge& m, File f, uint32_t endPos = UINT32_MAX);
+const char* mergeNext(LineMerge& m, uint32_t& ts);
+void mergeClose(LineMerge& m);
+bool mergeLogKey(const char* line, uint32_t& ts);
+bool mergeCsvTimeKey(const char* line, uint32_t& ts);
+
+#endif // MERGE_H
@@ -0,0 +1,190 @@
+// recent.cpp - In-RAM ring buffer of recent sensor samples implementation
+#include "recent.h"
+#include "globals.h"
+#include "logging.h"
+#include <esp_heap_caps.h>
+#include <vector>
+
+// Structure of arrays: a graph of one channel walks a single contiguous
+// column instead of striding over whole samples
+static uint32_t* recentTs = NULL;
+static int32_t* recentCol[RECENT_CHANNELS];
+static uint16_t recentSlots = 0;
+static uint16_t recentHead = 0;         // slot written last
+static uint16_t recentCount = 0;
+
+static const char* const recentNames[RECENT_CHANNELS] = {
+    "extTemp", "extHumidity", "extPressure", "extVOC", "extLux",
+    "localTemp", "localHumidity", "localCO2",
+    "utTemp", "utHumidity",
+    "bathroomTemp", "bathroomHumidity",
+    "bathroomPressure", "weatherCode",
+    "fanWC", "fanUT", "fanKOP", "fanDS"
+};
+
+// Fed from the loop and from the web server task
+static SemaphoreHandle_t recentLock = NULL;
+
+static void lockRecent() {
+    if (recentLock) xSemaphoreTakeRecursive(recentLock, portMAX_DELAY);
+}
+
+static void unlockRecent() {
+    if (recentLock) xSemaphoreGiveRecursive(recentLock);
+}
+
+bool initRecent() {
+    if (!recentLock) recentLock = xSemaphoreCreateRecursiveMutex();
+    if (recentTs) return true;
+
+    bool psram = psramFound();
+    uint16_t slots = psram ? RECENT_SLOTS_PSRAM : RECENT_SLOTS_HEAP;
+    size_t column = (size_t)slots * sizeof(int32_t);
+    size_t bytes = column * (RECENT_CHANNELS + 1);
+    uint8_t* block = (uint8_t*)(psram ? heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+                                      : malloc(bytes));
+    if (!block) {
+        LOGE(LOG_MOD_SYS, "RECENT:Alloc failed for %u bytes", bytes);
+        return false;
+    }
+    recentTs = (uint32_t*)block;
+    for (uint8_t ch = 0; ch < RECENT_CHANNELS; ch++) {
+        recentCol[ch] = (int32_t*)(block + column * (ch + 1));
+    }
+    recentSlots = slots;
+    recentHead = 0;
+    recentCount = 0;
+    LOGI(LOG_MOD_SYS, "RECENT:%u slots (%u KB) in %s", slots, bytes / 1024, psram ? "PSRAM" : "heap");
+    return true;
+}
+
+// Stores the current sensorData in the slot of this minute
+void recentRecord() {
+    if (!recentTs || !timeSynced) return;
+    HistRecord rec;
+    histFromSensorData(rec, myTZ.now());
+    uint32_t slotTs = rec.ts - rec.ts % RECENT_STEP;
+
+    lockRecent();
+    if (recentCount > 0 && slotTs < recentTs[recentHead]) {
+        recentCount = 0;  // clock stepped back; older slots would break the ordering
+    }
+    if (recentCount == 0 || slotTs > recentTs[recentHead]) {
+        if (recentCount > 0) recentHead = (recentHead + 1) % recentSlots;
+        if (recentCount < recentSlots) recentCount++;
+        recentTs[recentHead] = slotTs;
+    }
+    for (uint8_t ch = 0; ch < HIST_CHANNELS; ch++) {
+        recentCol[ch][recentHead] = rec.v[ch];
+    }
+    for (uint8_t i = 0; i < ROLLUP_FAN_CHANNELS; i++) {
+        recentCol[RECENT_FAN_BASE + i][recentHead] = sensorData.fanStates[i] == 1 ? ROLLUP_FAN_SCALE : 0;
+    }
+    unlockRecent();
+}
+
+uint32_t recentSpan() {
+    return (uint32_t)recentSlots * RECENT_STEP;
+}
+
+uint32_t recentLastTs() {
+    lockRecent();
+    uint32_t ts = recentCount > 0 ? recentTs[recentHead] : 0;
+    unlockRecent();
+    return ts;
+}
+
+// Physical slot of the i-th oldest sample
+static inline uint16_t recentSlot(uint16_t i) {
+    return (uint16_t)((recentHead + recentSlots + 1 - recentCount + i) % recentSlots);
+}
+
+// Averages channel ch over points equal buckets of [fromTs, toTs]; buckets
+// without samples are RECENT_NONE. Returns the number of points written.
+uint16_t recentSeries(uint8_t ch, uint32_t fromTs, uint32_t toTs, int32_t* out, uint16_t points) {
+    if (ch >= RECENT_CHANNELS || points == 0 || toTs < fromTs) return 0;
+    for (uint16_t p = 0; p < points; p++) out[p] = RECENT_NONE;
+    uint64_t width = (uint64_t)toTs - fromTs + 1;
+
+    lockRecent();
+    uint16_t lo = 0, hi = recentCount;
+    while (lo < hi) {
+        uint16_t mid = lo + (hi - lo) / 2;
+        if (recentTs[recentSlot(mid)] < fromTs) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    const int32_t* col = recentCol[ch];
+    int64_t sum = 0;
+    uint16_t n = 0;
+    uint16_t bucket = 0;
+    for (uint16_t i = lo; i < recentCount; i++) {
+        uint16_t slot = recentSlot(i);
+        uint32_t ts = recentTs[slot];
+        if (ts > toTs) break;
+        uint16_t b = (uint16_t)(((uint64_t)(ts - fromTs) * points) / width);
+        if (b != bucket && n > 0) {
+            out[bucket] = (int32_t)(sum / n);
+            sum = 0;
+            n = 0;
+        }
+        bucket = b;
+        sum += col[slot];
+        n++;
+    }
+    if (n > 0) out[bucket] = (int32_t)(sum / n);
+    unlockRecent();
+    return points;
+}
+
+const char* recentChannelName(uint8_t ch) {
+    return ch < RECENT_CHANNELS ? recentNames[ch] : "";
+}
+
+static void recentAppendValue(String& json, uint8_t ch, int32_t v) {
+    char num[16];
+    if (v == RECENT_NONE) {
+        json += "null";
+        return;
+    }
+    if (ch >= RECENT_FAN_BASE) {
+        snprintf(num, sizeof(num), "%.1f", v * 100.0f / ROLLUP_FAN_SCALE);  // % of time ON
+    } else if (histScale[ch] == 1) {
+        snprintf(num, sizeof(num), "%ld", (long)v);
+    } else {
+        snprintf(num, sizeof(num), "%.1f", (float)v / histScale[ch]);
+    }
+    json += num;
+}
+
+// {"from":..,"to":..,"step":..,"series":{"extTemp":[..],..}}; channels is a
+// comma separated list of names, empty for all
+String recentJson(uint32_t fromTs, uint32_t toTs, uint16_t points, const String& channels) {
+    points = constrain(points, 1, RECENT_JSON_MAX_POINTS);
+    std::vector<int32_t> values(points);
+    String filter = "," + channels + ",";
+
+    String json;
+    json.reserve(64 + (size_t)points * 6 * (channels.length() > 0 ? 4 : RECENT_CHANNELS));
+    json += "{\"from\":" + String(fromTs) + ",\"to\":" + String(toTs) +
+            ",\"step\":" + String((toTs - fromTs + 1) / points) + ",\"series\":{";
+    bool first = true;
+    for (uint8_t ch = 0; ch < RECENT_CHANNELS; ch++) {
+        if (channels.length() > 0 && filter.indexOf("," + String(recentNames[ch]) + ",") < 0) continue;
+        recentSeries(ch, fromTs, toTs, values.data(), points);
+        json += first ? "\"" : ",\"";
+        json += recentNames[ch];
+        json += "\":[";
+        for (uint16_t p = 0; p < points; p++) {
+            if (p > 0) json += ',';
+            recentAppendValue(json, ch, values[p]);
+        }
+        json += ']';
+        first = false;
+    }
+    json += "}}";
+    return json;
+}
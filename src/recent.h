@@ -0,0 +1,27 @@
+// recent.h - In-RAM ring buffer of recent sensor samples header
+#ifndef RECENT_H
+#define RECENT_H
+
+#include "config.h"
+#include "hist.h"
+#include "rollup.h"
+
+#define RECENT_CHANNELS         ROLLUP_CHANNELS     // sensor channels, then fan states
+#define RECENT_FAN_BASE         ROLLUP_FAN_BASE
+#define RECENT_STEP             60                  // seconds per slot; later updates overwrite
+#define RECENT_SLOTS_PSRAM      2880                // 48 h
+#define RECENT_SLOTS_HEAP       360                 // 6 h when there is no PSRAM
+#define RECENT_JSON_POINTS      288                 // default /api/recent resolution
+#define RECENT_JSON_MAX_POINTS  720
+#define RECENT_NONE             INT32_MIN           // empty bucket in recentSeries()
+
+// Function declarations
+bool initRecent();
+void recentRecord();
+uint32_t recentSpan();
+uint32_t recentLastTs();
+uint16_t recentSeries(uint8_t ch, uint32_t fromTs, uint32_t toTs, int32_t* out, uint16_t points);
+String recentJson(uint32_t fromTs, uint32_t toTs, uint16_t points, const String& channels);
+const char* recentChannelName(uint8_t ch);
+
+#endif // RECENT_H
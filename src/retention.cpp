@@ -0,0 +1,172 @@
+// retention.cpp - Age and size based SD retention implementation
+#include "retention.h"
+#include "globals.h"
+#include "logging.h"
+#include "appender.h"
+#include "layout.h"
+#include "jobs.h"
+#include "hist.h"
+#include "sd.h"
+#include <ArduinoJson.h>
+
+RetentionPolicy retentionPolicy[MF_TYPES] = {
+    {RETENTION_SENS_DAYS, RETENTION_SENS_BYTES},
+    {RETENTION_FAN_DAYS, RETENTION_FAN_BYTES},
+    {RETENTION_LOGS_DAYS, RETENTION_LOGS_BYTES},
+};
+
+static uint32_t retentionJob = JOB_NONE;
+static uint32_t retentionLastRun = 0;
+static uint32_t retentionLastCheck = 0;
+static bool retentionRan = false;
+static uint32_t retentionLastFiles = 0;
+static uint64_t retentionLastBytes = 0;
+static uint64_t usageTotal = 0;
+static uint64_t usageUsed = 0;
+
+// Today's files and files an appender still holds open are never removed;
+// anything newer than a protected file is protected as well
+static bool retentionProtected(const ManifestEntry& e, uint32_t today) {
+    if (e.date >= today) return true;
+    String path = layoutPath(e.type, e.date);
+    return (sensAppender.isOpen && sensAppender.path == path) ||
+           (fanAppender.isOpen && fanAppender.path == path);
+}
+
+static uint8_t usagePercent() {
+    return usageTotal ? (uint8_t)(usageUsed * 100 / usageTotal) : 0;
+}
+
+// Victims are taken from the old end of each type's manifest slice, so
+// picking k files costs O(k) plus a binary search per batch, independent of
+// how many days the card holds
+void retentionRun() {
+    if ((sensorData.errorFlags[0] & ERR_SD) || !timeSynced) return;
+    if (retentionJob != JOB_NONE && jobPending(retentionJob)) return;
+
+    uint32_t today = histDateOf(myTZ.now());
+    uint32_t todayNum = dayNumber(today);
+    std::vector<ManifestEntry> victims;
+    size_t taken[MF_TYPES] = {0};
+    uint64_t freed[MF_TYPES] = {0};
+    uint32_t ageFiles = 0, quotaFiles = 0, waterFiles = 0;
+
+    for (uint8_t t = 0; t < MF_TYPES; t++) {
+        const RetentionPolicy& p = retentionPolicy[t];
+
+        // Age: dates before the cutoff are more than maxDays days old
+        if (p.maxDays > 0 && todayNum > p.maxDays) {
+            uint32_t cutoff = dayToDate(todayNum - p.maxDays);
+            for (const ManifestEntry& e : manifestRange(t, 0, cutoff - 1)) {
+                if (retentionProtected(e, today)) break;
+                victims.push_back(e);
+                freed[t] += e.size;
+                taken[t]++;
+                ageFiles++;
+            }
+        }
+
+        // Bytes: continue from where the age pass stopped
+        uint64_t total = manifestBytes(t);
+        bool more = p.maxBytes > 0;
+        while (more && total - freed[t] > p.maxBytes) {
+            std::vector<ManifestEntry> batch = manifestOldest(t, taken[t], 8);
+            more = batch.size() == 8;
+            for (const ManifestEntry& e : batch) {
+                if (total - freed[t] <= p.maxBytes) break;
+                if (retentionProtected(e, today)) {
+                    more = false;
+                    break;
+                }
+                victims.push_back(e);
+                freed[t] += e.size;
+                taken[t]++;
+                quotaFiles++;
+            }
+        }
+    }
+
+    // High water: the oldest day across all types goes next until the
+    // estimate is back at the low-water mark
+    if (storageUsage(usageTotal, usageUsed) && usagePercent() >= RETENTION_HIGH_WATER) {
+        uint64_t target = usageTotal * RETENTION_LOW_WATER / 100;
+        uint64_t used = usageUsed;
+        for (uint8_t t = 0; t < MF_TYPES; t++) used -= std::min(used, freed[t]);
+        ManifestEntry head[MF_TYPES];
+        bool has[MF_TYPES];
+        for (uint8_t t = 0; t < MF_TYPES; t++) {
+            std::vector<ManifestEntry> one = manifestOldest(t, taken[t], 1);
+            has[t] = !one.empty() && !retentionProtected(one[0], today);
+            if (has[t]) head[t] = one[0];
+        }
+        while (used > target) {
+            int pick = -1;
+            for (uint8_t t = 0; t < MF_TYPES; t++) {
+                if (has[t] && (pick < 0 || head[t].date < head[pick].date)) pick = t;
+            }
+            if (pick < 0) break;
+            victims.push_back(head[pick]);
+            used -= std::min(used, (uint64_t)head[pick].size);
+            freed[pick] += head[pick].size;
+            taken[pick]++;
+            waterFiles++;
+            std::vector<ManifestEntry> one = manifestOldest(pick, taken[pick], 1);
+            has[pick] = !one.empty() && !retentionProtected(one[0], today);
+            if (has[pick]) head[pick] = one[0];
+        }
+        if (used > target) LOGW(LOG_MOD_SD, "RET:Card above low water with nothing left to remove");
+    }
+
+    retentionLastRun = millis();
+    retentionRan = true;
+    if (victims.empty()) return;
+
+    uint64_t bytes = 0;
+    for (uint8_t t = 0; t < MF_TYPES; t++) bytes += freed[t];
+    uint32_t id = jobSubmitFiles(victims, JOB_RETENTION);
+    if (id == JOB_NONE) {
+        LOGW(LOG_MOD_SD, "RET:Job queue full - retention postponed");
+        return;
+    }
+    retentionJob = id;
+    retentionLastFiles = victims.size();
+    retentionLastBytes = bytes;
+    LOGI(LOG_MOD_SD, "RET:Job %lu removes %u files, %lu KB (age %u, quota %u, water %u)", id,
+         victims.size(), (uint32_t)(bytes / 1024), ageFiles, quotaFiles, waterFiles);
+}
+
+// Called from loop(); a quota pass runs hourly, or as soon as the card
+// crosses the high-water mark
+void retentionTick() {
+    uint32_t now = millis();
+    if (now - retentionLastCheck < RETENTION_CHECK_MS) return;
+    retentionLastCheck = now;
+    if ((sensorData.errorFlags[0] & ERR_SD) || !timeSynced) return;
+
+    bool due = !retentionRan || now - retentionLastRun >= RETENTION_INTERVAL_MS;
+    if (!due && storageUsage(usageTotal, usageUsed)) due = usagePercent() >= RETENTION_HIGH_WATER;
+    if (due) retentionRun();
+}
+
+String retentionJson() {
+    static const char* names[MF_TYPES] = {"sens", "fan", "logs"};
+    JsonDocument doc;
+    doc["totalBytes"] = usageTotal;
+    doc["usedBytes"] = usageUsed;
+    doc["usedPercent"] = usagePercent();
+    doc["highWater"] = RETENTION_HIGH_WATER;
+    doc["lowWater"] = RETENTION_LOW_WATER;
+    for (uint8_t t = 0; t < MF_TYPES; t++) {
+        JsonObject o = doc["types"][names[t]].to<JsonObject>();
+        o["maxDays"] = retentionPolicy[t].maxDays;
+        o["maxBytes"] = retentionPolicy[t].maxBytes;
+        o["bytes"] = manifestBytes(t);
+    }
+    doc["lastRunAgoMs"] = retentionRan ? millis() - retentionLastRun : 0;
+    doc["lastJob"] = retentionJob;
+    doc["lastFiles"] = retentionLastFiles;
+    doc["lastBytes"] = retentionLastBytes;
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
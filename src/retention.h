@@ -0,0 +1,35 @@
+// retention.h - Age and size based SD retention header
+#ifndef RETENTION_H
+#define RETENTION_H
+
+#include "config.h"
+#include "manifest.h"
+
+#define RETENTION_INTERVAL_MS   3600000UL   // quota pass at most this often
+#define RETENTION_CHECK_MS      600000UL    // card usage check interval
+#define RETENTION_HIGH_WATER    90          // % used that forces a pass
+#define RETENTION_LOW_WATER     85          // % used a forced pass frees down to
+
+// Per-type defaults; 0 disables the quota
+#define RETENTION_SENS_DAYS     730
+#define RETENTION_SENS_BYTES    0
+#define RETENTION_FAN_DAYS      730
+#define RETENTION_FAN_BYTES     0
+#define RETENTION_LOGS_DAYS     7
+#define RETENTION_LOGS_BYTES    16777216UL
+
+// A day file goes when it is more than maxDays days old or when the type
+// holds more than maxBytes without it, oldest first
+struct RetentionPolicy {
+    uint16_t maxDays;
+    uint32_t maxBytes;
+};
+
+extern RetentionPolicy retentionPolicy[MF_TYPES];
+
+// Function declarations
+void retentionRun();
+void retentionTick();
+String retentionJson();
+
+#endif // RETENTION_H
@@ -0,0 +1,331 @@
+// rollup.cpp - Hourly/daily history aggregates implementation
+#include "rollup.h"
+#include "globals.h"
+#include "logging.h"
+#include "sd.h"
+#include "appender.h"
+#include "layout.h"
+
+#define ROLLUP_CHECK_MS 60000UL
+
+enum RollupPhase { RP_IDLE, RP_SENS, RP_FAN, RP_WRITE };
+
+// Running aggregate of one hour while a day is being rolled up
+struct RollupAcc {
+    uint16_t count[2];
+    int32_t vmin[ROLLUP_CHANNELS];
+    int32_t vmax[ROLLUP_CHANNELS];
+    int64_t sum[ROLLUP_CHANNELS];
+};
+
+static RollupPhase rollupPhase = RP_IDLE;
+static RollupAcc* rollupAcc = nullptr;     // HIST_HOURS entries, allocated only while a job runs
+static uint32_t rollupDate = 0;            // day being rolled up
+static uint32_t rollupDayStart = 0;
+static uint32_t rollupDoneDate = 0;        // last day present in the daily rollups
+static bool rollupDoneKnown = false;
+static uint32_t rollupLastCheck = 0;
+static HistReader rollupHist;
+static bool rollupHistOpen = false;
+static File rollupFan;
+
+String rollupPath(RollupLevel level, uint16_t year) {
+    return layoutYearDir(year) + String(level == ROLLUP_HOURLY ? "/rollup_h.bin" : "/rollup_d.bin");
+}
+
+static uint16_t rollupYearOf(uint32_t ts) {
+    return histDateOf(ts) / 10000;
+}
+
+// ts of the last record in a rollup file, 0 if empty or missing
+static uint32_t rollupLastTs(RollupLevel level, uint16_t year) {
+    String path = rollupPath(level, year);
+    if (!storage.exists(path.c_str())) return 0;
+    File f = storage.open(path.c_str(), FILE_READ);
+    if (!f) return 0;
+    uint32_t ts = 0;
+    uint32_t count = f.size() / sizeof(RollupRecord);
+    if (count > 0) {
+        f.seek((count - 1) * sizeof(RollupRecord));
+        f.read((uint8_t*)&ts, sizeof(ts));
+    }
+    f.close();
+    return ts;
+}
+
+static void rollupAccumulate(uint32_t hour, RollupSource src, uint8_t first, uint8_t n, const int32_t* v) {
+    if (hour >= HIST_HOURS) return;
+    RollupAcc& a = rollupAcc[hour];
+    if (a.count[src] == UINT16_MAX) return;
+    a.count[src]++;
+    for (uint8_t i = 0; i < n; i++) {
+        uint8_t ch = first + i;
+        a.vmin[ch] = min(a.vmin[ch], v[i]);
+        a.vmax[ch] = max(a.vmax[ch], v[i]);
+        a.sum[ch] += v[i];
+    }
+}
+
+static void rollupFinish() {
+    if (rollupHistOpen) histClose(rollupHist);
+    rollupHistOpen = false;
+    if (rollupFan) rollupFan.close();
+    free(rollupAcc);
+    rollupAcc = nullptr;
+    rollupPhase = RP_IDLE;
+}
+
+static void rollupStart(uint32_t date) {
+    rollupAcc = (RollupAcc*)malloc(sizeof(RollupAcc) * HIST_HOURS);
+    if (!rollupAcc) {
+        LOGE(LOG_MOD_SD, "ROLLUP:Out of memory");
+        return;
+    }
+    for (int h = 0; h < HIST_HOURS; h++) {
+        RollupAcc& a = rollupAcc[h];
+        a.count[ROLLUP_SRC_SENS] = 0;
+        a.count[ROLLUP_SRC_FAN] = 0;
+        for (int ch = 0; ch < ROLLUP_CHANNELS; ch++) {
+            a.vmin[ch] = INT32_MAX;
+            a.vmax[ch] = INT32_MIN;
+            a.sum[ch] = 0;
+        }
+    }
+    rollupDate = date;
+    rollupDayStart = dateToEpoch(date);
+
+    appenderSyncAll();  // the day is normally closed already, but a restart may leave data buffered
+    String path = histPath(date);
+    rollupHistOpen = storage.exists(path.c_str()) && histOpen(rollupHist, path.c_str());
+    rollupPhase = RP_SENS;
+}
+
+// Processes up to ROLLUP_SLICE sensor records
+static void rollupStepSens() {
+    HistRecord rec;
+    for (int i = 0; i < ROLLUP_SLICE; i++) {
+        if (!rollupHistOpen || !histNext(rollupHist, rec)) {
+            if (rollupHistOpen) histClose(rollupHist);
+            rollupHistOpen = false;
+            String path = layoutPath(MF_FAN, rollupDate);
+            char line[64];
+            if (storage.exists(path.c_str())) {
+                rollupFan = storage.open(path.c_str(), FILE_READ);
+                if (rollupFan) readLine(rollupFan, line, sizeof(line));  // header
+            }
+            rollupPhase = RP_FAN;
+            return;
+        }
+        if (rec.ts < rollupDayStart) continue;
+        int32_t v[HIST_CHANNELS];
+        memcpy(v, rec.v, sizeof(v));  // rec is packed
+        rollupAccumulate((rec.ts - rollupDayStart) / 3600, ROLLUP_SRC_SENS, 0, HIST_CHANNELS, v);
+    }
+}
+
+// Processes up to ROLLUP_SLICE fan lines ("H:i:s d.m.y,ON,OFF,ON,OFF")
+static void rollupStepFan() {
+    char line[128];
+    for (int i = 0; i < ROLLUP_SLICE; i++) {
+        if (!rollupFan || !readLine(rollupFan, line, sizeof(line))) {
+            if (rollupFan) rollupFan.close();
+            rollupPhase = RP_WRITE;
+            return;
+        }
+        int hour, minute, second;
+        if (sscanf(line, "%d:%d:%d", &hour, &minute, &second) != 3) continue;
+
+        int32_t v[ROLLUP_FAN_CHANNELS];
+        const char* p = strchr(line, ',');
+        uint8_t n = 0;
+        while (p && n < ROLLUP_FAN_CHANNELS) {
+            v[n++] = strncmp(p + 1, "ON", 2) == 0 ? ROLLUP_FAN_SCALE : 0;
+            p = strchr(p + 1, ',');
+        }
+        if (n == ROLLUP_FAN_CHANNELS) {
+            rollupAccumulate(hour, ROLLUP_SRC_FAN, ROLLUP_FAN_BASE, ROLLUP_FAN_CHANNELS, v);
+        }
+    }
+}
+
+// Folds an accumulator into a record; channels without samples stay 0
+static void rollupMakeRecord(RollupRecord& rec, uint32_t ts, const RollupAcc& a) {
+    memset(&rec, 0, sizeof(rec));
+    rec.ts = ts;
+    rec.count[ROLLUP_SRC_SENS] = a.count[ROLLUP_SRC_SENS];
+    rec.count[ROLLUP_SRC_FAN] = a.count[ROLLUP_SRC_FAN];
+    for (uint8_t ch = 0; ch < ROLLUP_CHANNELS; ch++) {
+        uint16_t n = a.count[ch < ROLLUP_FAN_BASE ? ROLLUP_SRC_SENS : ROLLUP_SRC_FAN];
+        if (n == 0) continue;
+        rec.vmin[ch] = a.vmin[ch];
+        rec.vmax[ch] = a.vmax[ch];
+        int64_t sum = a.sum[ch];
+        rec.vavg[ch] = (int32_t)((sum >= 0 ? sum + n / 2 : sum - n / 2) / n);
+    }
+}
+
+// Appends records to the year file, skipping ones already present after an interrupted job
+static bool rollupWrite(RollupLevel level, const RollupRecord* recs, size_t n) {
+    if (n == 0) return true;
+    uint16_t year = rollupYearOf(recs[0].ts);
+    uint32_t last = rollupLastTs(level, year);
+    size_t skip = 0;
+    while (skip < n && recs[skip].ts <= last) skip++;
+    if (skip == n) return true;
+
+    String path = rollupPath(level, year);
+    if (!layoutEnsureDir(path)) return false;
+    File f = storage.open(path.c_str(), FILE_APPEND);
+    if (!f) return false;
+    size_t bytes = (n - skip) * sizeof(RollupRecord);
+    bool ok = f.write((const uint8_t*)(recs + skip), bytes) == bytes;
+    f.close();
+    return ok;
+}
+
+static void rollupStepWrite() {
+    RollupRecord* hourly = (RollupRecord*)malloc(sizeof(RollupRecord) * HIST_HOURS);
+    if (!hourly) {
+        LOGE(LOG_MOD_SD, "ROLLUP:Out of memory");
+        rollupFinish();
+        return;
+    }
+
+    RollupAcc day;
+    day.count[ROLLUP_SRC_SENS] = 0;
+    day.count[ROLLUP_SRC_FAN] = 0;
+    for (int ch = 0; ch < ROLLUP_CHANNELS; ch++) {
+        day.vmin[ch] = INT32_MAX;
+        day.vmax[ch] = INT32_MIN;
+        day.sum[ch] = 0;
+    }
+
+    size_t hours = 0;
+    for (int h = 0; h < HIST_HOURS; h++) {
+        const RollupAcc& a = rollupAcc[h];
+        if (a.count[ROLLUP_SRC_SENS] == 0 && a.count[ROLLUP_SRC_FAN] == 0) continue;
+        rollupMakeRecord(hourly[hours++], rollupDayStart + h * 3600UL, a);
+        for (uint8_t src = 0; src < 2; src++) {
+            day.count[src] = (uint16_t)min((uint32_t)day.count[src] + a.count[src], (uint32_t)UINT16_MAX);
+        }
+        for (int ch = 0; ch < ROLLUP_CHANNELS; ch++) {
+            day.vmin[ch] = min(day.vmin[ch], a.vmin[ch]);
+            day.vmax[ch] = max(day.vmax[ch], a.vmax[ch]);
+            day.sum[ch] += a.sum[ch];
+        }
+    }
+
+    bool ok = true;
+    if (hours > 0) {
+        RollupRecord daily;
+        rollupMakeRecord(daily, rollupDayStart, day);
+        // Daily record last: it marks the day as done
+        ok = rollupWrite(ROLLUP_HOURLY, hourly, hours) && rollupWrite(ROLLUP_DAILY, &daily, 1);
+    }
+    free(hourly);
+
+    if (ok) {
+        LOGI(LOG_MOD_SD, "ROLLUP:Day %lu done, hours=%u", rollupDate, hours);
+    } else {
+        LOGE(LOG_MOD_SD, "ROLLUP:Write failed for day %lu", rollupDate);
+    }
+    rollupDoneDate = rollupDate;  // on failure retry after the next restart, not every minute
+    rollupFinish();
+}
+
+// Called from loop(); each call does at most one bounded slice of work
+void rollupTick() {
+    if (rollupPhase == RP_SENS) {
+        rollupStepSens();
+        return;
+    }
+    if (rollupPhase == RP_FAN) {
+        rollupStepFan();
+        return;
+    }
+    if (rollupPhase == RP_WRITE) {
+        rollupStepWrite();
+        return;
+    }
+
+    if (millis() - rollupLastCheck < ROLLUP_CHECK_MS) return;
+    rollupLastCheck = millis();
+    if ((sensorData.errorFlags[0] & ERR_SD) || !timeSynced) return;
+
+    uint32_t now = myTZ.now();
+    if (now % 86400UL < ARCHIVE_TIME) return;
+    uint32_t today = histDateOf(now);
+
+    if (!rollupDoneKnown) {
+        uint16_t year = rollupYearOf(now);
+        uint32_t last = rollupLastTs(ROLLUP_DAILY, year);
+        if (last == 0) last = rollupLastTs(ROLLUP_DAILY, year - 1);
+        rollupDoneDate = last ? histDateOf(last) : 0;
+        rollupDoneKnown = true;
+    }
+
+    // Oldest day not rolled up yet, at most ROLLUP_CATCHUP_DAYS back
+    uint32_t date = histDateOf(now - now % 86400UL - ROLLUP_CATCHUP_DAYS * 86400UL);
+    if (rollupDoneDate >= date) date = nextDate(rollupDoneDate);
+    if (date >= today) return;
+
+    rollupStart(date);
+}
+
+static bool rollupOpenYear(RollupReader& r) {
+    while (r.year <= r.toYear) {
+        String path = rollupPath(r.level, r.year);
+        if (storage.exists(path.c_str())) {
+            r.file = storage.open(path.c_str(), FILE_READ);
+            if (r.file) return true;
+        }
+        r.year++;
+    }
+    return false;
+}
+
+bool rollupOpen(RollupReader& r, RollupLevel level, uint32_t fromTs, uint32_t toTs) {
+    r.level = level;
+    r.fromTs = fromTs;
+    r.toTs = toTs;
+    r.year = rollupYearOf(fromTs);
+    r.toYear = rollupYearOf(toTs);
+    if (!rollupOpenYear(r)) return false;
+
+    // Records are in ts order; binary search the first one >= fromTs
+    uint32_t lo = 0, hi = r.file.size() / sizeof(RollupRecord);
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        uint32_t ts = 0;
+        r.file.seek(mid * sizeof(RollupRecord));
+        r.file.read((uint8_t*)&ts, sizeof(ts));
+        if (ts < fromTs) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    r.file.seek(lo * sizeof(RollupRecord));
+    return true;
+}
+
+bool rollupNext(RollupReader& r, RollupRecord& rec) {
+    while (r.file) {
+        if (r.file.read((uint8_t*)&rec, sizeof(rec)) == sizeof(rec)) {
+            if (rec.ts > r.toTs) {
+                r.file.close();
+                return false;
+            }
+            if (rec.ts >= r.fromTs) return true;
+            continue;
+        }
+        r.file.close();
+        r.year++;
+        if (!rollupOpenYear(r)) return false;
+    }
+    return false;
+}
+
+void rollupClose(RollupReader& r) {
+    if (r.file) r.file.close();
+}
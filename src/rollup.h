@@ -0,0 +1,46 @@
+// rollup.h - Hourly/daily history aggregates header
+#ifndef ROLLUP_H
+#define ROLLUP_H
+
+#include "config.h"
+#include "hist.h"
+
+#define ROLLUP_FAN_CHANNELS     4
+#define ROLLUP_CHANNELS         (HIST_CHANNELS + ROLLUP_FAN_CHANNELS)
+#define ROLLUP_FAN_BASE         HIST_CHANNELS   // fan duty channels follow the sensor channels
+#define ROLLUP_FAN_SCALE        1000            // fan avg is ON share in permille
+#define ROLLUP_SLICE            32              // records or lines processed per rollupTick()
+#define ROLLUP_CATCHUP_DAYS     7               // missed days rolled up after downtime
+#define ROLLUP_MIN_DAYS         3               // longer /history ranges read rollups
+#define ROLLUP_HOURLY_MAX_DAYS  7               // up to this range hourly, beyond daily
+
+enum RollupLevel { ROLLUP_HOURLY, ROLLUP_DAILY };
+enum RollupSource { ROLLUP_SRC_SENS = 0, ROLLUP_SRC_FAN = 1 };
+
+// Aggregate of one hour or one day; values use the histScale of the channel
+struct __attribute__((packed)) RollupRecord {
+    uint32_t ts;                        // local epoch of the hour/day start
+    uint16_t count[2];                  // samples per RollupSource
+    int32_t vmin[ROLLUP_CHANNELS];
+    int32_t vmax[ROLLUP_CHANNELS];
+    int32_t vavg[ROLLUP_CHANNELS];
+};
+
+// Reader over the per-year rollup files of one level
+struct RollupReader {
+    RollupLevel level;
+    File file;
+    uint16_t year;
+    uint16_t toYear;
+    uint32_t fromTs;
+    uint32_t toTs;
+};
+
+// Function declarations
+void rollupTick();
+bool rollupOpen(RollupReader& r, RollupLevel level, uint32_t fromTs, uint32_t toTs);
+bool rollupNext(RollupReader& r, RollupRecord& rec);
+void rollupClose(RollupReader& r);
+String rollupPath(RollupLevel level, uint16_t year);
+
+#endif // ROLLUP_H
@@ -2,113 +2,93 @@
 #include "sd.h"
 #include "globals.h"
 #include "logging.h"
+#include "hist.h"
+#include "appender.h"
+#include "manifest.h"
+#include "layout.h"
+#include "tier.h"
 
 bool initSD() {
-    SD_MMC.setPins(14,17,16);
-    if (!SD_MMC.begin("/sdcard", true)) {
+    initAppenders();
+    // The hot tier takes writes even when the card does not mount
+    initTier();
+    if (!storageBegin()) {
         sensorData.errorFlags[0] |= ERR_SD;
-        logEvent("SD:Init failed - check pins");
+        LOGE(LOG_MOD_SD, "SD:Init failed - %s", tierReady() ? "staging to flash" : "check pins");
         return false;
     }
+    LOGI(LOG_MOD_SD, "SD:Mounted via %s", storageName());
+    tierRefresh();
+    layoutMigrate();
+    // Backlog from before the reboot, ahead of anything that scans the card
+    if (!tierMigrateAll()) LOGW(LOG_MOD_SD, "SD:Staged backlog not fully migrated");
+    histCompactRecover();
+    histMigrateCsv();
+    manifestBuild();
+    tierManifestStaged();
+    // Only the newest day can end in a torn record
+    std::vector<ManifestEntry> sens = manifestRange(MF_SENS, 0, UINT32_MAX);
+    if (!sens.empty()) histRecover(histPath(sens.back().date));
     return true;
 }
 
 void saveHistorySens() {
-  if (sensorData.errorFlags[0] & ERR_SD) {
-    logEvent("SD:ERR - cannot save sensor history");
+  if ((sensorData.errorFlags[0] & ERR_SD) && !tierReady()) {
+    LOGE(LOG_MOD_SD, "SD:ERR - cannot save sensor history");
     return;
   }
-  String currentDate = myTZ.dateTime("Y-m-d");
-  if (currentDate != lastDate) {
-    lastDate = currentDate;
-    currentSensFile = String("/history_sens_") + myTZ.dateTime("Ymd") + String(".csv");
-    File file = SD_MMC.open(currentSensFile.c_str(), FILE_WRITE);
-    if (!file) {
-      logEvent("SD:Open fail for new sensor history file");
-      return;
-    }
-    file.println("Čas zapisa,Temperatura zunaj,Vlaga zunaj,Tlak zunaj,VOC zunaj,Svetloba zunaj,Temperatura DS,Vlaga DS,CO2 DS,Temperatura UT,Vlaga UT,Temperatura KOP,Vlaga KOP,Tlak WC,Vremenski code");
-    file.close();
-  }
-  File file = SD_MMC.open(currentSensFile.c_str(), FILE_APPEND);
-  if (!file) {
-    logEvent("SD:Open fail for sensor history append");
+  if (!timeSynced) {
+    LOGW(LOG_MOD_SD, "SD:Time not synced - sensor history sample skipped");
     return;
   }
-  char line[256];
-  String timeStr = myTZ.dateTime("H:i:s d.m.y");
-  if (!timeSynced) {
-    timeStr = String("millis:") + String(millis());
+  HistRecord rec;
+  histFromSensorData(rec, myTZ.now());
+  if (!histAppend(rec)) {
+    return;
   }
-  sprintf(line, "%s,%.1f,%.1f,%d,%d,%d,%.1f,%.1f,%d,%.1f,%.1f,%.1f,%.1f,%d,%d",
-          timeStr.c_str(),
-          sensorData.extTemp,
-          sensorData.extHumidity,
-          (int)sensorData.extPressure,
-          sensorData.extVOC,
-          sensorData.extLux,
-          sensorData.localTemp,
-          sensorData.localHumidity,
-          (int)sensorData.localCO2,
-          sensorData.utTemp,
-          sensorData.utHumidity,
-          sensorData.bathroomTemp,
-          sensorData.bathroomHumidity,
-          (int)sensorData.bathroomPressure,
-          sensorData.weatherCode);
-  file.println(line);
-  file.close();
-  logEvent("SD:Sens saved to " + currentSensFile);
+  currentSensFile = histPath(histDateOf(rec.ts));
+  LOGD(LOG_MOD_SD, "SD:Sens saved to %s", currentSensFile);
 }
 
 void saveFanHistory() {
-  if (sensorData.errorFlags[0] & ERR_SD) {
-    logEvent("SD:ERR - cannot save fan history");
+  if ((sensorData.errorFlags[0] & ERR_SD) && !tierReady()) {
+    LOGE(LOG_MOD_SD, "SD:ERR - cannot save fan history");
     return;
   }
-  String currentDate = myTZ.dateTime("Y-m-d");
-  if (currentDate != lastDate) {
-    lastDate = currentDate;
-    currentFanFile = String("/fan_history_") + myTZ.dateTime("Ymd") + String(".csv");
-    File file = SD_MMC.open(currentFanFile.c_str(), FILE_WRITE);
-    if (!file) {
-      logEvent("SD:Open fail for new fan history file");
-      return;
-    }
-    file.println("Čas zapisa,WC stanje,UT stanje,KOP stanje,DS stanje");
-    file.close();
-  }
-  File file = SD_MMC.open(currentFanFile.c_str(), FILE_APPEND);
-  if (!file) {
-    logEvent("SD:Open fail for fan history append");
+  // A new date switches the appender to a new file
+  currentFanFile = layoutPath(MF_FAN, histDateOf(myTZ.now()));
+  if (!appenderOpen(fanAppender, currentFanFile)) {
+    LOGE(LOG_MOD_SD, "SD:Open fail for fan history append");
     return;
   }
-  char line[128];
+  char line[192];
+  int n = 0;
+  if (appenderSize(fanAppender) == 0) {
+    n = snprintf(line, sizeof(line), "%s\n", FAN_CSV_HEADER);
+  }
   String timeStr = myTZ.dateTime("H:i:s d.m.y");
-  String wcState = (sensorData.fanStates[0] == 1 ? "ON" : "OFF");
-  String utState = (sensorData.fanStates[1] == 1 ? "ON" : "OFF");
-  String kopState = (sensorData.fanStates[2] == 1 ? "ON" : "OFF");
-  String dsState = (sensorData.fanStates[3] == 1 ? "ON" : "OFF");
-  sprintf(line, "%s,%s,%s,%s,%s",
-          timeStr.c_str(),
-          wcState.c_str(),
-          utState.c_str(),
-          kopState.c_str(),
-          dsState.c_str());
-  file.println(line);
-  file.close();
-  logEvent("SD:Fan saved to " + currentFanFile);
+  n += snprintf(line + n, sizeof(line) - n, "%s,%s,%s,%s,%s\n",
+                timeStr.c_str(),
+                sensorData.fanStates[0] == 1 ? "ON" : "OFF",
+                sensorData.fanStates[1] == 1 ? "ON" : "OFF",
+                sensorData.fanStates[2] == 1 ? "ON" : "OFF",
+                sensorData.fanStates[3] == 1 ? "ON" : "OFF");
+  if (!appenderWrite(fanAppender, line, min(n, (int)sizeof(line) - 1))) {
+    LOGE(LOG_MOD_SD, "SD:Write fail for fan history");
+    return;
+  }
+  LOGD(LOG_MOD_SD, "SD:Fan saved to %s", currentFanFile);
 }
 
 void flushLogs() {
-  logEvent("SD:Flushing logs");
+  LOGD(LOG_MOD_SD, "SD:Flushing logs");
   /* placeholder za log flush */
 }
 
 String readFile(const char* path) {
-    File f = SD_MMC.open(path, FILE_READ);
+    File f = storage.open(path, FILE_READ);
     if (!f) {
-        logEvent("SD: File open failed " + String(path));
+        LOGE(LOG_MOD_SD, "SD: File open failed %s", path);
         return "";
     }
     String s;
@@ -117,36 +97,80 @@ String readFile(const char* path) {
     return s;
 }
 
-String listFiles(const char* pattern, uint32_t from_date, uint32_t to_date) {
-    String files = "";
-    File root = SD_MMC.open("/");
-    while (true) {
-        File entry = root.openNextFile();
-        if (!entry) break;
-        String name = entry.name();
-        if (strstr(name.c_str(), pattern)) {
-            uint32_t fileDate = parseDateFromName(name);
-            if (fileDate >= from_date && fileDate <= to_date) {
-                if (files.length() > 0) files += ",";
-                files += name;
-            }
-        }
-        entry.close();
+// Day files of one ManifestType within [from_date, to_date], sorted by date
+std::vector<String> listFiles(uint8_t type, uint32_t from_date, uint32_t to_date) {
+    std::vector<String> files;
+    for (const ManifestEntry& e : manifestRange(type, from_date, to_date)) {
+        files.push_back(layoutPath(e.type, e.date));
     }
-    root.close();
     return files;
 }
 
-String listLogFiles(uint32_t from_date, uint32_t to_date) {
-    return listFiles("logs_", from_date, to_date);
+std::vector<String> listLogFiles(uint32_t from_date, uint32_t to_date) {
+    return listFiles(MF_LOGS, from_date, to_date);
 }
 
 uint32_t parseDateFromName(String name) {
-    int y = 0, m = 0, d = 0;
-    if (sscanf(name.c_str(), "/history_sens_%4d%2d%2d.csv", &y, &m, &d) == 3 ||
-        sscanf(name.c_str(), "/fan_history_%4d%2d%2d.csv", &y, &m, &d) == 3 ||
-        sscanf(name.c_str(), "/logs_%4d%2d%2d.txt", &y, &m, &d) == 3) {
-        return y * 10000 + m * 100 + d;
+    ManifestEntry e;
+    return manifestParse(name, e) ? e.date : 0;
+}
+
+// Reads one line without the trailing newline; overlong lines are truncated.
+// Returns false once the file is exhausted.
+bool readLine(File& f, char* line, size_t cap) {
+    size_t n = 0;
+    int c = -1;
+    while ((c = f.read()) >= 0) {
+        if (c == '\n') break;
+        if (n + 1 < cap) line[n++] = (char)c;
+    }
+    if (n > 0 && line[n - 1] == '\r') n--;
+    line[n] = '\0';
+    return c >= 0 || n > 0;
+}
+
+// Local epoch of 00:00 on a YYYYMMDD date
+uint32_t dateToEpoch(uint32_t date) {
+    return makeTime(0, 0, 0, date % 100, (date / 100) % 100, date / 10000);
+}
+
+uint32_t nextDate(uint32_t date) {
+    return histDateOf(dateToEpoch(date) + 86400UL);
+}
+
+// Days since 1970-01-01 of a YYYYMMDD date. Ages and cutoffs are day number
+// differences; YYYYMMDD integers only compare, they do not subtract.
+uint32_t dayNumber(uint32_t date) {
+    uint32_t y = date / 10000, m = (date / 100) % 100, d = date % 100;
+    if (m <= 2) y--;
+    uint32_t era = y / 400;
+    uint32_t yoe = y - era * 400;
+    uint32_t doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+uint32_t dayToDate(uint32_t day) {
+    uint32_t z = day + 719468;
+    uint32_t era = z / 146097;
+    uint32_t doe = z - era * 146097;
+    uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    uint32_t mp = (5 * doy + 2) / 153;
+    uint32_t d = doy - (153 * mp + 2) / 5 + 1;
+    uint32_t m = mp < 10 ? mp + 3 : mp - 9;
+    uint32_t y = yoe + era * 400 + (m <= 2);
+    return y * 10000 + m * 100 + d;
+}
+
+// CRC-16/CCITT (init 0xFFFF), same framing CRC as the RS485 link. Pass the
+// previous result as crc to continue over several buffers.
+uint16_t calcCRC16(const uint8_t* data, size_t len, uint16_t poly, uint16_t crc) {
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ poly) : (uint16_t)(crc << 1);
+        }
     }
-    return 0;
+    return crc;
 }
@@ -3,7 +3,10 @@
 #define SD_H
 
 #include "config.h"
-#include <SD_MMC.h>
+#include "storage.h"
+#include <vector>
+
+#define FAN_CSV_HEADER "Čas zapisa,WC stanje,UT stanje,KOP stanje,DS stanje"
 
 // Function declarations
 bool initSD();
@@ -11,8 +14,14 @@ void saveHistorySens();
 void saveFanHistory();
 void flushLogs();
 String readFile(const char* path);
-String listFiles(const char* pattern, uint32_t from_date = 0, uint32_t to_date = UINT32_MAX);
-String listLogFiles(uint32_t from_date = 0, uint32_t to_date = UINT32_MAX);
+std::vector<String> listFiles(uint8_t type, uint32_t from_date = 0, uint32_t to_date = UINT32_MAX);
+std::vector<String> listLogFiles(uint32_t from_date = 0, uint32_t to_date = UINT32_MAX);
 uint32_t parseDateFromName(String name);
+bool readLine(File& f, char* line, size_t cap);
+uint32_t dateToEpoch(uint32_t date);
+uint32_t nextDate(uint32_t date);
+uint32_t dayNumber(uint32_t date);
+uint32_t dayToDate(uint32_t day);
+uint16_t calcCRC16(const uint8_t* data, size_t len, uint16_t poly = 0x1021, uint16_t crc = 0xFFFF);
 
 #endif // SD_H
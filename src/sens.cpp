@@ -1,6 +1,8 @@
 // sens.cpp - Sensor module implementation
 #include "sens.h"
 #include "globals.h"
+#include "recent.h"
+#include "logging.h"
 #include <Wire.h>
 #include <Adafruit_SHT4x.h>
 #include <SensirionI2cScd4x.h>
@@ -25,17 +27,17 @@ bool initSensors() {
         if (sht41->begin()) {
           sht41->setPrecision(SHT4X_HIGH_PRECISION);
           sht41->setHeater(SHT4X_NO_HEATER);
-          Serial.println("[Sensor] SHT41 initialized");
+          LOGI(LOG_MOD_SENSOR, "Sensor:SHT41 initialized");
           Serial.flush();
           break;
         } else {
-          Serial.println("[Sensor] SHT41 begin failed");
+          LOGE(LOG_MOD_SENSOR, "Sensor:SHT41 begin failed");
           Serial.flush();
           delete sht41;
           sht41 = nullptr;
         }
       } else {
-        Serial.println("[Sensor] SHT41 not detected at 0x44");
+        LOGW(LOG_MOD_SENSOR, "Sensor:SHT41 not detected at 0x44");
         Serial.flush();
       }
       delay(200);
@@ -53,21 +55,21 @@ bool initSensors() {
         if (!scdError) {
           scdError = scd40->startPeriodicMeasurement();
           if (!scdError) {
-            Serial.println("[Sensor] SCD40 initialized");
+            LOGI(LOG_MOD_SENSOR, "Sensor:SCD40 initialized");
             Serial.flush();
             break;
           } else {
-            Serial.println("[Sensor] SCD40 startPeriodicMeasurement failed");
+            LOGE(LOG_MOD_SENSOR, "Sensor:SCD40 startPeriodicMeasurement failed");
             Serial.flush();
           }
         } else {
-          Serial.println("[Sensor] SCD40 stopPeriodicMeasurement failed");
+          LOGE(LOG_MOD_SENSOR, "Sensor:SCD40 stopPeriodicMeasurement failed");
           Serial.flush();
         }
         delete scd40;
         scd40 = nullptr;
       } else {
-        Serial.println("[Sensor] SCD40 not detected at 0x62");
+        LOGW(LOG_MOD_SENSOR, "Sensor:SCD40 not detected at 0x62");
         Serial.flush();
       }
       delay(200);
@@ -80,8 +82,7 @@ bool initSensors() {
 }
 
 void readSensors() {
-    Serial.println("Sensor periodic read called");
-    Serial.flush();
+    LOGD(LOG_MOD_SENSOR, "Sensor:Periodic read");
 
     if (Wire.available()) return; // Avoid conflicts
 
@@ -96,9 +97,9 @@ void readSensors() {
 
             // Validate values
             if (isnan(newTemp) || newTemp < -40.0f || newTemp > 125.0f) {
-                Serial.printf("[SHT41] Invalid temperature: %.2f\n", newTemp);
+                LOGW(LOG_MOD_SENSOR, "Sensor:SHT41 invalid temperature: %.2f", newTemp);
             } else if (isnan(newHum) || newHum < 0.0f || newHum > 100.0f) {
-                Serial.printf("[SHT41] Invalid humidity: %.2f\n", newHum);
+                LOGW(LOG_MOD_SENSOR, "Sensor:SHT41 invalid humidity: %.2f", newHum);
             } else {
                 // Always update values (no threshold checking)
                 sensorData.localTemp = newTemp;
@@ -106,11 +107,11 @@ void readSensors() {
                 sensorData.lastTemp = newTemp;
                 sensorData.lastHumidity = newHum;
                 updateUI = true;
-                Serial.printf("[Sensor] SHT41 read: temp=%.1f, humidity=%.1f\n", newTemp, newHum);
+                LOGD(LOG_MOD_SENSOR, "Sensor:SHT41 read: temp=%.1f, humidity=%.1f", newTemp, newHum);
             }
         }
     } else {
-        Serial.println("[Sensor] SHT41 not detected - skipping read");
+        LOGD(LOG_MOD_SENSOR, "Sensor:SHT41 not detected - skipping read");
     }
 
     // Read SCD40
@@ -126,26 +127,27 @@ void readSensors() {
 
                 // Validate value
                 if (isnan(newCO2) || newCO2 < 400.0f || newCO2 > 5000.0f) {
-                    Serial.printf("[SCD40] Invalid CO2: %.0f\n", newCO2);
+                    LOGW(LOG_MOD_SENSOR, "Sensor:SCD40 invalid CO2: %.0f", newCO2);
                 } else {
                     // Always update values (no threshold checking)
                     sensorData.localCO2 = newCO2;
                     sensorData.lastCO2 = newCO2;
                     updateUI = true;
-                    Serial.printf("[Sensor] SCD40 read: CO2=%d\n", co2);
+                    LOGD(LOG_MOD_SENSOR, "Sensor:SCD40 read: CO2=%d", co2);
                 }
             } else {
-                Serial.println("[SCD40] Read measurement failed");
+                LOGW(LOG_MOD_SENSOR, "Sensor:SCD40 read measurement failed");
             }
         } else {
-            Serial.println("[Sensor] SCD40 data not ready - skipping read");
+            LOGD(LOG_MOD_SENSOR, "Sensor:SCD40 data not ready - skipping read");
         }
     } else {
-        Serial.println("[Sensor] SCD40 not detected - skipping read");
+        LOGD(LOG_MOD_SENSOR, "Sensor:SCD40 not detected - skipping read");
     }
 
     // Update UI if any sensor changed
     if (updateUI) {
+        recentRecord();
         extern void updateUI(); // Declare extern to avoid including disp.h
         updateUI();
     }
@@ -0,0 +1,191 @@
+// series.cpp - Single-channel time series responses implementation
+#include "series.h"
+#include "globals.h"
+#include "logging.h"
+#include "hist.h"
+#include "columns.h"
+#include "manifest.h"
+#include "appender.h"
+#include "recent.h"
+#include <memory>
+
+// Per-response state; one day is open at a time, read from its column file
+// when there is one and from the row file otherwise (today, uncompacted days)
+struct SeriesState {
+    uint8_t ch;
+    uint32_t fromTs;
+    uint32_t toTs;
+    std::vector<ManifestEntry> days;
+    size_t day = 0;             // next entry of days to open
+    bool dayOpen = false;
+    bool columnar = false;
+    bool srcDone = false;
+    bool finished = false;
+    ColSeries col;
+    HistReader hist;
+    // Averaging into points buckets; 0 returns every sample
+    uint16_t points;
+    uint64_t width;
+    uint16_t emitted = 0;
+    int64_t sum = 0;
+    uint32_t n = 0;
+    bool stashed = false;       // first sample of a later bucket
+    uint32_t stashTs;
+    int32_t stashValue;
+    uint32_t samples = 0;
+    uint16_t colDays = 0;
+    uint16_t rowDays = 0;
+    char line[SERIES_ITEM_MAX];
+    size_t lineLen = 0;
+    size_t linePos = 0;
+
+    ~SeriesState() {
+        if (dayOpen) {
+            if (columnar) colClose(col);
+            else histClose(hist);
+        }
+    }
+};
+
+// Channel names are the sensorData field names /api/recent uses
+int seriesChannel(const String& name) {
+    for (uint8_t ch = 0; ch < HIST_CHANNELS; ch++) {
+        if (name == recentChannelName(ch)) return ch;
+    }
+    return -1;
+}
+
+static bool seriesNextSample(SeriesState& st, uint32_t& ts, int32_t& value) {
+    while (true) {
+        if (!st.dayOpen) {
+            if (st.day >= st.days.size()) return false;
+            uint32_t date = st.days[st.day++].date;
+            st.columnar = HIST_COLUMNS && colOpen(st.col, date, st.ch, st.fromTs, st.toTs);
+            if (st.columnar) {
+                st.dayOpen = true;
+                st.colDays++;
+            } else {
+                String path = histPath(date);
+                st.dayOpen = histOpen(st.hist, path.c_str(), st.fromTs, st.toTs);
+                st.rowDays += st.dayOpen;
+            }
+            continue;
+        }
+        if (st.columnar) {
+            if (colNext(st.col, ts, value)) return true;
+            colClose(st.col);
+        } else {
+            HistRecord rec;
+            if (histNext(st.hist, rec)) {
+                ts = rec.ts;
+                value = rec.v[st.ch];
+                return true;
+            }
+            histClose(st.hist);
+        }
+        st.dayOpen = false;
+    }
+}
+
+// Averages the samples of bucket st.emitted; false if it has none
+static bool seriesNextBucket(SeriesState& st, int32_t& avg) {
+    while (!st.srcDone) {
+        if (!st.stashed) {
+            if (!seriesNextSample(st, st.stashTs, st.stashValue)) {
+                st.srcDone = true;
+                break;
+            }
+            st.stashed = true;
+        }
+        uint16_t b = (uint16_t)(((uint64_t)(st.stashTs - st.fromTs) * st.points) / st.width);
+        if (b > st.emitted) break;
+        st.sum += st.stashValue;
+        st.n++;
+        st.samples++;
+        st.stashed = false;
+    }
+    bool has = st.n > 0;
+    if (has) avg = (int32_t)(st.sum / st.n);
+    st.sum = 0;
+    st.n = 0;
+    st.emitted++;
+    return has;
+}
+
+static size_t seriesFormatValue(uint8_t ch, int32_t v, char* out, size_t len) {
+    int n = histScale[ch] == 1 ? snprintf(out, len, "%ld", (long)v)
+                               : snprintf(out, len, "%.1f", (float)v / histScale[ch]);
+    return min((size_t)max(n, 0), len - 1);
+}
+
+// Loads the next JSON element into st.line; false when the response is complete
+static bool seriesNextItem(SeriesState& st) {
+    if (st.finished) return false;
+    const char* sep = (st.points ? st.emitted : st.samples) > 0 ? "," : "";
+    size_t len = 0;
+    if (st.points) {
+        if (st.emitted < st.points) {
+            int32_t avg;
+            len = snprintf(st.line, sizeof(st.line), "%s", sep);
+            if (seriesNextBucket(st, avg)) {
+                len += seriesFormatValue(st.ch, avg, st.line + len, sizeof(st.line) - len);
+            } else {
+                len += snprintf(st.line + len, sizeof(st.line) - len, "null");
+            }
+        }
+    } else {
+        uint32_t ts;
+        int32_t value;
+        if (seriesNextSample(st, ts, value)) {
+            len = snprintf(st.line, sizeof(st.line), "%s[%lu,", sep, (unsigned long)ts);
+            len += seriesFormatValue(st.ch, value, st.line + len, sizeof(st.line) - len - 1);
+            st.line[len++] = ']';
+            st.samples++;
+        }
+    }
+    if (len == 0) {
+        len = snprintf(st.line, sizeof(st.line), "]}");
+        st.finished = true;
+        LOGI(LOG_MOD_WEB, "WEB: Series %s %lu samples, days columnar %u rows %u", recentChannelName(st.ch),
+             st.samples, st.colDays, st.rowDays);
+    }
+    st.lineLen = len;
+    st.linePos = 0;
+    return true;
+}
+
+// {"ch":..,"from":..,"to":..,"data":[[ts,v],..]}, or with points > 0
+// {"ch":..,"from":..,"to":..,"step":..,"data":[v|null,..]} of bucket averages
+AsyncWebServerResponse* beginSeries(AsyncWebServerRequest* request, uint8_t ch,
+                                    uint32_t fromTs, uint32_t toTs, uint16_t points) {
+    appenderSyncAll();  // make buffered samples visible
+
+    std::shared_ptr<SeriesState> st = std::make_shared<SeriesState>();
+    st->ch = ch;
+    st->fromTs = fromTs;
+    st->toTs = toTs;
+    st->points = min(points, (uint16_t)SERIES_MAX_POINTS);
+    st->width = (uint64_t)toTs - fromTs + 1;
+    if (fromTs <= toTs) st->days = manifestRange(MF_SENS, histDateOf(fromTs), histDateOf(toTs));
+
+    int n = snprintf(st->line, sizeof(st->line), "{\"ch\":\"%s\",\"from\":%lu,\"to\":%lu,",
+                     recentChannelName(ch), (unsigned long)fromTs, (unsigned long)toTs);
+    if (st->points) {
+        n += snprintf(st->line + n, sizeof(st->line) - n, "\"step\":%lu,",
+                      (unsigned long)(st->width / st->points));
+    }
+    n += snprintf(st->line + n, sizeof(st->line) - n, "\"data\":[");
+    st->lineLen = n;
+
+    return request->beginChunkedResponse("application/json", [st](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+        size_t written = 0;
+        while (written < maxLen) {
+            if (st->linePos >= st->lineLen && !seriesNextItem(*st)) break;
+            size_t n = min(st->lineLen - st->linePos, maxLen - written);
+            memcpy(buffer + written, st->line + st->linePos, n);
+            st->linePos += n;
+            written += n;
+        }
+        return written;
+    });
+}
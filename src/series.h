@@ -0,0 +1,17 @@
+// series.h - Single-channel time series responses header
+#ifndef SERIES_H
+#define SERIES_H
+
+#include "config.h"
+#include <ESPAsyncWebServer.h>
+
+#define SERIES_MAX_SPAN     (400UL * 86400UL)   // longest accepted range
+#define SERIES_MAX_POINTS   1440
+#define SERIES_ITEM_MAX     96                  // one formatted JSON element or the head
+
+// Function declarations
+int seriesChannel(const String& name);
+AsyncWebServerResponse* beginSeries(AsyncWebServerRequest* request, uint8_t ch,
+                                    uint32_t fromTs, uint32_t toTs, uint16_t points);
+
+#endif // SERIES_H
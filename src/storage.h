@@ -0,0 +1,54 @@
+// storage.h - SD storage backend header
+#ifndef STORAGE_H
+#define STORAGE_H
+
+#include "config.h"
+#include <FS.h>
+
+// Backends; select one with -D STORAGE_BACKEND=<n> in platformio.ini
+#define STORAGE_SDMMC   0       // ESP32 SDMMC host, 1-bit bus (default)
+#define STORAGE_SDFAT   1       // vendored SdFat over SPI
+#define STORAGE_POSIX   2       // plain files below STORAGE_POSIX_ROOT (host builds)
+
+#ifndef STORAGE_BACKEND
+#define STORAGE_BACKEND STORAGE_SDMMC
+#endif
+
+// Backends that preallocate the reserve of storageCreate(); closing such a
+// file hands the unwritten part back
+#define STORAGE_RESERVES    (STORAGE_BACKEND == STORAGE_SDFAT)
+
+#define SD_MOUNT_POINT "/sdcard"
+
+// SPI wiring for STORAGE_SDFAT: the SDMMC CLK/CMD/D0 lines, CS on the card's D3
+#ifndef SDFAT_CS_PIN
+#define SDFAT_CS_PIN        21
+#endif
+#define SDFAT_SCK_PIN       14
+#define SDFAT_MOSI_PIN      17
+#define SDFAT_MISO_PIN      16
+#define SDFAT_SPI_MHZ       25
+#define SDFAT_USAGE_MS      300000UL      // freeClusterCount() walks the whole FAT; cached this long
+
+// Host builds of STORAGE_SDFAT: -D SDFAT_IMAGE='"<path>"' puts the volume on a
+// disk image file instead of the SPI card
+#define SDFAT_IMAGE_MB      256           // size of an image created by storageBegin()
+
+#ifndef STORAGE_POSIX_ROOT
+#define STORAGE_POSIX_ROOT  "./sdcard"
+#endif
+
+// The card itself, and the view every module opens files through. storage
+// is the tiered view from tier.cpp; it falls through to storageBackend.
+extern fs::FS& storageBackend;
+extern fs::FS& storage;
+
+// Function declarations
+bool storageBegin();
+void storageEnd();
+const char* storageName();
+File storageCreate(const String& path, uint32_t reserve);
+bool storageTruncate(const String& path, uint32_t len);
+bool storageUsage(uint64_t& total, uint64_t& used);
+
+#endif // STORAGE_H
@@ -0,0 +1,157 @@
+// storage_posix.cpp - POSIX file storage backend implementation
+#include "storage.h"
+#if STORAGE_BACKEND == STORAGE_POSIX
+#include <FSImpl.h>
+#include <stdio.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+#include <unistd.h>
+
+// Volume paths ("/2026/10/sens_17.bin") map below STORAGE_POSIX_ROOT, so a
+// host build runs the same code against a directory or a mounted disk image
+static String posixReal(const char* path) {
+    return String(STORAGE_POSIX_ROOT) + path;
+}
+
+class PosixFileImpl : public fs::FileImpl {
+public:
+    PosixFileImpl(const String& path, FILE* file, DIR* dir) : _path(path), _file(file), _dir(dir) {
+        int slash = _path.lastIndexOf('/');
+        _name = slash >= 0 ? _path.substring(slash + 1) : _path;
+    }
+    ~PosixFileImpl() { close(); }
+
+    size_t write(const uint8_t* buf, size_t size) { return _file ? fwrite(buf, 1, size, _file) : 0; }
+    size_t read(uint8_t* buf, size_t size) { return _file ? fread(buf, 1, size, _file) : 0; }
+    void flush() {
+        if (_file) fflush(_file);
+    }
+    bool seek(uint32_t pos, fs::SeekMode mode) {
+        int whence = mode == fs::SeekCur ? SEEK_CUR : mode == fs::SeekEnd ? SEEK_END : SEEK_SET;
+        return _file && fseek(_file, pos, whence) == 0;
+    }
+    size_t position() const { return _file ? ftell(_file) : 0; }
+    size_t size() const {
+        struct stat st;
+        if (_file) fflush(_file);
+        return stat(posixReal(_path.c_str()).c_str(), &st) == 0 ? st.st_size : 0;
+    }
+    bool setBufferSize(size_t size) { return _file && setvbuf(_file, NULL, _IOFBF, size) == 0; }
+    void close() {
+        if (_file) fclose(_file);
+        if (_dir) closedir(_dir);
+        _file = NULL;
+        _dir = NULL;
+    }
+    time_t getLastWrite() {
+        struct stat st;
+        return stat(posixReal(_path.c_str()).c_str(), &st) == 0 ? st.st_mtime : 0;
+    }
+    const char* path() const { return _path.c_str(); }
+    const char* name() const { return _name.c_str(); }
+    boolean isDirectory(void) { return _dir != NULL; }
+    fs::FileImplPtr openNextFile(const char* mode);
+    boolean seekDir(long position) {
+        if (!_dir) return false;
+        seekdir(_dir, position);
+        return true;
+    }
+    String getNextFileName(void) {
+        bool isDir;
+        return getNextFileName(&isDir);
+    }
+    String getNextFileName(bool* isDir) {
+        struct dirent* e = nextEntry();
+        if (!e) return "";
+        String child = childPath(e->d_name);
+        struct stat st;
+        if (isDir) *isDir = stat(posixReal(child.c_str()).c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+        return child;
+    }
+    void rewindDirectory(void) {
+        if (_dir) rewinddir(_dir);
+    }
+    operator bool() { return _file != NULL || _dir != NULL; }
+
+private:
+    struct dirent* nextEntry() {
+        struct dirent* e;
+        while (_dir && (e = readdir(_dir)) != NULL) {
+            if (strcmp(e->d_name, ".") != 0 && strcmp(e->d_name, "..") != 0) return e;
+        }
+        return NULL;
+    }
+    String childPath(const char* name) const { return _path.endsWith("/") ? _path + name : _path + "/" + name; }
+
+    String _path;
+    String _name;
+    FILE* _file;
+    DIR* _dir;
+};
+
+static fs::FileImplPtr posixOpen(const String& path, const char* mode) {
+    String real = posixReal(path.c_str());
+    struct stat st;
+    if (stat(real.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) {
+        DIR* dir = opendir(real.c_str());
+        return dir ? std::make_shared<PosixFileImpl>(path, (FILE*)NULL, dir) : fs::FileImplPtr();
+    }
+    // Binary modes; "r+" keeps the content like the SD_MMC VFS does
+    char m[4] = {mode[0], mode[1] == '+' ? '+' : 'b', mode[1] == '+' ? 'b' : '\0', '\0'};
+    FILE* file = fopen(real.c_str(), m);
+    return file ? std::make_shared<PosixFileImpl>(path, file, (DIR*)NULL) : fs::FileImplPtr();
+}
+
+fs::FileImplPtr PosixFileImpl::openNextFile(const char* mode) {
+    struct dirent* e = nextEntry();
+    return e ? posixOpen(childPath(e->d_name), mode) : fs::FileImplPtr();
+}
+
+class PosixFSImpl : public fs::FSImpl {
+public:
+    fs::FileImplPtr open(const char* path, const char* mode, const bool) { return posixOpen(path, mode); }
+    bool exists(const char* path) {
+        struct stat st;
+        return stat(posixReal(path).c_str(), &st) == 0;
+    }
+    bool rename(const char* pathFrom, const char* pathTo) {
+        return ::rename(posixReal(pathFrom).c_str(), posixReal(pathTo).c_str()) == 0;
+    }
+    bool remove(const char* path) { return unlink(posixReal(path).c_str()) == 0; }
+    bool mkdir(const char* path) { return ::mkdir(posixReal(path).c_str(), 0755) == 0; }
+    bool rmdir(const char* path) { return ::rmdir(posixReal(path).c_str()) == 0; }
+};
+
+static fs::FS posixFs(fs::FSImplPtr(new PosixFSImpl()));
+fs::FS& storageBackend = posixFs;
+
+bool storageBegin() {
+    struct stat st;
+    return stat(STORAGE_POSIX_ROOT, &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+void storageEnd() {
+}
+
+const char* storageName() {
+    return "POSIX";
+}
+
+File storageCreate(const String& path, uint32_t) {
+    return posixFs.open(path.c_str(), "w+");
+}
+
+bool storageTruncate(const String& path, uint32_t len) {
+    return truncate(posixReal(path.c_str()).c_str(), len) == 0;
+}
+
+bool storageUsage(uint64_t& total, uint64_t& used) {
+    struct statvfs st;
+    if (statvfs(STORAGE_POSIX_ROOT, &st) != 0) return false;
+    total = (uint64_t)st.f_blocks * st.f_frsize;
+    used = total - (uint64_t)st.f_bfree * st.f_frsize;
+    return total > 0;
+}
+
+#endif // STORAGE_BACKEND == STORAGE_POSIX
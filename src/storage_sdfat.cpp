@@ -0,0 +1,282 @@
+// storage_sdfat.cpp - SdFat storage backend implementation
+#include "storage.h"
+#if STORAGE_BACKEND == STORAGE_SDFAT
+#include <FSImpl.h>
+#include <SPI.h>
+#include <SdFat.h>
+#include <time.h>
+#include <vector>
+#ifdef SDFAT_IMAGE
+#include <stdio.h>
+#include <unistd.h>
+#endif
+
+static SdFs sdfat;
+static int32_t sdfatFree = -1;          // cached freeClusterCount(), -1 when stale
+static uint32_t sdfatFreeMs = 0;
+
+static oflag_t sdfatFlags(const char* mode) {
+    if (mode[0] == 'w') return O_RDWR | O_CREAT | O_TRUNC;
+    if (mode[0] == 'a') return O_RDWR | O_CREAT | O_APPEND;
+    return mode[1] == '+' ? O_RDWR : O_RDONLY;
+}
+
+static String sdfatChildPath(const String& dir, const char* name) {
+    return dir.endsWith("/") ? dir + name : dir + "/" + name;
+}
+
+// fs::File adapter over an SdFat FsFile. Writes go straight to the card:
+// whole sectors of an appender block are sent as one multi-sector write
+// instead of passing through a stdio buffer. The FsFile is opened in place;
+// copies of an open FsFile would each sync the directory entry on close.
+class SdFatFileImpl : public fs::FileImpl {
+public:
+    SdFatFileImpl() : _preallocated(false) {}
+    ~SdFatFileImpl() { close(); }
+
+    FsFile& file() { return _file; }
+    void setPath(const String& path) {
+        _path = path;
+        int slash = _path.lastIndexOf('/');
+        _name = slash >= 0 ? _path.substring(slash + 1) : _path;
+    }
+    // FAT preAllocate() sets the file size to the whole reserve; until close
+    // the size is the end of what was written, also for other handles on
+    // the file
+    void setPreallocated(bool preallocated) {
+        _preallocated = preallocated;
+        _end = preallocated ? std::make_shared<uint32_t>(0) : nullptr;
+    }
+    bool reserves(const char* path) { return _preallocated && _file.isOpen() && _path == path; }
+    void shareEnd(const SdFatFileImpl& writer) { _end = writer._end; }
+
+    size_t write(const uint8_t* buf, size_t size) {
+        size_t n = _file.write(buf, size);
+        if (_preallocated) *_end = max(*_end, (uint32_t)_file.curPosition());
+        return n;
+    }
+    size_t read(uint8_t* buf, size_t size) {
+        if (_end) size = min(size, (size_t)(*_end - min(*_end, (uint32_t)_file.curPosition())));
+        int n = _file.read(buf, size);
+        return n < 0 ? 0 : n;
+    }
+    void flush() { _file.sync(); }
+    bool seek(uint32_t pos, fs::SeekMode mode) {
+        if (mode == fs::SeekCur) return _file.seekCur(pos);
+        if (mode == fs::SeekEnd) return _file.seekSet(size() + pos);
+        return _file.seekSet(pos);
+    }
+    size_t position() const { return _file.curPosition(); }
+    size_t size() const { return _end ? *_end : _file.fileSize(); }
+    bool setBufferSize(size_t size) { return false; }
+    void close() {
+        if (!_file.isOpen()) return;
+        // Hand back the clusters reserved by storageCreate() but never written
+        if (_preallocated) _file.truncate(*_end);
+        _file.close();
+    }
+    time_t getLastWrite() {
+        uint16_t date, time;
+        if (!_file.getModifyDateTime(&date, &time)) return 0;
+        struct tm tm = {};
+        tm.tm_year = FS_YEAR(date) - 1900;
+        tm.tm_mon = FS_MONTH(date) - 1;
+        tm.tm_mday = FS_DAY(date);
+        tm.tm_hour = FS_HOUR(time);
+        tm.tm_min = FS_MINUTE(time);
+        tm.tm_sec = FS_SECOND(time);
+        return mktime(&tm);
+    }
+    const char* path() const { return _path.c_str(); }
+    const char* name() const { return _name.c_str(); }
+    boolean isDirectory(void) { return _file.isDir(); }
+    fs::FileImplPtr openNextFile(const char* mode) {
+        if (!_file.isDir()) return fs::FileImplPtr();
+        std::shared_ptr<SdFatFileImpl> next = std::make_shared<SdFatFileImpl>();
+        if (!next->file().openNext(&_file, sdfatFlags(mode))) return fs::FileImplPtr();
+        char name[64];
+        next->file().getName(name, sizeof(name));
+        next->setPath(sdfatChildPath(_path, name));
+        return next;
+    }
+    boolean seekDir(long position) { return _file.isDir() && _file.seekSet(position); }
+    String getNextFileName(void) {
+        bool isDir;
+        return getNextFileName(&isDir);
+    }
+    String getNextFileName(bool* isDir) {
+        FsFile next;
+        char name[64];
+        if (!_file.isDir() || !next.openNext(&_file, O_RDONLY)) return "";
+        next.getName(name, sizeof(name));
+        if (isDir) *isDir = next.isDir();
+        next.close();
+        return sdfatChildPath(_path, name);
+    }
+    void rewindDirectory(void) { _file.rewindDirectory(); }
+    operator bool() { return _file.isOpen(); }
+
+private:
+    FsFile _file;
+    String _path;
+    String _name;
+    bool _preallocated;
+    std::shared_ptr<uint32_t> _end;     // written size of a preallocated file
+};
+
+// Preallocated files still open, so readers see their written size. The
+// tier replays on the loop task while web handlers open files.
+static std::vector<std::weak_ptr<SdFatFileImpl>> sdfatReserved;
+static SemaphoreHandle_t sdfatLock = NULL;
+
+static void sdfatShareEnd(SdFatFileImpl& reader, const char* path) {
+    xSemaphoreTake(sdfatLock, portMAX_DELAY);
+    for (size_t i = 0; i < sdfatReserved.size();) {
+        std::shared_ptr<SdFatFileImpl> writer = sdfatReserved[i].lock();
+        if (!writer || !writer->file().isOpen()) {
+            sdfatReserved.erase(sdfatReserved.begin() + i);
+            continue;
+        }
+        if (writer->reserves(path)) reader.shareEnd(*writer);
+        i++;
+    }
+    xSemaphoreGive(sdfatLock);
+}
+
+class SdFatFSImpl : public fs::FSImpl {
+public:
+    fs::FileImplPtr open(const char* path, const char* mode, const bool create) {
+        if (create && mode[0] != 'r') {
+            String dir = String(path).substring(0, String(path).lastIndexOf('/'));
+            if (dir.length() > 0 && !sdfat.exists(dir.c_str())) sdfat.mkdir(dir.c_str(), true);
+        }
+        std::shared_ptr<SdFatFileImpl> impl = std::make_shared<SdFatFileImpl>();
+        if (!impl->file().open(&sdfat, path, sdfatFlags(mode))) return fs::FileImplPtr();
+        impl->setPath(path);
+        if (mode[0] == 'r' && mode[1] != '+') sdfatShareEnd(*impl, path);
+        return impl;
+    }
+    bool exists(const char* path) { return sdfat.exists(path); }
+    bool rename(const char* pathFrom, const char* pathTo) { return sdfat.rename(pathFrom, pathTo); }
+    bool remove(const char* path) {
+        sdfatFree = -1;         // the freed clusters show in the next storageUsage()
+        return sdfat.remove(path);
+    }
+    bool mkdir(const char* path) { return sdfat.mkdir(path, true); }
+    bool rmdir(const char* path) { return sdfat.rmdir(path); }
+};
+
+static fs::FS sdfatFs(fs::FSImplPtr(new SdFatFSImpl()));
+fs::FS& storageBackend = sdfatFs;
+
+#ifdef SDFAT_IMAGE
+// Sectors of a disk image file, for running the backend on a host. A
+// missing image is created and formatted, as a new card would be.
+class SdImageDevice : public FsBlockDevice {
+public:
+    bool begin() {
+        _file = fopen(SDFAT_IMAGE, "r+b");
+        if (_file) {
+            fseeko(_file, 0, SEEK_END);
+            _sectors = ftello(_file) / 512;
+            return _sectors > 0;
+        }
+        _file = fopen(SDFAT_IMAGE, "w+b");
+        if (!_file) return false;
+        _sectors = SDFAT_IMAGE_MB * 2048UL;
+        if (ftruncate(fileno(_file), (off_t)_sectors * 512) != 0) return false;
+        FsFormatter formatter;
+        uint8_t sector[512];
+        return formatter.format(this, sector);
+    }
+    void end() {
+        if (_file) fclose(_file);
+        _file = NULL;
+    }
+
+    bool isBusy() { return false; }
+    bool readSector(uint32_t sector, uint8_t* dst) { return readSectors(sector, dst, 1); }
+    bool readSectors(uint32_t sector, uint8_t* dst, size_t ns) {
+        return fseeko(_file, (off_t)sector * 512, SEEK_SET) == 0 && fread(dst, 512, ns, _file) == ns;
+    }
+    uint32_t sectorCount() { return _sectors; }
+    bool syncDevice() { return fflush(_file) == 0; }
+    bool writeSector(uint32_t sector, const uint8_t* src) { return writeSectors(sector, src, 1); }
+    bool writeSectors(uint32_t sector, const uint8_t* src, size_t ns) {
+        return fseeko(_file, (off_t)sector * 512, SEEK_SET) == 0 && fwrite(src, 512, ns, _file) == ns;
+    }
+
+private:
+    FILE* _file = NULL;
+    uint32_t _sectors = 0;
+};
+
+static SdImageDevice sdfatImage;
+
+bool storageBegin() {
+    sdfatFree = -1;
+    if (!sdfatLock) sdfatLock = xSemaphoreCreateMutex();
+    sdfatImage.end();
+    return sdfatImage.begin() && sdfat.FsVolume::begin(&sdfatImage);
+}
+
+void storageEnd() {
+    sdfat.end();
+    sdfatImage.end();
+}
+#else
+bool storageBegin() {
+    sdfatFree = -1;
+    if (!sdfatLock) sdfatLock = xSemaphoreCreateMutex();
+    SPI.begin(SDFAT_SCK_PIN, SDFAT_MISO_PIN, SDFAT_MOSI_PIN, SDFAT_CS_PIN);
+    return sdfat.begin(SdSpiConfig(SDFAT_CS_PIN, DEDICATED_SPI, SD_SCK_MHZ(SDFAT_SPI_MHZ), &SPI));
+}
+
+void storageEnd() {
+    sdfat.end();
+}
+#endif // SDFAT_IMAGE
+
+const char* storageName() {
+    return "SdFat";
+}
+
+// New day files get reserve bytes of contiguous clusters up front, so
+// appends never walk or extend the FAT chain
+File storageCreate(const String& path, uint32_t reserve) {
+    std::shared_ptr<SdFatFileImpl> impl = std::make_shared<SdFatFileImpl>();
+    if (!impl->file().open(&sdfat, path.c_str(), O_RDWR | O_CREAT | O_TRUNC)) return File();
+    impl->setPath(path);
+    impl->setPreallocated(reserve > 0 && impl->file().preAllocate(reserve));
+    if (reserve > 0) {
+        xSemaphoreTake(sdfatLock, portMAX_DELAY);
+        sdfatReserved.push_back(impl);
+        xSemaphoreGive(sdfatLock);
+    }
+    return File(impl);
+}
+
+bool storageTruncate(const String& path, uint32_t len) {
+    FsFile file = sdfat.open(path.c_str(), O_RDWR);
+    if (!file) return false;
+    bool ok = file.truncate(len);
+    file.close();
+    sdfatFree = -1;
+    return ok;
+}
+
+// Retention asks on every pass; the count is refreshed every SDFAT_USAGE_MS
+// and after a file was removed or cut
+bool storageUsage(uint64_t& total, uint64_t& used) {
+    if (sdfatFree < 0 || millis() - sdfatFreeMs >= SDFAT_USAGE_MS) {
+        sdfatFree = sdfat.freeClusterCount();
+        sdfatFreeMs = millis();
+        if (sdfatFree < 0) return false;
+    }
+    uint64_t cluster = sdfat.bytesPerCluster();
+    total = (uint64_t)sdfat.clusterCount() * cluster;
+    used = total - (uint64_t)sdfatFree * cluster;
+    return total > 0;
+}
+
+#endif // STORAGE_BACKEND == STORAGE_SDFAT
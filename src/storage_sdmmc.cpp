@@ -0,0 +1,38 @@
+// storage_sdmmc.cpp - SD_MMC storage backend implementation
+#include "storage.h"
+#if STORAGE_BACKEND == STORAGE_SDMMC
+#include <SD_MMC.h>
+#include <unistd.h>
+
+fs::FS& storageBackend = SD_MMC;
+
+bool storageBegin() {
+    SD_MMC.setPins(14, 17, 16);
+    return SD_MMC.begin(SD_MOUNT_POINT, true);
+}
+
+void storageEnd() {
+    SD_MMC.end();
+}
+
+const char* storageName() {
+    return "SD_MMC";
+}
+
+// FATFS has no contiguous preallocation; the reserve is ignored
+File storageCreate(const String& path, uint32_t reserve) {
+    return SD_MMC.open(path.c_str(), "w+");
+}
+
+bool storageTruncate(const String& path, uint32_t len) {
+    return truncate((String(SD_MOUNT_POINT) + path).c_str(), len) == 0;
+}
+
+// FATFS keeps the free cluster count after the first (slow) scan
+bool storageUsage(uint64_t& total, uint64_t& used) {
+    total = SD_MMC.totalBytes();
+    used = SD_MMC.usedBytes();
+    return total > 0;
+}
+
+#endif // STORAGE_BACKEND == STORAGE_SDMMC
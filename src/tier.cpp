@@ -0,0 +1,873 @@
+// tier.cpp - LittleFS hot tier in front of the SD card implementation
+#include "tier.h"
+#include "globals.h"
+#include "logging.h"
+#include "sd.h"
+#include "layout.h"
+#include "manifest.h"
+#include <FSImpl.h>
+#include <LittleFS.h>
+#include <ArduinoJson.h>
+#include <vector>
+
+// How the staged chunks of a path relate to the card file of the same name
+enum TierMode : uint8_t {
+    TIER_ABS,                   // chunk offsets are card positions
+    TIER_REL,                   // staged while the card was away: appends to the card size
+    TIER_NEW                    // created in the stage; the card content is replaced
+};
+
+struct TierPath {
+    String path;
+    uint8_t mode;
+    bool baseKnown;             // baseSize was read from the mounted card
+    uint32_t baseSize;
+    uint32_t stagedEnd;         // end of the staged data (relative for TIER_REL)
+};
+
+// Card file created with a reserve. Closing it hands the unwritten
+// clusters back, so it stays open across replays (and stage resets) until
+// the next day's file takes its place or the path is touched directly.
+struct TierKept {
+    String path;
+    File file;
+};
+
+struct TierChunk {
+    uint8_t pathId;
+    uint8_t op;
+    uint16_t len;
+    uint32_t offset;
+    uint32_t dataPos;           // data position in the stage log
+};
+
+static bool tierMounted = false;
+static bool tierCard = false;           // the card was mounted and sized the paths
+static bool tierBroken = false;         // a stage write failed; stop staging until reset
+static bool tierDraining = false;       // replay to the end (backlog after a remount)
+static File tierStage;
+static uint32_t tierStageBytes = 0;
+static std::vector<TierPath> tierPaths;
+static std::vector<TierChunk> tierChunks;
+static std::vector<TierKept> tierKept;
+static size_t tierReplayed = 0;         // chunks already on the card
+static uint32_t tierOldestMs = 0;       // millis() of the oldest chunk not yet replayed
+static uint32_t tierLastRemount = 0;
+static uint32_t tierEpoch = 0;          // bumped when the stage is reset
+static uint32_t tierMigrated = 0;
+static uint32_t tierDropped = 0;
+static uint32_t tierRemounts = 0;
+static String tierNote;                 // logged once the lock is released
+static TaskHandle_t tierLoopTask = NULL;    // the only task that replays
+static uint8_t tierBuf[TIER_WRITE_BUF];
+
+// Staged writes come from loop() and from AsyncTCP handlers
+static SemaphoreHandle_t tierLock = NULL;
+
+static void lockTier() {
+    if (tierLock) xSemaphoreTakeRecursive(tierLock, portMAX_DELAY);
+}
+
+static void unlockTier() {
+    if (tierLock) xSemaphoreGiveRecursive(tierLock);
+}
+
+// Logging may flush the log through the tier, so messages raised while
+// the chunk index is being walked are deferred until the lock is released
+static void tierFlushNote() {
+    if (tierNote.length() == 0) return;
+    String note = tierNote;
+    tierNote = "";
+    logText(LOG_LVL_WARN, LOG_MOD_SD, note.c_str());
+}
+
+static bool tierCardUp() {
+    return tierCard && !(sensorData.errorFlags[0] & ERR_SD);
+}
+
+bool tierReady() {
+    return tierMounted;
+}
+
+// Replay runs on the loop task only: tierTarget() goes through the
+// layoutEnsureDir() cache, which belongs to it, and an AsyncTCP handler or
+// the log writer must not stall on a full migration
+static bool tierOnLoop() {
+    return xTaskGetCurrentTaskHandle() == tierLoopTask;
+}
+
+static int tierFind(const String& path) {
+    for (size_t i = 0; i < tierPaths.size(); i++) {
+        if (tierPaths[i].path == path) return i;
+    }
+    return -1;
+}
+
+static bool tierCardSize(const String& path, uint32_t& size) {
+    size = 0;
+    if (!tierCardUp()) return false;
+    if (!storageBackend.exists(path.c_str())) return true;
+    File f = storageBackend.open(path.c_str(), FILE_READ);
+    if (!f) return false;
+    size = f.size();
+    f.close();
+    return true;
+}
+
+static int tierAddPath(const String& path, uint8_t mode) {
+    int id = tierFind(path);
+    if (id >= 0) return id;
+    if (tierPaths.size() >= TIER_MAX_PATHS || path.length() == 0 || path.length() > TIER_PATH_MAX) return -1;
+    TierPath p;
+    p.path = path;
+    p.mode = mode;
+    p.baseKnown = tierCardSize(path, p.baseSize);
+    p.stagedEnd = 0;
+    tierPaths.push_back(p);
+    return tierPaths.size() - 1;
+}
+
+// Card bytes visible below the staged chunks
+static uint32_t tierViewBase(const TierPath& p) {
+    return p.mode == TIER_NEW || !p.baseKnown ? 0 : p.baseSize;
+}
+
+static uint32_t tierChunkPos(const TierPath& p, const TierChunk& c) {
+    return c.op == TIER_APPEND ? tierViewBase(p) + c.offset : c.offset;
+}
+
+static uint32_t tierSizeOf(const TierPath& p) {
+    uint32_t base = tierViewBase(p);
+    return p.mode == TIER_REL ? base + p.stagedEnd : max(base, p.stagedEnd);
+}
+
+static void tierExtend(TierPath& p, uint8_t op, uint32_t offset, uint16_t len) {
+    uint32_t end = offset + len;
+    if (op == TIER_WRITE && p.mode == TIER_REL) {
+        uint32_t base = tierViewBase(p);
+        end = end > base ? end - base : 0;
+    }
+    p.stagedEnd = max(p.stagedEnd, end);
+}
+
+// Recomputes stagedEnd once the card size of a TIER_REL path is known
+static void tierRecount(int id) {
+    TierPath& p = tierPaths[id];
+    p.stagedEnd = 0;
+    for (size_t i = 0; i < tierChunks.size(); i++) {
+        const TierChunk& c = tierChunks[i];
+        if (c.pathId == id && c.op != TIER_CREATE && c.op != TIER_CREATE_BLIND) tierExtend(p, c.op, c.offset, c.len);
+    }
+}
+
+static void tierIndexChunk(int id, uint8_t op, uint32_t offset, uint16_t len, uint32_t dataPos) {
+    TierPath& p = tierPaths[id];
+    if (op == TIER_CREATE || op == TIER_CREATE_BLIND) {
+        // Everything staged for the path before is superseded
+        size_t out = 0;
+        size_t replayed = tierReplayed;
+        for (size_t i = 0; i < tierChunks.size(); i++) {
+            if (tierChunks[i].pathId == id) {
+                if (i < tierReplayed) replayed--;
+                continue;
+            }
+            tierChunks[out++] = tierChunks[i];
+        }
+        tierChunks.resize(out);
+        tierReplayed = replayed;
+        p.mode = TIER_NEW;
+        p.stagedEnd = 0;
+    } else {
+        tierExtend(p, op, offset, len);
+    }
+    TierChunk c = {(uint8_t)id, op, len, offset, dataPos};
+    tierChunks.push_back(c);
+    if (tierChunks.size() - tierReplayed == 1) tierOldestMs = millis();
+}
+
+static uint16_t tierChunkCrc(TierChunkHeader h, const char* path, const uint8_t* data, uint16_t len) {
+    h.crc = 0;
+    uint16_t crc = calcCRC16((const uint8_t*)&h, sizeof(h));
+    crc = calcCRC16((const uint8_t*)path, h.pathLen, 0x1021, crc);
+    return calcCRC16(data, len, 0x1021, crc);
+}
+
+static bool tierStageChunk(uint8_t op, int id, uint32_t offset, const uint8_t* data, uint16_t len) {
+    if (tierBroken) return false;
+    const String& path = tierPaths[id].path;
+    uint32_t total = sizeof(TierChunkHeader) + path.length() + len;
+    if (tierStageBytes + total > TIER_MAX_BYTES) {
+        if (tierDropped == 0) tierNote = "TIER:Stage full - dropping writes until SD is back";
+        tierDropped += len;
+        return false;
+    }
+
+    TierChunkHeader h = {TIER_MAGIC, op, (uint8_t)path.length(), offset, len, 0};
+    h.crc = tierChunkCrc(h, path.c_str(), data, len);
+    bool ok = tierStage.write((const uint8_t*)&h, sizeof(h)) == sizeof(h) &&
+              tierStage.write((const uint8_t*)path.c_str(), h.pathLen) == h.pathLen &&
+              (len == 0 || tierStage.write(data, len) == len);
+    tierStage.flush();
+    if (!ok) {
+        // A torn chunk hides everything after it at the next boot
+        tierBroken = true;
+        tierNote = "TIER:Stage write failed - staging stopped";
+        return false;
+    }
+    tierIndexChunk(id, op, offset, len, tierStageBytes + sizeof(h) + h.pathLen);
+    tierStageBytes += total;
+    return true;
+}
+
+static bool tierHasBlindCreate(int id) {
+    for (size_t i = tierReplayed; i < tierChunks.size(); i++) {
+        if (tierChunks[i].pathId == id && tierChunks[i].op == TIER_CREATE_BLIND) return true;
+    }
+    return false;
+}
+
+static bool tierStageCreate(const String& path, uint32_t reserve) {
+    int id = tierAddPath(path, TIER_NEW);
+    if (id < 0) return false;
+    // Without the card the old content is unknown; the replay keeps it aside
+    uint8_t op = tierCardUp() && !tierHasBlindCreate(id) ? TIER_CREATE : TIER_CREATE_BLIND;
+    return tierStageChunk(op, id, reserve, NULL, 0);
+}
+
+// A handle's positions are card positions if it was opened with the card
+// mounted or on a path staged that way; otherwise they count from the
+// unknown card size and its writes become TIER_APPEND chunks
+static bool tierHandleAbsolute(const String& path) {
+    lockTier();
+    int id = tierFind(path);
+    bool absolute = tierCardUp() || (id >= 0 && tierPaths[id].mode != TIER_REL);
+    unlockTier();
+    return absolute;
+}
+
+static bool tierWriteAt(const String& path, bool absolute, uint32_t pos, const uint8_t* data, uint16_t len) {
+    lockTier();
+    bool ok = false;
+    int id = tierAddPath(path, tierCardUp() || absolute ? TIER_ABS : TIER_REL);
+    if (id >= 0) {
+        const TierPath& p = tierPaths[id];
+        uint32_t base = tierViewBase(p);
+        if (p.mode == TIER_REL && pos >= base) {
+            ok = tierStageChunk(TIER_APPEND, id, pos - base, data, len);
+        } else {
+            ok = tierStageChunk(TIER_WRITE, id, pos, data, len);
+        }
+    }
+    // A full stage is drained by tierTick(); the writer fails and retries
+    if (!ok && tierCardUp()) tierDraining = true;
+    unlockTier();
+    tierFlushNote();
+    return ok;
+}
+
+// Merged read: card bytes first, then every staged chunk of the path in
+// stage order on top. base is the reader's card handle, opened on demand and
+// reopened after a reset, when the replayed bytes have moved to the card.
+static size_t tierReadAt(const String& path, File& base, uint32_t& baseEpoch, uint32_t pos, uint8_t* buf, size_t len) {
+    lockTier();
+    if (base && baseEpoch != tierEpoch) base.close();
+    if (!base && tierCardUp()) {
+        base = storageBackend.open(path.c_str(), FILE_READ);
+        baseEpoch = tierEpoch;
+    }
+    int id = tierFind(path);
+    uint32_t size, baseSize;
+    if (id >= 0) {
+        size = tierSizeOf(tierPaths[id]);
+        baseSize = tierViewBase(tierPaths[id]);
+    } else {
+        size = baseSize = base ? base.size() : 0;
+    }
+    if (pos >= size) {
+        unlockTier();
+        return 0;
+    }
+    len = min(len, (size_t)(size - pos));
+    memset(buf, 0, len);
+
+    if (pos < baseSize) {
+        size_t n = min(len, (size_t)(baseSize - pos));
+        if (base && base.seek(pos)) base.read(buf, n);
+    }
+    for (size_t i = 0; id >= 0 && i < tierChunks.size(); i++) {
+        const TierChunk& c = tierChunks[i];
+        if (c.pathId != id) continue;
+        uint32_t start = tierChunkPos(tierPaths[id], c);
+        uint32_t from = max(pos, start);
+        uint32_t to = min((uint32_t)(pos + len), start + c.len);
+        if (from >= to) continue;
+        tierStage.seek(c.dataPos + (from - start));
+        tierStage.read(buf + (from - pos), to - from);
+    }
+    unlockTier();
+    return len;
+}
+
+static uint32_t tierSize(const String& path) {
+    lockTier();
+    int id = tierFind(path);
+    uint32_t size = 0;
+    if (id >= 0) {
+        size = tierSizeOf(tierPaths[id]);
+    } else {
+        tierCardSize(path, size);
+    }
+    unlockTier();
+    return size;
+}
+
+// Handle on a path with staged data: reads merge both tiers, writes (when
+// opened writable) are staged
+class TierFileImpl : public fs::FileImpl {
+public:
+    TierFileImpl(const String& path, bool writable) : _path(path), _writable(writable), _pos(0), _baseEpoch(0), _cacheOff(0), _cacheLen(0) {
+        int slash = _path.lastIndexOf('/');
+        _name = slash >= 0 ? _path.substring(slash + 1) : _path;
+        _absolute = tierHandleAbsolute(_path);
+    }
+    ~TierFileImpl() { close(); }
+
+    size_t write(const uint8_t* buf, size_t size) {
+        if (!_writable) return 0;
+        _cacheLen = 0;
+        size_t done = 0;
+        while (done < size) {
+            uint16_t n = min(size - done, (size_t)TIER_CHUNK_MAX);
+            if (!tierWriteAt(_path, _absolute, _pos, buf + done, n)) break;
+            _pos += n;
+            done += n;
+        }
+        return done;
+    }
+    size_t read(uint8_t* buf, size_t size) {
+        size_t done = 0;
+        while (done < size) {
+            if (_pos >= _cacheOff && _pos < _cacheOff + _cacheLen) {
+                size_t n = min(size - done, (size_t)(_cacheOff + _cacheLen - _pos));
+                memcpy(buf + done, _cache + (_pos - _cacheOff), n);
+                _pos += n;
+                done += n;
+                continue;
+            }
+            // Large reads bypass the cache
+            if (size - done >= TIER_READ_CACHE) {
+                size_t n = tierReadAt(_path, _base, _baseEpoch, _pos, buf + done, size - done);
+                _pos += n;
+                done += n;
+                break;
+            }
+            _cacheOff = _pos;
+            _cacheLen = tierReadAt(_path, _base, _baseEpoch, _pos, _cache, TIER_READ_CACHE);
+            if (_cacheLen == 0) break;
+        }
+        return done;
+    }
+    void flush() {}
+    bool seek(uint32_t pos, fs::SeekMode mode) {
+        if (mode == fs::SeekCur) pos += _pos;
+        if (mode == fs::SeekEnd) pos += tierSize(_path);
+        _pos = pos;
+        return true;
+    }
+    size_t position() const { return _pos; }
+    size_t size() const { return tierSize(_path); }
+    bool setBufferSize(size_t) { return false; }
+    void close() {
+        if (_base) _base.close();
+        _cacheLen = 0;
+    }
+    time_t getLastWrite() { return 0; }
+    const char* path() const { return _path.c_str(); }
+    const char* name() const { return _name.c_str(); }
+    boolean isDirectory(void) { return false; }
+    fs::FileImplPtr openNextFile(const char*) { return fs::FileImplPtr(); }
+    boolean seekDir(long) { return false; }
+    String getNextFileName(void) { return ""; }
+    String getNextFileName(bool*) { return ""; }
+    void rewindDirectory(void) {}
+    operator bool() { return true; }
+
+private:
+    String _path;
+    String _name;
+    bool _writable;
+    bool _absolute;
+    uint32_t _pos;
+    File _base;
+    uint32_t _baseEpoch;
+    uint8_t _cache[TIER_READ_CACHE];
+    uint32_t _cacheOff;
+    size_t _cacheLen;
+};
+
+// Pass-through to a card file or directory without staged data
+class TierCardFileImpl : public fs::FileImpl {
+public:
+    TierCardFileImpl(File file) : _file(file) {}
+
+    size_t write(const uint8_t* buf, size_t size) { return _file.write(buf, size); }
+    size_t read(uint8_t* buf, size_t size) { return _file.read(buf, size); }
+    void flush() { _file.flush(); }
+    bool seek(uint32_t pos, fs::SeekMode mode) { return _file.seek(pos, mode); }
+    size_t position() const { return _file.position(); }
+    size_t size() const { return _file.size(); }
+    bool setBufferSize(size_t size) { return _file.setBufferSize(size); }
+    void close() { _file.close(); }
+    time_t getLastWrite() { return _file.getLastWrite(); }
+    const char* path() const { return _file.path(); }
+    const char* name() const { return _file.name(); }
+    boolean isDirectory(void) { return _file.isDirectory(); }
+    fs::FileImplPtr openNextFile(const char* mode) {
+        File next = _file.openNextFile(mode);
+        return next ? std::make_shared<TierCardFileImpl>(next) : fs::FileImplPtr();
+    }
+    boolean seekDir(long position) { return _file.seekDir(position); }
+    String getNextFileName(void) { return _file.getNextFileName(); }
+    String getNextFileName(bool* isDir) { return _file.getNextFileName(isDir); }
+    void rewindDirectory(void) { _file.rewindDirectory(); }
+    operator bool() { return (bool)_file; }
+
+private:
+    mutable File _file;
+};
+
+static int tierFindKept(const String& path) {
+    for (size_t i = 0; i < tierKept.size(); i++) {
+        if (tierKept[i].path == path) return i;
+    }
+    return -1;
+}
+
+// Closes the kept handle of path before anything else opens it on the card
+static void tierForget(const String& path) {
+    lockTier();
+    int k = tierFindKept(path);
+    if (k >= 0) {
+        tierKept[k].file.close();
+        tierKept.erase(tierKept.begin() + k);
+    }
+    unlockTier();
+}
+
+static void tierForgetAll() {
+    lockTier();
+    for (TierKept& k : tierKept) k.file.close();
+    tierKept.clear();
+    unlockTier();
+}
+
+static fs::FileImplPtr tierCardOpen(const char* path, const char* mode, bool create) {
+    File f = storageBackend.open(path, mode, create);
+    return f ? std::make_shared<TierCardFileImpl>(f) : fs::FileImplPtr();
+}
+
+static bool tierStaged(const String& path) {
+    lockTier();
+    bool staged = tierFind(path) >= 0;
+    unlockTier();
+    return staged;
+}
+
+// Direct card writes to a staged path must not be overtaken by the replay;
+// they fail off the loop task until tierTick() has drained the stage
+static bool tierSettle(const String& path) {
+    bool ok = !tierStaged(path) || tierMigrateAll();
+    if (ok) tierForget(path);
+    return ok;
+}
+
+class TierFSImpl : public fs::FSImpl {
+public:
+    fs::FileImplPtr open(const char* path, const char* mode, const bool create) {
+        bool staged = tierStaged(path);
+        if (mode[0] == 'r' && mode[1] != '+') {
+            return staged ? std::make_shared<TierFileImpl>(path, false) : tierCardOpen(path, mode, create);
+        }
+        if (mode[0] == 'r') {
+            if (staged) return std::make_shared<TierFileImpl>(path, true);
+            tierForget(path);
+            return tierCardUp() || !tierMounted ? tierCardOpen(path, mode, create) : fs::FileImplPtr();
+        }
+        if (!tierSettle(path)) return fs::FileImplPtr();
+        return tierCardOpen(path, mode, create);
+    }
+    bool exists(const char* path) {
+        if (tierStaged(path)) return true;
+        return (tierCardUp() || !tierMounted) && storageBackend.exists(path);
+    }
+    bool rename(const char* pathFrom, const char* pathTo) {
+        return tierSettle(pathFrom) && tierSettle(pathTo) && storageBackend.rename(pathFrom, pathTo);
+    }
+    bool remove(const char* path) { return tierSettle(path) && storageBackend.remove(path); }
+    bool mkdir(const char* path) { return storageBackend.mkdir(path); }
+    bool rmdir(const char* path) { return storageBackend.rmdir(path); }
+};
+
+static fs::FS tierFs(fs::FSImplPtr(new TierFSImpl()));
+fs::FS& storage = tierFs;
+
+// Card file a run of chunks is replayed into
+static File tierTarget(const TierPath& p, const TierChunk& c) {
+    const char* path = p.path.c_str();
+    if (c.op == TIER_CREATE_BLIND && storageBackend.exists(path)) {
+        File old = storageBackend.open(path, FILE_READ);
+        uint32_t size = old ? old.size() : 0;
+        old.close();
+        if (size > 0) {
+            String aside = p.path + ".old";
+            if (storageBackend.exists(aside.c_str())) storageBackend.remove(aside.c_str());
+            storageBackend.rename(path, aside.c_str());
+            tierNote = "TIER:Kept card copy of " + p.path + " as " + aside;
+        }
+    }
+    if (c.op == TIER_CREATE || c.op == TIER_CREATE_BLIND) {
+        tierForget(p.path);
+        layoutEnsureDir(p.path);
+        File f = storageCreate(p.path, c.offset);
+        if (f && c.offset > 0 && STORAGE_RESERVES) {
+            if (tierKept.size() >= TIER_KEEP_OPEN) {
+                tierKept.front().file.close();
+                tierKept.erase(tierKept.begin());
+            }
+            tierKept.push_back({p.path, f});
+        }
+        return f;
+    }
+    int k = tierFindKept(p.path);
+    if (k >= 0) return tierKept[k].file;
+    if (!storageBackend.exists(path)) {
+        layoutEnsureDir(p.path);
+        return storageBackend.open(path, "w+");
+    }
+    return storageBackend.open(path, "r+");
+}
+
+static bool tierWriteRun(File& target, uint32_t& off, uint16_t& len) {
+    if (len == 0) return true;
+    bool ok = target.seek(off) && target.write(tierBuf, len) == len;
+    tierMigrated += len;
+    off += len;
+    len = 0;
+    return ok;
+}
+
+static bool tierCloseTarget(File& target, int id, uint32_t& off, uint16_t& len) {
+    if (!target) return true;
+    bool ok = tierWriteRun(target, off, len);
+    target.flush();
+    if (ok) manifestUpdate(tierPaths[id].path, target.size());
+    // A kept handle only loses this reference
+    if (tierFindKept(tierPaths[id].path) >= 0) target = File();
+    else target.close();
+    return ok;
+}
+
+static void tierResetStage() {
+    tierStage.close();
+    LittleFS.remove(TIER_STAGE_PATH);
+    tierStage = LittleFS.open(TIER_STAGE_PATH, "a+");
+    tierBroken = !tierStage;
+    tierStageBytes = 0;
+    tierPaths.clear();
+    tierChunks.clear();
+    tierReplayed = 0;
+    tierDraining = false;
+    tierEpoch++;
+    tierDropped = 0;
+}
+
+// Replays up to budget staged bytes. Contiguous chunks of one file are
+// coalesced into TIER_WRITE_BUF writes; the replay point only advances past
+// chunks that are fully on the card, so a failed slice is simply repeated.
+static bool tierReplay(uint32_t budget) {
+    File target;
+    int targetId = -1;
+    uint32_t runOff = 0;
+    uint16_t runLen = 0;
+    size_t i = tierReplayed;
+    size_t committed = tierReplayed;
+    uint32_t done = 0;
+    bool ok = true;
+
+    while (ok && i < tierChunks.size() && done < budget) {
+        TierChunk c = tierChunks[i];
+        bool create = c.op == TIER_CREATE || c.op == TIER_CREATE_BLIND;
+        if (c.pathId != targetId || create) {
+            ok = tierCloseTarget(target, targetId, runOff, runLen);
+            if (!ok) break;
+            committed = i;
+            target = tierTarget(tierPaths[c.pathId], c);
+            targetId = c.pathId;
+            if (!target) {
+                ok = false;
+                break;
+            }
+            if (create) {
+                committed = ++i;
+                continue;
+            }
+        }
+        TierPath& p = tierPaths[c.pathId];
+        if (c.op == TIER_APPEND && !p.baseKnown && !(p.baseKnown = tierCardSize(p.path, p.baseSize))) {
+            ok = false;
+            break;
+        }
+        uint32_t pos = c.op == TIER_APPEND ? p.baseSize + c.offset : c.offset;
+        if (runLen > 0 && pos != runOff + runLen) {
+            ok = tierWriteRun(target, runOff, runLen);
+            if (!ok) break;
+            committed = i;
+        }
+        if (runLen == 0) runOff = pos;
+        for (uint16_t got = 0; ok && got < c.len;) {
+            uint16_t n = min((uint16_t)(c.len - got), (uint16_t)(TIER_WRITE_BUF - runLen));
+            ok = tierStage.seek(c.dataPos + got) && tierStage.read(tierBuf + runLen, n) == n;
+            runLen += n;
+            got += n;
+            if (ok && runLen == TIER_WRITE_BUF) ok = tierWriteRun(target, runOff, runLen);
+        }
+        if (!ok) break;
+        done += c.len;
+        i++;
+    }
+    if (ok) {
+        ok = tierCloseTarget(target, targetId, runOff, runLen);
+        if (ok) committed = i;
+    } else {
+        if (target) target.close();
+        tierForgetAll();
+    }
+
+    tierReplayed = committed;
+    if (tierReplayed < tierChunks.size()) tierOldestMs = millis();
+    if (!ok) {
+        sensorData.errorFlags[0] |= ERR_SD;
+        tierNote = "TIER:Migration to SD failed, " + String(tierStageBytes) + " B stay staged";
+        return false;
+    }
+    if (tierReplayed == tierChunks.size()) tierResetStage();
+    return true;
+}
+
+// Replays everything staged; elsewhere than on the loop task it only asks
+// tierTick() to drain and reports whether the stage is already empty
+bool tierMigrateAll() {
+    if (!tierMounted) return true;
+    lockTier();
+    if (!tierOnLoop()) {
+        tierDraining = tierReplayed < tierChunks.size();
+        bool done = !tierDraining;
+        unlockTier();
+        return done;
+    }
+    bool ok = true;
+    while (ok && tierReplayed < tierChunks.size()) {
+        ok = tierCardUp() && tierReplay(UINT32_MAX);
+    }
+    unlockTier();
+    tierFlushNote();
+    return ok;
+}
+
+// Recovery truncates in place, which only the card can do
+bool tierTruncate(const String& path, uint32_t len) {
+    return tierSettle(path) && storageTruncate(path, len);
+}
+
+// Called after every successful mount: sizes paths staged without the card
+void tierRefresh() {
+    if (!tierMounted) return;
+    lockTier();
+    tierCard = true;
+    for (size_t id = 0; id < tierPaths.size(); id++) {
+        TierPath& p = tierPaths[id];
+        if (!p.baseKnown) p.baseKnown = tierCardSize(p.path, p.baseSize);
+        tierRecount(id);
+    }
+    tierDraining = !tierChunks.empty();
+    unlockTier();
+}
+
+// manifestBuild() only sees what is on the card; adds the staged view of
+// every path so days not yet replayed stay listed
+void tierManifestStaged() {
+    if (!tierMounted) return;
+    lockTier();
+    for (const TierPath& p : tierPaths) manifestUpdate(p.path, tierSizeOf(p));
+    unlockTier();
+}
+
+// Keeps the valid prefix of a stage log with a torn tail
+static void tierStageCut(uint32_t keep) {
+    tierStage.close();
+    File src = LittleFS.open(TIER_STAGE_PATH, FILE_READ);
+    File dst = LittleFS.open(TIER_STAGE_TMP, FILE_WRITE);
+    bool ok = src && dst;
+    for (uint32_t pos = 0; ok && pos < keep;) {
+        size_t n = min((uint32_t)TIER_WRITE_BUF, keep - pos);
+        ok = src.read(tierBuf, n) == n && dst.write(tierBuf, n) == n;
+        pos += n;
+    }
+    src.close();
+    dst.close();
+    ok = ok && LittleFS.remove(TIER_STAGE_PATH) && LittleFS.rename(TIER_STAGE_TMP, TIER_STAGE_PATH);
+    tierStage = LittleFS.open(TIER_STAGE_PATH, "a+");
+    tierBroken = !ok || !tierStage;
+}
+
+// Rebuilds the chunk index; stops at the first torn or corrupt chunk
+static void tierLoad() {
+    uint32_t size = tierStage.size();
+    uint32_t pos = 0;
+    while (pos + sizeof(TierChunkHeader) <= size) {
+        TierChunkHeader h;
+        char path[TIER_PATH_MAX + 1];
+        tierStage.seek(pos);
+        if (tierStage.read((uint8_t*)&h, sizeof(h)) != sizeof(h) || h.magic != TIER_MAGIC ||
+            h.op < TIER_WRITE || h.op > TIER_CREATE_BLIND || h.pathLen == 0 || h.pathLen > TIER_PATH_MAX ||
+            pos + sizeof(h) + h.pathLen + h.len > size ||
+            tierStage.read((uint8_t*)path, h.pathLen) != h.pathLen) {
+            break;
+        }
+        path[h.pathLen] = '\0';
+        TierChunkHeader zero = h;
+        zero.crc = 0;
+        uint16_t crc = calcCRC16((const uint8_t*)&zero, sizeof(zero));
+        crc = calcCRC16((const uint8_t*)path, h.pathLen, 0x1021, crc);
+        for (uint16_t got = 0; got < h.len;) {
+            uint16_t n = min((uint16_t)(h.len - got), (uint16_t)TIER_WRITE_BUF);
+            if (tierStage.read(tierBuf, n) != n) break;
+            crc = calcCRC16(tierBuf, n, 0x1021, crc);
+            got += n;
+        }
+        if (crc != h.crc) break;
+
+        uint8_t mode = h.op == TIER_APPEND ? TIER_REL : h.op == TIER_WRITE ? TIER_ABS : TIER_NEW;
+        int id = tierAddPath(path, mode);
+        if (id < 0) break;
+        tierIndexChunk(id, h.op, h.offset, h.len, pos + sizeof(h) + h.pathLen);
+        pos += sizeof(h) + h.pathLen + h.len;
+    }
+    tierStageBytes = pos;
+    if (pos < size) {
+        tierStageCut(pos);
+        tierNote = "TIER:Stage recovered, dropped " + String(size - pos) + " torn bytes";
+    }
+}
+
+bool initTier() {
+    if (!tierLock) tierLock = xSemaphoreCreateRecursiveMutex();
+    tierLoopTask = xTaskGetCurrentTaskHandle();     // setup() runs on the loop task
+    if (!LittleFS.begin(true)) {
+        LOGE(LOG_MOD_SD, "TIER:LittleFS mount failed - writing to SD directly");
+        return false;
+    }
+    tierStage = LittleFS.open(TIER_STAGE_PATH, "a+");
+    if (!tierStage) {
+        LOGE(LOG_MOD_SD, "TIER:Cannot open stage log - writing to SD directly");
+        return false;
+    }
+    tierMounted = true;
+    lockTier();
+    tierLoad();
+    size_t chunks = tierChunks.size();
+    unlockTier();
+    tierFlushNote();
+    if (chunks > 0) {
+        LOGI(LOG_MOD_SD, "TIER:%u staged chunks (%lu B) pending", chunks, tierStageBytes);
+    }
+    return true;
+}
+
+// Parent directories of path on the card. The log writer opens its day
+// file here too; off the loop task the directories are checked directly,
+// as the layoutEnsureDir() cache belongs to the loop task.
+static void tierEnsureDir(const String& path) {
+    if (tierOnLoop()) {
+        layoutEnsureDir(path);
+        return;
+    }
+    int slash = path.lastIndexOf('/');
+    for (int pos = path.indexOf('/', 1); pos > 0 && pos <= slash; pos = path.indexOf('/', pos + 1)) {
+        String dir = path.substring(0, pos);
+        if (!storageBackend.exists(dir.c_str())) storageBackend.mkdir(dir.c_str());
+    }
+}
+
+// Hot handle on path. create truncates (reserve is passed to the card
+// backend at replay); otherwise the content is kept.
+File tierOpen(const String& path, bool create, uint32_t reserve) {
+    if (!tierMounted) {
+        if (create) {
+            tierEnsureDir(path);
+            return storageCreate(path, reserve);
+        }
+        if (!storageBackend.exists(path.c_str())) {
+            tierEnsureDir(path);
+            return storageBackend.open(path.c_str(), "w+");
+        }
+        return storageBackend.open(path.c_str(), "r+");
+    }
+    if (create) {
+        lockTier();
+        bool ok = tierStageCreate(path, reserve);
+        unlockTier();
+        tierFlushNote();
+        if (!ok) return File();
+    }
+    return File(std::make_shared<TierFileImpl>(path, true));
+}
+
+void tierTick() {
+    if (!tierMounted) return;
+    uint32_t now = millis();
+
+    if (sensorData.errorFlags[0] & ERR_SD) {
+        if (now - tierLastRemount < TIER_REMOUNT_MS) return;
+        tierLastRemount = now;
+        tierForgetAll();
+        storageEnd();
+        if (!storageBegin()) return;
+        sensorData.errorFlags[0] &= ~ERR_SD;
+        tierRemounts++;
+        LOGI(LOG_MOD_SD, "TIER:SD remounted, replaying %lu staged bytes", tierStageBytes);
+        tierRefresh();
+        manifestBuild();
+        tierManifestStaged();
+    }
+
+    lockTier();
+    bool pending = tierReplayed < tierChunks.size();
+    bool due = tierDraining || tierStageBytes >= TIER_MIGRATE_BYTES || now - tierOldestMs >= TIER_MIGRATE_MS;
+    if (pending && due && tierCardUp()) tierReplay(TIER_SLICE_BYTES);
+    unlockTier();
+    tierFlushNote();
+}
+
+String tierStatsJson() {
+    JsonDocument doc;
+    lockTier();
+    doc["mounted"] = tierMounted;
+    doc["card"] = tierCardUp();
+    doc["broken"] = tierBroken;
+    doc["stagedBytes"] = tierStageBytes;
+    doc["chunks"] = tierChunks.size() - tierReplayed;
+    doc["paths"] = tierPaths.size();
+    doc["oldestMs"] = tierChunks.size() > tierReplayed ? millis() - tierOldestMs : 0;
+    doc["migratedBytes"] = tierMigrated;
+    doc["droppedBytes"] = tierDropped;
+    doc["remounts"] = tierRemounts;
+    unlockTier();
+    if (tierMounted) {
+        doc["flashUsed"] = LittleFS.usedBytes();
+        doc["flashTotal"] = LittleFS.totalBytes();
+    }
+    String json;
+    serializeJson(doc, json);
+    return json;
+}
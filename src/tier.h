@@ -0,0 +1,59 @@
+// tier.h - LittleFS hot tier in front of the SD card header
+#ifndef TIER_H
+#define TIER_H
+
+#include "config.h"
+#include "storage.h"
+
+// Small appends are staged as chunks in a redo log on the internal flash
+// (LittleFS) and replayed to the card in large sequential writes. While the
+// card is missing or failing the log keeps growing and is replayed after a
+// successful remount. Every read through `storage` merges both tiers.
+//
+// Stage log: a sequence of TierChunkHeader + path + data, CRC over all three.
+// Chunk offsets are file positions on the card, except TIER_APPEND chunks
+// which were staged while the card size was unknown and are relative to it.
+#define TIER_STAGE_PATH     "/tier.stg"
+#define TIER_STAGE_TMP      "/tier.tmp"
+#define TIER_MAGIC          0x5453        // "ST"
+#define TIER_PATH_MAX       64
+#define TIER_MAX_PATHS      32            // distinct files in the stage at once
+#define TIER_CHUNK_MAX      4096          // larger writes are split
+#define TIER_WRITE_BUF      4096          // replay coalesces chunks into writes of this size
+#define TIER_READ_CACHE     512
+#define TIER_MAX_BYTES      393216UL      // stage cap; the partition also holds the rewrite copy
+#define TIER_MIGRATE_BYTES  32768UL       // migrate once this much is staged
+#define TIER_MIGRATE_MS     1800000UL     // or once the oldest chunk is this old
+#define TIER_SLICE_BYTES    16384UL       // replayed per tierTick()
+#define TIER_REMOUNT_MS     60000UL       // remount attempt interval while ERR_SD is set
+#define TIER_KEEP_OPEN      3             // reserved day files kept open between replays
+
+enum TierOp : uint8_t {
+    TIER_WRITE = 1,             // data at offset
+    TIER_APPEND = 2,            // data at card size + offset
+    TIER_CREATE = 3,            // truncate/create; offset holds the reserve
+    TIER_CREATE_BLIND = 4       // created while the card was away; an existing
+                                // non-empty card file is kept as <path>.old
+};
+
+struct __attribute__((packed)) TierChunkHeader {
+    uint16_t magic;
+    uint8_t op;
+    uint8_t pathLen;
+    uint32_t offset;
+    uint16_t len;
+    uint16_t crc;               // over the header (crc = 0), path and data
+};
+
+// Function declarations
+bool initTier();
+bool tierReady();
+File tierOpen(const String& path, bool create, uint32_t reserve = 0);
+bool tierTruncate(const String& path, uint32_t len);
+void tierRefresh();
+void tierManifestStaged();
+bool tierMigrateAll();
+void tierTick();
+String tierStatsJson();
+
+#endif // TIER_H
@@ -1,15 +1,122 @@
 #include "web.h"
-#include "html.h"
+#include "webassets.h"
 #include "globals.h"
 #include "sd.h"
+#include "hist.h"
+#include "export.h"
+#include "appender.h"
+#include "rollup.h"
+#include "manifest.h"
+#include "logging.h"
+#include "merge.h"
+#include "logsearch.h"
+#include "jobs.h"
 #include <ESPAsyncWebServer.h>
+#include <vector>
 extern AsyncWebServer server;
 
-// Forward declaration for lambda functions
-extern void logEvent(String content);
+// Hourly rows as "HH:00 dd.mm.yy", daily rows as "dd.mm.yy"
+static String rollupTimeCell(const RollupRecord& rec, RollupLevel level) {
+  tmElements_t tm;
+  breakTime(rec.ts, tm);
+  char out[24];
+  if (level == ROLLUP_HOURLY) {
+    snprintf(out, sizeof(out), "%02u:00 %02u.%02u.%02u", tm.Hour, tm.Day, tm.Month, (tm.Year + 1970) % 100);
+  } else {
+    snprintf(out, sizeof(out), "%02u.%02u.%02u", tm.Day, tm.Month, (tm.Year + 1970) % 100);
+  }
+  return String(out);
+}
+
+// Average of a rollup channel in display units; fan channels as ON share in %
+static String rollupValueCell(const RollupRecord& rec, uint8_t ch) {
+  char out[16];
+  if (ch >= ROLLUP_FAN_BASE) {
+    if (rec.count[ROLLUP_SRC_FAN] == 0) return "-";
+    snprintf(out, sizeof(out), "%ld %%", (long)((rec.vavg[ch] + 5) / 10));
+  } else {
+    if (rec.count[ROLLUP_SRC_SENS] == 0) return "-";
+    if (histScale[ch] == 1) {
+      snprintf(out, sizeof(out), "%ld", (long)rec.vavg[ch]);
+    } else {
+      snprintf(out, sizeof(out), "%.1f", (float)rec.vavg[ch] / histScale[ch]);
+    }
+  }
+  return String(out);
+}
+
+// Table of hourly or daily averages for ranges longer than ROLLUP_MIN_DAYS
+static String rollupTableHtml(bool sens, uint32_t fromDate, uint32_t toDate, uint32_t& rows) {
+  uint32_t days = (dateToEpoch(toDate) - dateToEpoch(fromDate)) / 86400UL + 1;
+  RollupLevel level = days <= ROLLUP_HOURLY_MAX_DAYS ? ROLLUP_HOURLY : ROLLUP_DAILY;
+  String tableHtml = sens
+    ? "<table><thead><tr><th>Čas</th><th>Ext Temp</th><th>Ext Hum</th><th>Ext Pres</th><th>Ext VOC</th><th>Ext Lux</th><th>DS Temp</th><th>DS Hum</th><th>DS CO2</th><th>Ut Temp</th><th>Ut Hum</th><th>Kop Temp</th><th>Kop Hum</th><th>Wc Pres</th><th>Vreme</th></tr></thead><tbody>"
+    : "<table><thead><tr><th>Čas</th><th>WC</th><th>UT</th><th>KOP</th><th>DS</th></tr></thead><tbody>";
+  uint8_t first = sens ? 0 : ROLLUP_FAN_BASE;
+  uint8_t last = sens ? HIST_CHANNELS : ROLLUP_CHANNELS;
+
+  rows = 0;
+  RollupReader reader;
+  if (rollupOpen(reader, level, dateToEpoch(fromDate), dateToEpoch(toDate) + 86399UL)) {
+    RollupRecord rec;
+    while (rows < MAX_ROWS && rollupNext(reader, rec)) {
+      if (rec.count[sens ? ROLLUP_SRC_SENS : ROLLUP_SRC_FAN] == 0) continue;
+      tableHtml += "<tr><td>" + rollupTimeCell(rec, level) + "</td>";
+      for (uint8_t ch = first; ch < last; ch++) {
+        tableHtml += "<td>" + rollupValueCell(rec, ch) + "</td>";
+      }
+      tableHtml += "</tr>";
+      rows++;
+    }
+    rollupClose(reader);
+  }
+  tableHtml += "</tbody></table>";
+  tableHtml += String("<div class=\"warning\">Prikaz ") + (level == ROLLUP_HOURLY ? "urnih" : "dnevnih") +
+               " povprečij (agregati do včeraj); za polne podatke uporabi izvoz.</div>";
+  return tableHtml;
+}
+
+// "YYYY-MM-DD" or "YYYY-MM-DDTHH:MM" in local time; a bare date means the
+// start of that day, or its end with endOfDay
+static bool parseLocalDateTime(const String& str, bool endOfDay, uint32_t& ts) {
+  int y, m, d, h = 0, min = 0;
+  int n = sscanf(str.c_str(), "%d-%d-%dT%d:%d", &y, &m, &d, &h, &min);
+  if (n != 3 && n != 5) return false;
+  struct tm timeinfo = {0};
+  timeinfo.tm_year = y - 1900;
+  timeinfo.tm_mon = m - 1;
+  timeinfo.tm_mday = d;
+  timeinfo.tm_hour = h;
+  timeinfo.tm_min = min;
+  timeinfo.tm_sec = (n == 3 && endOfDay) ? 86399 : 0;
+  ts = mktime(&timeinfo);
+  return true;
+}
+
+// Page shell from flash, gzipped as stored. A browser that holds this
+// version gets 304 without a body; every browser takes gzip, so there is
+// no plain copy to fall back on.
+static void sendWebAsset(AsyncWebServerRequest *request, const WebAsset& asset) {
+  AsyncWebServerResponse *response;
+  if (request->hasHeader("If-None-Match") && request->header("If-None-Match").indexOf(asset.etag) >= 0) {
+    response = request->beginResponse(304);
+  } else {
+    response = request->beginResponse_P(200, "text/html", asset.data, asset.length);
+    response->addHeader("Content-Encoding", "gzip");
+  }
+  response->addHeader("ETag", asset.etag);
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
 
 void setupWebEndpoints() {
+  // The pages are static shells (webassets.h); their data comes from
+  // /status, /logs/rows and /history/rows
   server.on("/", HTTP_GET, [](AsyncWebServerRequest *request){
+    sendWebAsset(request, WEB_ROOT);
+  });
+
+  server.on("/status", HTTP_GET, [](AsyncWebServerRequest *request){
     String statusContent = "EXT: Temp=" + String(sensorData.extTemp, 1) + "°C, Hum=" + String(sensorData.extHumidity, 1) + "%, Pres=" + String((int)sensorData.extPressure) + " hPa, Lux=" + String((int)sensorData.extLux) + " lx\n";
     statusContent += "DS: Temp=" + String(sensorData.localTemp, 1) + "°C, Hum=" + String(sensorData.localHumidity, 1) + "%, CO2=" + String((int)sensorData.localCO2) + " ppm\n";
     statusContent += "UT: Temp=" + String(sensorData.utTemp, 1) + "°C, Hum=" + String(sensorData.utHumidity, 1) + "%\n";
@@ -22,13 +129,11 @@ void setupWebEndpoints() {
       statusContent += "\n<span class=\"error\">SD ni na voljo</span>";
     }
 
-    char htmlBuffer[4096];
-    snprintf(htmlBuffer, sizeof(htmlBuffer), HTML_ROOT, statusContent.c_str());
-    request->send(200, "text/html", htmlBuffer);
+    request->send(200, "text/html", statusContent);
   });
 
   server.on("/help", HTTP_GET, [](AsyncWebServerRequest *request){
-    request->send(200, "text/html", HTML_HELP);
+    sendWebAsset(request, WEB_HELP);
   });
 
   server.on("/delete", HTTP_GET, [](AsyncWebServerRequest *request){
@@ -49,61 +154,26 @@ void setupWebEndpoints() {
       }
       uint32_t deleteBefore = y * 10000 + m * 100 + d;
 
-      // Delete history_sens files
-      String sensFiles = listFiles("history_sens_", 0, deleteBefore - 1);
-      int deletedCount = 0;
-      int start = 0;
-      while (start < sensFiles.length()) {
-        int commaPos = sensFiles.indexOf(',', start);
-        String fileName = (commaPos == -1) ? sensFiles.substring(start) : sensFiles.substring(start, commaPos);
-        if (fileName.length() > 0 && SD_MMC.remove(fileName.c_str())) {
-          deletedCount++;
-        }
-        start = (commaPos == -1) ? sensFiles.length() : commaPos + 1;
-      }
-
-      // Delete fan_history files
-      String fanFiles = listFiles("fan_history_", 0, deleteBefore - 1);
-      start = 0;
-      while (start < fanFiles.length()) {
-        int commaPos = fanFiles.indexOf(',', start);
-        String fileName = (commaPos == -1) ? fanFiles.substring(start) : fanFiles.substring(start, commaPos);
-        if (fileName.length() > 0 && SD_MMC.remove(fileName.c_str())) {
-          deletedCount++;
-        }
-        start = (commaPos == -1) ? fanFiles.length() : commaPos + 1;
-      }
-
-      // Delete logs files (keep only last 7 days)
-      String logFiles = listFiles("logs_", 0, deleteBefore - 1);
-      start = 0;
-      while (start < logFiles.length()) {
-        int commaPos = logFiles.indexOf(',', start);
-        String fileName = (commaPos == -1) ? logFiles.substring(start) : logFiles.substring(start, commaPos);
-        if (fileName.length() > 0 && SD_MMC.remove(fileName.c_str())) {
-          deletedCount++;
-        }
-        start = (commaPos == -1) ? logFiles.length() : commaPos + 1;
+      // History_sens, fan_history and logs day files are removed by loop();
+      // progress is at /api/jobs/<id>
+      uint32_t jobId = jobSubmitDelete((1 << MF_TYPES) - 1, deleteBefore);
+      if (jobId == JOB_NONE) {
+        request->send(503, "text/html", "<h1>Preveč opravil v teku</h1><a href='/delete'>Nazaj</a>");
+        return;
       }
 
-      logEvent("WEB: Delete completed, removed " + String(deletedCount) + " files before " + up_to);
-      request->redirect("/?msg=Brisanje%20uspešno%20-%20izbrisanih%20" + String(deletedCount) + "%20datotek");
-    } else if (up_to.length() > 0) {
-      // Show confirmation
-      char htmlBuffer[2048];
-      snprintf(htmlBuffer, sizeof(htmlBuffer), HTML_DELETE_CONFIRM, up_to.c_str(), up_to.c_str());
-      request->send(200, "text/html", htmlBuffer);
+      LOGI(LOG_MOD_WEB, "WEB: Delete before %s queued as job %lu", up_to, jobId);
+      request->redirect("/?msg=Brisanje%20v%20teku%20-%20opravilo%20" + String(jobId));
     } else {
-      // Show form
-      char htmlBuffer[1024];
-      snprintf(htmlBuffer, sizeof(htmlBuffer), HTML_DELETE_FORM, myTZ.dateTime("Y-m-d").c_str());
-      request->send(200, "text/html", htmlBuffer);
+      // The form, or with up_to its confirmation
+      sendWebAsset(request, WEB_DELETE);
     }
   });
 
-  server.on("/logs", HTTP_GET, [](AsyncWebServerRequest *request){
+  // Table of the /logs page for its query
+  server.on("/logs/rows", HTTP_GET, [](AsyncWebServerRequest *request){
     if (sensorData.errorFlags[0] & ERR_SD) {
-      request->send(503, "text/html", "<h1>SD ni na voljo</h1><a href='/'>Nazaj</a>");
+      request->send(503, "text/html", "<p class=\"warning\">SD ni na voljo.</p>");
       return;
     }
 
@@ -148,115 +218,62 @@ void setupWebEndpoints() {
       from_unix = to_unix - 3600;
     }
 
-    // List log files for last 7 days
-    uint32_t sevenDaysAgo = myTZ.now() - (7 * 24 * 3600);
-    uint32_t today = myTZ.now();
-    String logFiles = listLogFiles(sevenDaysAgo, today);
-
-    // Parse log entries
-    struct LogEntry {
-      uint32_t unix_time;
-      String unit;
-      String message;
-    };
-
-    std::vector<LogEntry> entries;
-
-    // Split file list and read each file
-    int fileStart = 0;
-    while (fileStart < logFiles.length()) {
-      int commaPos = logFiles.indexOf(',', fileStart);
-      String fileName = (commaPos == -1) ? logFiles.substring(fileStart) : logFiles.substring(fileStart, commaPos);
-
-      if (fileName.length() > 0) {
-        String fileContent = readFile(fileName.c_str());
-        if (fileContent.length() > 0) {
-          // Parse lines
-          int lineStart = 0;
-          while (lineStart < fileContent.length()) {
-            int lineEnd = fileContent.indexOf('\n', lineStart);
-            if (lineEnd == -1) lineEnd = fileContent.length();
-
-            String line = fileContent.substring(lineStart, lineEnd);
-            line.trim();
-
-            if (line.length() > 0) {
-              // Parse unix|unit|message
-              int pipe1 = line.indexOf('|');
-              int pipe2 = line.indexOf('|', pipe1 + 1);
-
-              if (pipe1 > 0 && pipe2 > pipe1) {
-                String unixStr = line.substring(0, pipe1);
-                String unitStr = line.substring(pipe1 + 1, pipe2);
-                String msgStr = line.substring(pipe2 + 1);
-
-                uint32_t unix_time = unixStr.toInt();
-                if (unix_time >= from_unix && unix_time <= to_unix) {
-                  LogEntry entry;
-                  entry.unix_time = unix_time;
-                  entry.unit = unitStr;
-                  entry.message = msgStr;
-                  entries.push_back(entry);
-                }
-              }
-            }
-
-            lineStart = lineEnd + 1;
-          }
-        }
-      }
-
-      fileStart = (commaPos == -1) ? logFiles.length() : commaPos + 1;
-    }
-
-    // Sort entries by unix_time descending
-    for (size_t i = 0; i < entries.size(); i++) {
-      for (size_t j = i + 1; j < entries.size(); j++) {
-        if (entries[j].unix_time > entries[i].unix_time) {
-          LogEntry temp = entries[i];
-          entries[i] = entries[j];
-          entries[j] = temp;
-        }
-      }
-    }
+    // Keyword/severity search over a range of days instead of the hour
+    LogQuery query;
+    query.q = request->arg("q");
+    String levelStr = request->arg("level");
+    String fromStr = request->arg("from");
+    String toStr = request->arg("to");
+    int level = levelStr.length() > 0 ? logLevelByName(levelStr) : 0;
+    query.level = level > 0 ? level : 0;
+    query.fromTs = from_unix;
+    query.toTs = to_unix;
+    query.limit = MAX_ROWS;
+    bool search = query.q.length() > 0 || query.level > 0 || fromStr.length() > 0 || toStr.length() > 0;
+    if (search) {
+      uint32_t ts;
+      query.toTs = parseLocalDateTime(toStr, true, ts) ? ts : (uint32_t)myTZ.now();
+      query.fromTs = parseLocalDateTime(fromStr, false, ts) ? ts : query.toTs - LOG_SEARCH_DAYS * 86400UL;
+    }
+
+    // The keyword index and the hour index narrow each day file to the
+    // records that can match; rows come newest first
+    std::vector<LogHit> hits;
+    bool more = logSearch(query, hits);
+    uint32_t totalEntries = hits.size();
 
     // Build HTML table
     String tableHtml = "<div class=\"scrollable\"><table><thead><tr><th>Čas (lokalni)</th><th>Enota</th><th>Sporočilo</th></tr></thead><tbody>";
 
-    int maxEntries = entries.size() > MAX_ROWS ? MAX_ROWS : entries.size();
-
-    for (int i = 0; i < maxEntries; i++) {
-      LogEntry entry = entries[i];
-
-      // Determine row class based on message content
-      String rowClass = "row-c"; // default green
-      if (entry.message.indexOf("ERR") >= 0 || entry.message.indexOf("failed") >= 0) {
-        rowClass = "row-r"; // red for errors
-      }
-
-      String localTime = myTZ.dateTime(entry.unix_time, "H:i:s d.m.y");
-      tableHtml += "<tr class=\"" + rowClass + "\"><td>" + localTime + "</td><td>" + entry.unit + "</td><td>" + entry.message + "</td></tr>";
+    for (const LogHit& hit : hits) {
+      // Severity of the record; text lines (CEW, older files) have none
+      const char* rowClass = hit.level == LOG_LVL_ERR ? "row-r" : hit.level == LOG_LVL_WARN ? "row-w" : "row-c";
+      String localTime = myTZ.dateTime(hit.ts, "H:i:s d.m.y");
+      tableHtml += "<tr class=\"" + String(rowClass) + "\"><td>" + localTime + "</td><td>" + hit.unit + "</td><td>" + hit.message + "</td></tr>";
     }
 
     tableHtml += "</tbody></table></div>";
 
-    if (entries.size() == 0) {
+    if (totalEntries == 0) {
       tableHtml = "<p>Ni podatkov za izbrano obdobje.</p>";
-    } else if (entries.size() > MAX_ROWS) {
+    } else if (more) {
       tableHtml += "<div class=\"warning\">Prikaz omejen na " + String(MAX_ROWS) + " vrstic; za polne podatke uporabi izvoz.</div>";
     }
 
-    logEvent("WEB: Request /logs for " + dateStr + " " + timeStr + ", found " + String(entries.size()) + " entries");
+    if (search) {
+      LOGI(LOG_MOD_WEB, "WEB: Search /logs for '%s' level %s, found %d entries", query.q, levelStr, totalEntries);
+    } else {
+      LOGI(LOG_MOD_WEB, "WEB: Request /logs for %s %s, found %d entries", dateStr, timeStr, totalEntries);
+    }
 
-    // Send response
-    char htmlBuffer[8192];
-    snprintf(htmlBuffer, sizeof(htmlBuffer), HTML_LOGS_FORM, dateStr.c_str(), timeStr.c_str(), tableHtml.c_str());
-    request->send(200, "text/html", htmlBuffer);
+    // The live tail keeps as many rows
+    request->send(200, "text/html", "<div data-max-rows=\"" + String(MAX_ROWS) + "\">" + tableHtml + "</div>");
   });
 
-  server.on("/history", HTTP_GET, [](AsyncWebServerRequest *request){
+  // Table of the /history page for its query
+  server.on("/history/rows", HTTP_GET, [](AsyncWebServerRequest *request){
     if (sensorData.errorFlags[0] & ERR_SD) {
-      request->send(503, "text/html", "<h1>SD ni na voljo</h1><a href='/'>Nazaj</a>");
+      request->send(503, "text/html", "<p class=\"warning\">SD ni na voljo.</p>");
       return;
     }
 
@@ -287,104 +304,116 @@ void setupWebEndpoints() {
       toDate = y * 10000 + m * 100 + d;
     }
 
+    // Long ranges are answered from the nightly aggregates
+    if (fromDate && toDate && fromDate <= toDate &&
+        dateToEpoch(toDate) - dateToEpoch(fromDate) >= ROLLUP_MIN_DAYS * 86400UL) {
+      uint32_t rows = 0;
+      String tableHtml = rollupTableHtml(typeStr == "sens", fromDate, toDate, rows);
+      if (rows == 0) {
+        request->send(404, "text/html", "<p>Ni podatkov za izbrano obdobje.</p>");
+        return;
+      }
+      LOGI(LOG_MOD_WEB, "WEB: Request /history for %s to %s, type %s, %lu rollup rows", fromStr, toStr, typeStr, rows);
+      request->send(200, "text/html", tableHtml);
+      return;
+    }
+
+    // Make buffered samples visible to the readers
+    appenderSyncAll();
+
     // List files
-    const char* pattern = (typeStr == "sens") ? "history_sens_" : "fan_history_";
-    String files = listFiles(pattern, fromDate, toDate);
+    std::vector<String> files = listFiles(typeStr == "sens" ? MF_SENS : MF_FAN, fromDate, toDate);
 
-    if (files.length() == 0) {
-      request->send(404, "text/html", "<h1>Ni podatkov za izbrano obdobje</h1><a href='/'>Nazaj</a>");
+    if (files.empty()) {
+      request->send(404, "text/html", "<p>Ni podatkov za izbrano obdobje.</p>");
       return;
     }
 
-    // Collect all rows
-    std::vector<std::vector<String>> allRows;
-
-    // Parse files
-    int fileStart = 0;
-    while (fileStart < files.length()) {
-      int commaPos = files.indexOf(',', fileStart);
-      String fileName = (commaPos == -1) ? files.substring(fileStart) : files.substring(fileStart, commaPos);
-
-      if (fileName.length() > 0) {
-        String fileContent = readFile(fileName.c_str());
-        if (fileContent.length() > 0) {
-          // Parse CSV lines (skip header)
-          int lineStart = fileContent.indexOf('\n') + 1; // Skip header
-          while (lineStart < fileContent.length()) {
-            int lineEnd = fileContent.indexOf('\n', lineStart);
-            if (lineEnd == -1) lineEnd = fileContent.length();
-
-            String line = fileContent.substring(lineStart, lineEnd);
-            line.trim();
-
-            if (line.length() > 0) {
-              std::vector<String> row;
-              int colStart = 0;
-              while (colStart < line.length()) {
-                int commaPos = line.indexOf(',', colStart);
-                String col = (commaPos == -1) ? line.substring(colStart) : line.substring(colStart, commaPos);
-                row.push_back(col);
-                colStart = (commaPos == -1) ? line.length() : commaPos + 1;
-              }
-              if (row.size() >= (typeStr == "sens" ? 15 : 5)) { // Ensure we have all columns
-                allRows.push_back(row);
-              }
-            }
-
-            lineStart = lineEnd + 1;
+    if (typeStr == "sens") {
+      // Binary day files: read only the first MAX_ROWS records, count the rest from file sizes
+      String tableHtml = "<table><thead><tr><th>Čas</th><th>Ext Temp</th><th>Ext Hum</th><th>Ext Pres</th><th>Ext Lux</th><th>DS Temp</th><th>DS Hum</th><th>DS CO2</th><th>Kop Temp</th><th>Kop Hum</th><th>Kop Pres</th><th>Ut Temp</th><th>Ut Hum</th><th>Wc Pres</th><th>Rezerva</th></tr></thead><tbody>";
+      uint32_t totalRows = 0, shownRows = 0;
+      char cell[32];
+      for (const String& day : files) {
+        HistReader reader;
+        if (!histOpen(reader, day.c_str())) continue;
+        uint32_t before = shownRows;
+        HistRecord rec;
+        while (shownRows < MAX_ROWS && histNext(reader, rec)) {
+          histFormatTime(rec.ts, cell, sizeof(cell));
+          tableHtml += "<tr><td>" + String(cell) + "</td>";
+          for (uint8_t ch = 0; ch < HIST_CHANNELS; ch++) {
+            histFormatValue(rec, ch, cell, sizeof(cell));
+            tableHtml += "<td>" + String(cell) + "</td>";
           }
+          tableHtml += "</tr>";
+          shownRows++;
         }
+        totalRows += (shownRows - before) + (reader.count - reader.pos);
+        histClose(reader);
       }
 
-      fileStart = (commaPos == -1) ? files.length() : commaPos + 1;
-    }
+      if (totalRows == 0) {
+        request->send(404, "text/html", "<p>Ni podatkov za izbrano obdobje.</p>");
+        return;
+      }
 
-    if (allRows.size() == 0) {
-      request->send(404, "text/html", "<h1>Ni podatkov za izbrano obdobje</h1><a href='/'>Nazaj</a>");
+      tableHtml += "</tbody></table>";
+      if (totalRows > MAX_ROWS) {
+        tableHtml += "<div class=\"warning\">Prikaz omejen na " + String(MAX_ROWS) + " vrstic; za polne podatke uporabi izvoz.</div>";
+      }
+
+      LOGI(LOG_MOD_WEB, "WEB: Request /history for %s to %s, type %s, found %d rows", fromStr, toStr, typeStr, totalRows);
+
+      request->send(200, "text/html", tableHtml);
       return;
     }
 
-    // Sort by time (column 0) ascending
-    for (size_t i = 0; i < allRows.size(); i++) {
-      for (size_t j = i + 1; j < allRows.size(); j++) {
-        if (allRows[j][0] < allRows[i][0]) {
-          std::vector<String> temp = allRows[i];
-          allRows[i] = allRows[j];
-          allRows[j] = temp;
-        }
-      }
+    // Day files are time ordered; merge them and stop at MAX_ROWS
+    LineMerge merge;
+    mergeInit(merge, mergeCsvTimeKey);
+    for (const String& fileName : files) {
+      mergeAdd(merge, storage.open(fileName.c_str(), FILE_READ));
     }
 
     // Build HTML table
-    String tableHtml;
-    if (typeStr == "sens") {
-      tableHtml = "<table><thead><tr><th>Čas</th><th>Ext Temp</th><th>Ext Hum</th><th>Ext Pres</th><th>Ext Lux</th><th>DS Temp</th><th>DS Hum</th><th>DS CO2</th><th>Kop Temp</th><th>Kop Hum</th><th>Kop Pres</th><th>Ut Temp</th><th>Ut Hum</th><th>Wc Pres</th><th>Rezerva</th></tr></thead><tbody>";
-    } else {
-      tableHtml = "<table><thead><tr><th>Čas</th><th>Kop Fan</th><th>Ut Fan</th><th>Wc Fan</th><th>Common Intake</th></tr></thead><tbody>";
+    String tableHtml = "<table><thead><tr><th>Čas</th><th>Kop Fan</th><th>Ut Fan</th><th>Wc Fan</th><th>Common Intake</th></tr></thead><tbody>";
+
+    uint32_t rows = 0;
+    uint32_t ts;
+    const char* line;
+    while (rows < MAX_ROWS && (line = mergeNext(merge, ts)) != NULL) {
+      // Ensure we have all columns
+      int cols = 1;
+      for (const char* p = line; *p; p++) cols += (*p == ',');
+      if (cols < 5) continue;
+
+      tableHtml += "<tr><td>";
+      for (const char* p = line; *p; p++) {
+        if (*p == ',') tableHtml += "</td><td>";
+        else tableHtml += *p;
+      }
+      tableHtml += "</td></tr>";
+      rows++;
     }
+    bool truncated = rows == MAX_ROWS && mergeNext(merge, ts) != NULL;
+    mergeClose(merge);
 
-    int maxRows = allRows.size() > MAX_ROWS ? MAX_ROWS : allRows.size();
-
-    for (int i = 0; i < maxRows; i++) {
-      tableHtml += "<tr>";
-      for (size_t j = 0; j < allRows[i].size(); j++) {
-        tableHtml += "<td>" + allRows[i][j] + "</td>";
-      }
-      tableHtml += "</tr>";
+    if (rows == 0) {
+      request->send(404, "text/html", "<p>Ni podatkov za izbrano obdobje.</p>");
+      return;
     }
 
     tableHtml += "</tbody></table>";
 
-    if (allRows.size() > MAX_ROWS) {
+    if (truncated) {
       tableHtml += "<div class=\"warning\">Prikaz omejen na " + String(MAX_ROWS) + " vrstic; za polne podatke uporabi izvoz.</div>";
     }
 
-    logEvent("WEB: Request /history for " + fromStr + " to " + toStr + ", type " + typeStr + ", found " + String(allRows.size()) + " rows");
+    LOGI(LOG_MOD_WEB, "WEB: Request /history for %s to %s, type %s, found %lu%s rows", fromStr, toStr,
+         typeStr, rows, truncated ? "+" : "");
 
-    // Send response
-    char htmlBuffer[16384];
-    snprintf(htmlBuffer, sizeof(htmlBuffer), HTML_HISTORY_FORM, fromStr.c_str(), toStr.c_str(), tableHtml.c_str());
-    request->send(200, "text/html", htmlBuffer);
+    request->send(200, "text/html", tableHtml);
   });
 
   server.on("/history/download", HTTP_GET, [](AsyncWebServerRequest *request){
@@ -424,93 +453,17 @@ void setupWebEndpoints() {
     }
 
     // List files
-    const char* pattern = (typeStr == "sens") ? "history_sens_" : "fan_history_";
-    String files = listFiles(pattern, fromDate, toDate);
+    std::vector<String> files = listFiles(typeStr == "sens" ? MF_SENS : MF_FAN, fromDate, toDate);
 
-    if (files.length() == 0) {
+    if (files.empty()) {
       request->send(404, "text/plain", "Ni podatkov za izbrano obdobje");
       return;
     }
 
-    // Collect all rows
-    std::vector<std::vector<String>> allRows;
-
-    // Parse files
-    int fileStart = 0;
-    while (fileStart < files.length()) {
-      int commaPos = files.indexOf(',', fileStart);
-      String fileName = (commaPos == -1) ? files.substring(fileStart) : files.substring(fileStart, commaPos);
-
-      if (fileName.length() > 0) {
-        String fileContent = readFile(fileName.c_str());
-        if (fileContent.length() > 0) {
-          // Parse CSV lines (skip header)
-          int lineStart = fileContent.indexOf('\n') + 1; // Skip header
-          while (lineStart < fileContent.length()) {
-            int lineEnd = fileContent.indexOf('\n', lineStart);
-            if (lineEnd == -1) lineEnd = fileContent.length();
-
-            String line = fileContent.substring(lineStart, lineEnd);
-            line.trim();
-
-            if (line.length() > 0) {
-              std::vector<String> row;
-              int colStart = 0;
-              while (colStart < line.length()) {
-                int commaPos = line.indexOf(',', colStart);
-                String col = (commaPos == -1) ? line.substring(colStart) : line.substring(colStart, commaPos);
-                row.push_back(col);
-                colStart = (commaPos == -1) ? line.length() : commaPos + 1;
-              }
-              if (row.size() >= (typeStr == "sens" ? 15 : 5)) { // Ensure we have all columns
-                allRows.push_back(row);
-              }
-            }
-
-            lineStart = lineEnd + 1;
-          }
-        }
-      }
-
-      fileStart = (commaPos == -1) ? files.length() : commaPos + 1;
-    }
-
-    if (allRows.size() == 0) {
-      request->send(404, "text/plain", "Ni podatkov za izbrano obdobje");
-      return;
-    }
-
-    // Sort by time (column 0) ascending
-    for (size_t i = 0; i < allRows.size(); i++) {
-      for (size_t j = i + 1; j < allRows.size(); j++) {
-        if (allRows[j][0] < allRows[i][0]) {
-          std::vector<String> temp = allRows[i];
-          allRows[i] = allRows[j];
-          allRows[j] = temp;
-        }
-      }
-    }
-
-    // Build CSV content
-    String csvContent;
-    if (typeStr == "sens") {
-      csvContent = "Čas zapisa,Temperatura zunaj,Vlaga zunaj,Tlak zunaj,VOC zunaj,Svetloba zunaj,Temperatura DS,Vlaga DS,CO2 DS,Temperatura UT,Vlaga UT,Temperatura KOP,Vlaga KOP,Tlak WC,Vremenski code\n";
-    } else {
-      csvContent = "Čas zapisa,WC stanje,UT stanje,KOP stanje,DS stanje\n";
-    }
-
-    for (size_t i = 0; i < allRows.size(); i++) {
-      for (size_t j = 0; j < allRows[i].size(); j++) {
-        if (j > 0) csvContent += ",";
-        csvContent += allRows[i][j];
-      }
-      csvContent += "\n";
-    }
-
-    logEvent("WEB: Download /history/" + typeStr + " from " + fromStr + " to " + toStr + ", " + String(allRows.size()) + " rows");
+    LOGI(LOG_MOD_WEB, "WEB: Download /history/%s from %s to %s", typeStr, fromStr, toStr);
 
-    // Send CSV response
-    AsyncWebServerResponse *response = request->beginResponse(200, "text/csv", csvContent);
+    // Streamed as chunked CSV, one day file at a time
+    AsyncWebServerResponse *response = beginCsvExport(request, typeStr == "sens" ? EXPORT_SENS : EXPORT_FAN, fromDate, toDate);
     String filename = "history_" + typeStr + ".csv";
     String disposition = "attachment; filename=" + filename;
     response->addHeader("Content-Disposition", disposition.c_str());
@@ -564,97 +517,21 @@ void setupWebEndpoints() {
       from_unix = to_unix - 3600;
     }
 
-    // List log files for last 7 days
-    uint32_t sevenDaysAgo = myTZ.now() - (7 * 24 * 3600);
-    uint32_t today = myTZ.now();
-    String logFiles = listLogFiles(sevenDaysAgo, today);
-
-    // Parse log entries
-    struct LogEntry {
-      uint32_t unix_time;
-      String unit;
-      String message;
-    };
-
-    std::vector<LogEntry> entries;
-
-    // Split file list and read each file
-    int fileStart = 0;
-    while (fileStart < logFiles.length()) {
-      int commaPos = logFiles.indexOf(',', fileStart);
-      String fileName = (commaPos == -1) ? logFiles.substring(fileStart) : logFiles.substring(fileStart, commaPos);
-
-      if (fileName.length() > 0) {
-        String fileContent = readFile(fileName.c_str());
-        if (fileContent.length() > 0) {
-          // Parse lines
-          int lineStart = 0;
-          while (lineStart < fileContent.length()) {
-            int lineEnd = fileContent.indexOf('\n', lineStart);
-            if (lineEnd == -1) lineEnd = fileContent.length();
-
-            String line = fileContent.substring(lineStart, lineEnd);
-            line.trim();
-
-            if (line.length() > 0) {
-              // Parse unix|unit|message
-              int pipe1 = line.indexOf('|');
-              int pipe2 = line.indexOf('|', pipe1 + 1);
-
-              if (pipe1 > 0 && pipe2 > pipe1) {
-                String unixStr = line.substring(0, pipe1);
-                String unitStr = line.substring(pipe1 + 1, pipe2);
-                String msgStr = line.substring(pipe2 + 1);
-
-                uint32_t unix_time = unixStr.toInt();
-                if (unix_time >= from_unix && unix_time <= to_unix) {
-                  LogEntry entry;
-                  entry.unix_time = unix_time;
-                  entry.unit = unitStr;
-                  entry.message = msgStr;
-                  entries.push_back(entry);
-                }
-              }
-            }
-
-            lineStart = lineEnd + 1;
-          }
-        }
-      }
-
-      fileStart = (commaPos == -1) ? logFiles.length() : commaPos + 1;
-    }
+    LOGI(LOG_MOD_WEB, "WEB: Export /logs for %s %s", dateStr, timeStr);
 
-    if (entries.size() == 0) {
-      request->send(404, "text/plain", "Ni podatkov za izbrano obdobje");
-      return;
-    }
-
-    // Sort entries by unix_time descending
-    for (size_t i = 0; i < entries.size(); i++) {
-      for (size_t j = i + 1; j < entries.size(); j++) {
-        if (entries[j].unix_time > entries[i].unix_time) {
-          LogEntry temp = entries[i];
-          entries[i] = entries[j];
-          entries[j] = temp;
-        }
-      }
-    }
-
-    // Build CSV content
-    String csvContent = "Čas (lokalni),Unix čas,Enota,Sporočilo\n";
-
-    for (size_t i = 0; i < entries.size(); i++) {
-      LogEntry entry = entries[i];
-      String localTime = myTZ.dateTime(entry.unix_time, "H:i:s d.m.y");
-      csvContent += localTime + "," + String(entry.unix_time) + "," + entry.unit + "," + entry.message + "\n";
-    }
-
-    logEvent("WEB: Export /logs for " + dateStr + " " + timeStr + ", " + String(entries.size()) + " entries");
-
-    // Send CSV response
-    AsyncWebServerResponse *response = request->beginResponse(200, "text/csv", csvContent);
+    // Only the indexed bytes of the window are read, streamed as chunked CSV
+    AsyncWebServerResponse *response = beginCsvExport(request, EXPORT_LOGS, histDateOf(from_unix), histDateOf(to_unix + 3600), from_unix, to_unix);
     response->addHeader("Content-Disposition", "attachment; filename=logs.csv");
     request->send(response);
   });
-}
\ No newline at end of file
+
+  // Registered last: a handler also answers the paths below its own
+  // (/logs/rows, /logs/export) and the first registered match wins
+  server.on("/logs", HTTP_GET, [](AsyncWebServerRequest *request){
+    sendWebAsset(request, WEB_LOGS);
+  });
+
+  server.on("/history", HTTP_GET, [](AsyncWebServerRequest *request){
+    sendWebAsset(request, WEB_HISTORY);
+  });
+}
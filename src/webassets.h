@@ -0,0 +1,430 @@
+// webassets.h - Gzipped web page shells header
+// Generated by tools/webassets.py from web/*.html; edit those and rebuild
+#ifndef WEBASSETS_H
+#define WEBASSETS_H
+
+#include <Arduino.h>
+
+struct WebAsset {
+    const uint8_t* data;
+    size_t length;
+    const char* etag;           // quoted, as sent
+};
+
+// delete.html: 2980 bytes, 1196 gzipped
+static const uint8_t WEB_DELETE_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x56, 0xdb, 0x6e, 0xdb, 0x46,
+    0x10, 0x7d, 0xe7, 0x57, 0x6c, 0x19, 0xb4, 0x92, 0x90, 0x50, 0x17, 0x5f, 0x02, 0x43, 0xb7, 0xa0,
+    0xb1, 0x9d, 0x22, 0x40, 0x9b, 0x1a, 0xae, 0x8d, 0x22, 0x28, 0x8a, 0x62, 0xc4, 0x5d, 0x8a, 0x6b,
+    0x2f, 0x77, 0x99, 0xdd, 0xa5, 0x64, 0xb9, 0xf0, 0x27, 0xe4, 0x23, 0xf2, 0x23, 0x7d, 0x8a, 0xff,
+    0xab, 0xb3, 0x4b, 0xd2, 0xa2, 0x14, 0xd9, 0xf5, 0x53, 0xa3, 0x07, 0x9a, 0xcb, 0x99, 0x33, 0x67,
+    0xe6, 0xcc, 0xcc, 0x66, 0xfc, 0xdd, 0xc9, 0xaf, 0xc7, 0x17, 0x1f, 0xcf, 0x4e, 0x49, 0x6a, 0x33,
+    0x31, 0x0d, 0xc6, 0xee, 0x41, 0x04, 0xc8, 0xf9, 0x24, 0x34, 0x22, 0x74, 0x07, 0x0c, 0x28, 0x3e,
+    0x32, 0x66, 0x81, 0xc4, 0x29, 0x68, 0xc3, 0xec, 0x24, 0xbc, 0xbc, 0x78, 0x17, 0x1d, 0xb9, 0xaf,
+    0x96, 0x5b, 0xc1, 0xa6, 0xe7, 0xa7, 0xbf, 0x93, 0x88, 0xbc, 0xd5, 0xdc, 0x80, 0xbc, 0x62, 0xe3,
+    0x5e, 0x79, 0x1a, 0x8c, 0x8d, 0x5d, 0xb9, 0xe7, 0x4c, 0xd1, 0x15, 0xf9, 0x3b, 0x98, 0x41, 0x7c,
+    0x3d, 0xd7, 0xaa, 0x90, 0x74, 0x48, 0x5e, 0x0c, 0xfa, 0xee, 0x37, 0x0a, 0x62, 0x25, 0x94, 0xc6,
+    0x77, 0xd6, 0x77, 0xbf, 0x51, 0x90, 0x28, 0x69, 0xa3, 0x04, 0x32, 0x2e, 0x56, 0x43, 0x82, 0x70,
+    0x26, 0x32, 0x4c, 0xf3, 0x64, 0x14, 0x64, 0xa0, 0xe7, 0x5c, 0x0e, 0xc9, 0x5e, 0x3f, 0xbf, 0x19,
+    0x05, 0x77, 0x41, 0x3a, 0x40, 0xc8, 0xca, 0x7b, 0x99, 0x72, 0xcb, 0x46, 0x81, 0x65, 0x37, 0x36,
+    0x02, 0xc1, 0xe7, 0x68, 0x16, 0x33, 0x69, 0x99, 0x76, 0x86, 0x89, 0xd2, 0x19, 0x9a, 0x66, 0x70,
+    0x13, 0x2d, 0x39, 0xb5, 0xe9, 0x90, 0x1c, 0xf4, 0x3d, 0x46, 0x13, 0x91, 0x40, 0x61, 0xd5, 0x68,
+    0x8b, 0x22, 0xb8, 0xdf, 0x28, 0xc8, 0x81, 0x52, 0x2e, 0xe7, 0x75, 0xe8, 0x99, 0xd2, 0x94, 0xe9,
+    0x48, 0x03, 0xe5, 0x85, 0x19, 0x92, 0xa3, 0xf5, 0xd9, 0x90, 0x0c, 0x10, 0xc9, 0x28, 0xc1, 0x29,
+    0x79, 0xb1, 0xbf, 0xbf, 0xef, 0xa2, 0x0b, 0x98, 0x31, 0x81, 0xe1, 0x29, 0x37, 0xb9, 0x00, 0xcc,
+    0x69, 0x26, 0x54, 0x7c, 0x5d, 0x07, 0x8f, 0x66, 0xca, 0x5a, 0x95, 0xa1, 0xa3, 0x87, 0xf6, 0xc9,
+    0x2f, 0x19, 0x9f, 0xa7, 0x16, 0x0d, 0x95, 0xa0, 0x0e, 0x81, 0xcb, 0xbc, 0xb0, 0x7f, 0xd8, 0x55,
+    0xce, 0x26, 0x21, 0x05, 0xcb, 0xc2, 0x3f, 0x11, 0xae, 0xca, 0x64, 0xd0, 0xef, 0x7f, 0xdf, 0x20,
+    0x78, 0xb4, 0x4e, 0x6b, 0x8d, 0x7c, 0xe8, 0x09, 0x36, 0x13, 0xdb, 0x03, 0xf7, 0xdb, 0xc9, 0xfa,
+    0xf0, 0xf0, 0xf0, 0x9b, 0x0c, 0x0f, 0x1c, 0xc0, 0xb6, 0x4e, 0x9b, 0xbc, 0x4c, 0x31, 0xcb, 0xb8,
+    0xf5, 0xcc, 0x36, 0x22, 0x25, 0xc9, 0x01, 0xfe, 0x1b, 0x6d, 0xe9, 0x54, 0xc7, 0x95, 0x4a, 0xb2,
+    0x06, 0x7b, 0x57, 0x83, 0xdd, 0x35, 0xf6, 0x29, 0xc4, 0x85, 0x36, 0x0e, 0x24, 0x57, 0xbc, 0x94,
+    0x76, 0xa3, 0x06, 0xbb, 0xf9, 0x0c, 0x53, 0xb5, 0x60, 0x7a, 0x9b, 0x55, 0x1c, 0xef, 0x57, 0xea,
+    0x74, 0x63, 0x25, 0x13, 0xbe, 0xdd, 0x1f, 0x87, 0xff, 0x5b, 0x7f, 0xec, 0xee, 0xd8, 0xee, 0x12,
+    0xb4, 0x44, 0xc4, 0x75, 0x83, 0x63, 0x21, 0x01, 0xfa, 0xfd, 0x9d, 0x1d, 0xb2, 0xa5, 0x77, 0x3d,
+    0x1f, 0xdd, 0x59, 0x81, 0x07, 0xd2, 0x34, 0x7b, 0x2f, 0x11, 0x0c, 0xbf, 0xcd, 0x21, 0xaf, 0xcd,
+    0xae, 0x0a, 0x63, 0x79, 0xb2, 0x8a, 0xb0, 0x0c, 0x16, 0xc3, 0x6f, 0x90, 0x98, 0x59, 0x89, 0xbe,
+    0x8f, 0xab, 0x53, 0xeb, 0xf7, 0x2c, 0xad, 0x7c, 0xa2, 0x94, 0xc5, 0x4a, 0x83, 0xe5, 0x4a, 0xd6,
+    0xbe, 0x0f, 0xcc, 0xb8, 0x14, 0x5c, 0xb2, 0xa8, 0x1e, 0x0e, 0xcc, 0x67, 0xad, 0x6e, 0x9d, 0x8f,
+    0x95, 0xd1, 0x5a, 0xae, 0x67, 0xb4, 0xd9, 0xa6, 0xcf, 0x7f, 0xb6, 0x82, 0xb7, 0x05, 0x19, 0xfb,
+    0x71, 0xdd, 0x30, 0x3a, 0xa0, 0xf0, 0x3a, 0x49, 0x1e, 0x83, 0xf7, 0x2e, 0xbb, 0xd1, 0xf7, 0xe1,
+    0x08, 0xd8, 0x6b, 0x6f, 0x9a, 0x72, 0x4a, 0x99, 0x6c, 0x8a, 0x51, 0x56, 0xc0, 0xa1, 0xa0, 0x0b,
+    0x7e, 0xd8, 0xd5, 0x0b, 0x95, 0xb6, 0x56, 0xe5, 0x4d, 0x61, 0x9d, 0x3d, 0x34, 0x9a, 0xa3, 0xe6,
+    0xf7, 0x48, 0x91, 0x9f, 0x92, 0xb0, 0xd1, 0x90, 0x35, 0xca, 0x2e, 0x3d, 0x1f, 0xa2, 0xee, 0xce,
+    0x73, 0xab, 0x40, 0x0f, 0xcb, 0xfd, 0x2e, 0x18, 0xf7, 0xaa, 0x3b, 0x60, 0xdc, 0xab, 0x2e, 0x12,
+    0x77, 0x19, 0xb8, 0x6b, 0x65, 0x40, 0x38, 0x9d, 0x84, 0xfe, 0xa6, 0x08, 0xa7, 0xf5, 0xd5, 0x41,
+    0x8c, 0x05, 0xcd, 0x53, 0x82, 0x7b, 0x4e, 0x59, 0x76, 0x8d, 0x4e, 0x03, 0xb4, 0xf5, 0x1b, 0x1c,
+    0x2f, 0xa0, 0x54, 0xa1, 0xc7, 0x4f, 0xa7, 0x17, 0x21, 0x81, 0xd8, 0x25, 0x38, 0x09, 0x7b, 0x94,
+    0x09, 0x86, 0x2b, 0xd1, 0x63, 0x39, 0x33, 0x77, 0x27, 0x95, 0x2b, 0x17, 0xdf, 0x26, 0x61, 0x91,
+    0xff, 0x65, 0x55, 0x38, 0x3d, 0x53, 0x33, 0xcd, 0xef, 0xbf, 0x70, 0xb2, 0x30, 0x65, 0x08, 0x76,
+    0x75, 0xff, 0x85, 0x11, 0x45, 0x5d, 0xa0, 0x22, 0x83, 0xe1, 0xb8, 0xe7, 0x9d, 0xd0, 0xd9, 0x6f,
+    0x11, 0xd2, 0xd8, 0xb6, 0x1e, 0xba, 0xc4, 0x21, 0x12, 0x32, 0xf6, 0xf0, 0xa2, 0xd9, 0xa7, 0x82,
+    0x6b, 0x46, 0xb7, 0x9c, 0xaa, 0xd5, 0x43, 0x16, 0x20, 0x0a, 0x7c, 0xad, 0x33, 0x73, 0xc4, 0x7a,
+    0x8e, 0x21, 0x3e, 0x29, 0x5f, 0x90, 0x58, 0x80, 0x31, 0x93, 0xb0, 0x6e, 0xe8, 0xb2, 0x3d, 0xca,
+    0x60, 0xd5, 0x59, 0xb8, 0x69, 0x59, 0xed, 0x84, 0x70, 0xfa, 0xa3, 0xe0, 0x18, 0xdb, 0x90, 0xfb,
+    0x7f, 0x98, 0xc0, 0x46, 0x24, 0xfc, 0x76, 0xe6, 0x62, 0xd8, 0x32, 0xbb, 0xaa, 0x72, 0x5b, 0x69,
+    0x8e, 0x4d, 0x0e, 0xb2, 0xca, 0xe4, 0x02, 0x0b, 0x82, 0xb2, 0xe0, 0xc1, 0xf4, 0xcd, 0xb8, 0x87,
+    0x11, 0x36, 0xe3, 0x54, 0x6b, 0xc3, 0x45, 0x07, 0x92, 0x6a, 0x96, 0x34, 0xaa, 0x5c, 0x9b, 0xe0,
+    0x66, 0x68, 0x4c, 0x56, 0xc9, 0x7a, 0xc5, 0xd0, 0xe7, 0x04, 0x5e, 0x95, 0x7c, 0xb0, 0xd8, 0xe3,
+    0x1e, 0x3c, 0x07, 0xc3, 0x8f, 0x0f, 0x4a, 0xa4, 0xd9, 0xb5, 0xe0, 0x5f, 0x3f, 0x57, 0x6e, 0x15,
+    0xaf, 0x1d, 0xf4, 0xb0, 0xef, 0x36, 0xb8, 0x85, 0xd3, 0x0f, 0x70, 0x0b, 0x57, 0xa8, 0x0d, 0xb9,
+    0x85, 0xaf, 0x9f, 0x99, 0x95, 0x0a, 0x73, 0xd7, 0x20, 0x37, 0x80, 0x4c, 0xac, 0x79, 0x6e, 0xa7,
+    0x41, 0xaf, 0x47, 0x2e, 0x52, 0xe6, 0x9a, 0x23, 0x7b, 0x45, 0x94, 0x26, 0x4b, 0x6e, 0x53, 0xe2,
+    0x05, 0x25, 0x16, 0xcf, 0xab, 0x8c, 0xfc, 0xf8, 0xe0, 0x01, 0x58, 0x62, 0x98, 0xa4, 0xa6, 0x3e,
+    0x9f, 0x60, 0x92, 0x41, 0x3b, 0x29, 0xa4, 0x6f, 0xbf, 0x76, 0x07, 0xe7, 0x60, 0x01, 0x9a, 0xb8,
+    0x9a, 0x92, 0x09, 0x91, 0x6c, 0x49, 0x2e, 0xcf, 0x7f, 0xfe, 0x8d, 0x81, 0x8e, 0xd3, 0x33, 0xd0,
+    0x90, 0x99, 0x36, 0xee, 0x33, 0x0f, 0xd6, 0x35, 0xfe, 0xb4, 0xd3, 0x9d, 0x33, 0xdb, 0x6e, 0xf9,
+    0x80, 0xad, 0xce, 0x28, 0xe0, 0x09, 0x69, 0x3b, 0x6f, 0x87, 0x44, 0x55, 0x5c, 0x64, 0x38, 0xf7,
+    0xce, 0xe4, 0x54, 0x30, 0xf7, 0xe7, 0xdb, 0xd5, 0x7b, 0xda, 0x6e, 0xf9, 0x19, 0x69, 0x75, 0xba,
+    0x6e, 0xbc, 0x8f, 0xcb, 0x45, 0x8d, 0xd1, 0x5a, 0x67, 0xca, 0x6a, 0x8a, 0x0d, 0xb0, 0x20, 0xb3,
+    0xb2, 0xc7, 0xa0, 0x35, 0x7a, 0x1c, 0xc4, 0x65, 0x8c, 0x18, 0xbe, 0x8a, 0x1f, 0xb0, 0x8d, 0x1d,
+    0x42, 0xd9, 0x74, 0x4f, 0x79, 0x55, 0x79, 0x6f, 0x3b, 0xd6, 0xc7, 0x4f, 0x78, 0xba, 0xac, 0xbe,
+    0xe1, 0xec, 0x0e, 0x9f, 0xf0, 0xc1, 0xea, 0xa2, 0x8b, 0xd3, 0xd5, 0x05, 0xa9, 0x3a, 0xe6, 0x8d,
+    0x2f, 0xd6, 0xa4, 0x45, 0x5e, 0x12, 0x26, 0x63, 0x45, 0xd9, 0xe5, 0xf9, 0xfb, 0x63, 0x95, 0xe5,
+    0xb8, 0xda, 0xa4, 0xad, 0x8a, 0xf7, 0x92, 0xb4, 0x7e, 0x68, 0x48, 0x84, 0xbc, 0xee, 0x08, 0x13,
+    0x38, 0x0d, 0xa5, 0x3e, 0xb4, 0x12, 0xe7, 0x04, 0xe7, 0xb9, 0xdd, 0x79, 0x92, 0xb4, 0xd7, 0xa5,
+    0xeb, 0x67, 0x17, 0x9d, 0xa8, 0xb3, 0x78, 0x57, 0x08, 0xf1, 0x11, 0xd5, 0x6b, 0xfb, 0x38, 0x91,
+    0x23, 0xd2, 0x6e, 0xf5, 0xfd, 0xc3, 0x7f, 0xff, 0x05, 0xd3, 0x4b, 0xfd, 0xc7, 0x41, 0xa7, 0xd3,
+    0x35, 0x82, 0xc7, 0xac, 0x1d, 0xed, 0x3d, 0x18, 0x07, 0x95, 0xb1, 0xb7, 0x2d, 0x19, 0x34, 0xac,
+    0xdc, 0x8e, 0xbc, 0xeb, 0x38, 0x52, 0x38, 0x92, 0x55, 0x8f, 0x8e, 0x7b, 0xd5, 0x8e, 0xec, 0x95,
+    0xff, 0x27, 0xff, 0x17, 0x5c, 0x69, 0xd1, 0x84, 0xa4, 0x0b, 0x00, 0x00,
+};
+static const WebAsset WEB_DELETE = {WEB_DELETE_GZ, sizeof(WEB_DELETE_GZ), "\"069e3b94b51a5f29\""};
+
+// help.html: 1282 bytes, 702 gzipped
+static const uint8_t WEB_HELP_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x6d, 0x54, 0xdb, 0x8e, 0xd3, 0x48,
+    0x10, 0x7d, 0xf7, 0x57, 0xd4, 0x06, 0x09, 0x31, 0x0f, 0x8e, 0x93, 0x5d, 0x40, 0xc8, 0xb9, 0x20,
+    0xc1, 0x82, 0x84, 0x84, 0x60, 0xb4, 0xc0, 0x22, 0x1e, 0xdb, 0xe9, 0x8a, 0xdd, 0x33, 0xed, 0xae,
+    0xa8, 0xbb, 0xec, 0x99, 0x04, 0xf1, 0x09, 0x7c, 0x04, 0xff, 0xc2, 0xfe, 0x17, 0x55, 0x4e, 0x42,
+    0x76, 0x46, 0x91, 0x25, 0x77, 0x77, 0x5d, 0xce, 0xa9, 0x3e, 0x55, 0xf6, 0xfc, 0x8f, 0xbf, 0xdf,
+    0xbf, 0xfc, 0xf8, 0xe5, 0xf2, 0x15, 0x34, 0xdc, 0xfa, 0x65, 0x36, 0xd7, 0x05, 0xbc, 0x09, 0xf5,
+    0x62, 0x94, 0xfc, 0x48, 0x0d, 0x68, 0xac, 0x2c, 0x2d, 0xb2, 0x81, 0x55, 0x63, 0x62, 0x42, 0x5e,
+    0x8c, 0x3e, 0x7d, 0x7c, 0x9d, 0x3f, 0x53, 0x2f, 0x3b, 0xf6, 0xb8, 0xfc, 0xe7, 0xd5, 0x67, 0xc8,
+    0xe1, 0x92, 0x5a, 0xfa, 0xf9, 0x7d, 0x5e, 0xec, 0x6d, 0xd9, 0x3c, 0xf1, 0x56, 0xd7, 0x8a, 0xec,
+    0x16, 0xbe, 0x66, 0x95, 0x59, 0x5d, 0xd7, 0x91, 0xba, 0x60, 0x4b, 0x78, 0x30, 0x9d, 0xe8, 0x33,
+    0xcb, 0x56, 0xe4, 0x29, 0xca, 0x19, 0x27, 0xfa, 0xcc, 0xb2, 0x35, 0x05, 0xce, 0xd7, 0xa6, 0x75,
+    0x7e, 0x5b, 0x42, 0x32, 0x21, 0xe5, 0x09, 0xa3, 0x5b, 0xcf, 0xb2, 0xd6, 0xc4, 0xda, 0x85, 0x12,
+    0xfe, 0x9c, 0x6c, 0x6e, 0xf5, 0x74, 0x9b, 0xdf, 0x38, 0xcb, 0x4d, 0x09, 0xcf, 0x26, 0x07, 0xcb,
+    0xc9, 0x0f, 0xa6, 0x63, 0x9a, 0x65, 0xdf, 0xb2, 0x66, 0x2a, 0xbc, 0x07, 0x8a, 0x9b, 0xc6, 0x31,
+    0xce, 0x32, 0xc6, 0x5b, 0xce, 0x8d, 0x77, 0xb5, 0xc4, 0xae, 0x30, 0x30, 0x46, 0x0d, 0xec, 0xbc,
+    0x04, 0x7a, 0x17, 0x30, 0x6f, 0xd0, 0xd5, 0x0d, 0x97, 0x30, 0x1d, 0x3f, 0x55, 0x87, 0x77, 0xe2,
+    0x38, 0x62, 0x4f, 0x15, 0x7b, 0xa2, 0x66, 0x73, 0xc2, 0x7d, 0xf0, 0xd8, 0x9a, 0xa7, 0xeb, 0xb5,
+    0x5a, 0xc7, 0x7a, 0x45, 0xf1, 0x9c, 0xe3, 0xd8, 0x63, 0xe4, 0x4c, 0x9b, 0x12, 0xfe, 0x1a, 0x2a,
+    0x3e, 0xc6, 0x9f, 0xc3, 0x1a, 0x10, 0x2c, 0xae, 0x28, 0x1a, 0x76, 0x24, 0x30, 0x81, 0x82, 0x14,
+    0xbf, 0x31, 0xd6, 0xba, 0x50, 0x1f, 0x2a, 0xd9, 0x4b, 0x51, 0x51, 0xb4, 0x28, 0xb9, 0x53, 0xb1,
+    0x24, 0xf2, 0xce, 0x9e, 0x50, 0xf6, 0xae, 0x3c, 0x1a, 0xeb, 0xba, 0x54, 0xc2, 0x93, 0x3b, 0xac,
+    0x65, 0x43, 0x3d, 0xc6, 0xfb, 0x7d, 0x39, 0xa6, 0x1e, 0x0b, 0x3a, 0xf6, 0xe9, 0x5b, 0x36, 0x2f,
+    0x0e, 0xed, 0x9c, 0x17, 0x87, 0x89, 0xd0, 0xbe, 0xea, 0x7c, 0x4c, 0x97, 0xfb, 0xc6, 0xcb, 0x04,
+    0xe8, 0x1c, 0x7c, 0xc6, 0x0a, 0xfa, 0x16, 0x53, 0x70, 0xd7, 0x12, 0x3a, 0x95, 0x88, 0x4e, 0xe7,
+    0xca, 0xbb, 0xa5, 0x0c, 0x44, 0xa4, 0x50, 0x2f, 0x2f, 0x23, 0xd6, 0x1e, 0x2d, 0xec, 0x6a, 0xb2,
+    0xd4, 0x8b, 0xea, 0xa5, 0x82, 0x0f, 0x2e, 0x78, 0x67, 0xa0, 0x68, 0x5c, 0x62, 0x8a, 0x5b, 0x70,
+    0xbb, 0x4a, 0x9a, 0x0f, 0xeb, 0x48, 0x6d, 0xc1, 0x04, 0x2e, 0x00, 0x6f, 0x37, 0x08, 0x8f, 0x12,
+    0x86, 0x54, 0xf4, 0x22, 0x6c, 0x61, 0xbc, 0xbf, 0x80, 0x9d, 0x01, 0x36, 0x95, 0x47, 0x10, 0xfb,
+    0x8e, 0xe2, 0x15, 0xf6, 0x83, 0xd3, 0x79, 0xc3, 0xc3, 0x69, 0x3c, 0x2f, 0x84, 0xfc, 0x4e, 0x05,
+    0x6f, 0x76, 0x3d, 0xed, 0xfe, 0xc7, 0xfa, 0x69, 0x23, 0x4a, 0x57, 0xee, 0x37, 0x75, 0x61, 0xe9,
+    0x26, 0x78, 0x32, 0xf6, 0xb9, 0x32, 0x2e, 0x94, 0xf0, 0xa1, 0x96, 0xb1, 0x18, 0x8f, 0xc7, 0x0f,
+    0x99, 0x74, 0x51, 0xda, 0x97, 0x1f, 0xfe, 0x3d, 0x91, 0xc2, 0xa3, 0x8d, 0x5c, 0xa7, 0x0a, 0xa4,
+    0x1e, 0x2d, 0xe0, 0x62, 0xa6, 0x3b, 0x4f, 0x35, 0x42, 0x21, 0xef, 0x54, 0xe0, 0xad, 0xd0, 0xf0,
+    0x73, 0x6b, 0x18, 0xf7, 0x40, 0xae, 0x1d, 0x36, 0x70, 0xa6, 0xc2, 0xa3, 0x46, 0x92, 0x48, 0xfd,
+    0x3d, 0x7d, 0x14, 0xec, 0x28, 0x8e, 0x80, 0x75, 0xad, 0x4a, 0xd3, 0xc5, 0x81, 0x78, 0x9a, 0x77,
+    0x51, 0x4a, 0xa0, 0x6b, 0x79, 0x0d, 0xb9, 0x67, 0xb0, 0x5f, 0x44, 0x27, 0x9f, 0xd6, 0xd5, 0x7d,
+    0xd9, 0x2d, 0x7a, 0x64, 0xfc, 0x0d, 0x4c, 0xf9, 0x80, 0x6d, 0x14, 0xb5, 0x3a, 0x64, 0x40, 0x62,
+    0x13, 0xf1, 0xea, 0xbf, 0x1f, 0xae, 0x51, 0x66, 0x62, 0xbc, 0xd6, 0x6b, 0x73, 0xb4, 0xee, 0xe2,
+    0x0c, 0xd1, 0x5b, 0xd7, 0x0f, 0x29, 0x2c, 0xe3, 0x77, 0x87, 0x2b, 0x12, 0xb1, 0x38, 0xa2, 0x09,
+    0x0e, 0x7a, 0x67, 0x1d, 0x70, 0xc4, 0xd0, 0x71, 0x40, 0xe8, 0x23, 0xda, 0x40, 0x89, 0xdd, 0x49,
+    0xd8, 0x23, 0x70, 0x31, 0xcc, 0x91, 0x75, 0x3d, 0xac, 0xbc, 0x49, 0x69, 0x31, 0xd2, 0xc9, 0xd5,
+    0x7f, 0x90, 0x81, 0x26, 0xe2, 0x7a, 0x31, 0x2a, 0x46, 0xcb, 0x77, 0x66, 0x67, 0xae, 0x20, 0x68,
+    0xd1, 0x3f, 0xbf, 0x23, 0x8b, 0x08, 0x03, 0xcb, 0xbc, 0x30, 0x0a, 0x20, 0xb9, 0xba, 0x1c, 0x06,
+    0xb7, 0xd8, 0xff, 0xf1, 0x7e, 0x01, 0x9e, 0x5a, 0xca, 0xc0, 0x02, 0x05, 0x00, 0x00,
+};
+static const WebAsset WEB_HELP = {WEB_HELP_GZ, sizeof(WEB_HELP_GZ), "\"2192a43e950ecf87\""};
+
+// history.html: 3062 bytes, 1304 gzipped
+static const uint8_t WEB_HISTORY_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xbd, 0x56, 0xdb, 0x72, 0xdb, 0x36,
+    0x10, 0x7d, 0xe7, 0x57, 0xa0, 0xcc, 0x74, 0x24, 0x4d, 0x4b, 0x52, 0xb2, 0x63, 0xd7, 0xa3, 0xdb,
+    0x43, 0x1b, 0x27, 0xed, 0x4c, 0xd2, 0x64, 0x12, 0xa5, 0x9d, 0x34, 0x93, 0x87, 0x15, 0x01, 0x8a,
+    0x88, 0x41, 0x42, 0x01, 0x40, 0x29, 0x72, 0xe3, 0x4f, 0xe8, 0x2f, 0xf5, 0xa9, 0xfd, 0xaf, 0xee,
+    0x82, 0xa4, 0x6e, 0x96, 0x27, 0x6f, 0x35, 0x3d, 0xa2, 0xb4, 0xd8, 0x3d, 0x7b, 0x3b, 0xbb, 0xe4,
+    0xf8, 0x9b, 0x27, 0x2f, 0x7f, 0x9a, 0xbd, 0x7b, 0x75, 0xcd, 0x72, 0x57, 0xa8, 0x69, 0x30, 0xa6,
+    0x1b, 0x53, 0x50, 0x2e, 0x26, 0xa1, 0x55, 0x21, 0x09, 0x04, 0x70, 0xbc, 0x15, 0xc2, 0x01, 0x4b,
+    0x73, 0x30, 0x56, 0xb8, 0x49, 0xf8, 0x76, 0xf6, 0x34, 0xba, 0xa2, 0x53, 0x27, 0x9d, 0x12, 0xd3,
+    0xd7, 0xd7, 0xbf, 0xb3, 0x88, 0xfd, 0xb1, 0xd0, 0x5c, 0xaf, 0x64, 0x09, 0xe3, 0xa4, 0x16, 0x07,
+    0x63, 0xeb, 0x36, 0x74, 0x9f, 0x6b, 0xbe, 0x61, 0x7f, 0x06, 0x73, 0x48, 0x6f, 0x16, 0x46, 0x57,
+    0x25, 0x1f, 0xb2, 0x47, 0x83, 0x3e, 0x5d, 0xa3, 0x20, 0xd5, 0x4a, 0x1b, 0xfc, 0x2d, 0xfa, 0x74,
+    0x8d, 0x82, 0x4c, 0x97, 0x2e, 0xca, 0xa0, 0x90, 0x6a, 0x33, 0x64, 0x16, 0x4a, 0x1b, 0x59, 0x61,
+    0x64, 0x36, 0x0a, 0x0a, 0x30, 0x0b, 0x59, 0x0e, 0xd9, 0x59, 0x7f, 0xf9, 0x79, 0x14, 0xdc, 0x05,
+    0xf9, 0x00, 0x21, 0x1b, 0xeb, 0x75, 0x2e, 0x9d, 0x18, 0x05, 0x4e, 0x7c, 0x76, 0x11, 0x28, 0xb9,
+    0x40, 0xb5, 0x54, 0x94, 0x4e, 0x18, 0x52, 0xcc, 0xb4, 0x29, 0x50, 0xb5, 0x80, 0xcf, 0xd1, 0x5a,
+    0x72, 0x97, 0x0f, 0xd9, 0x0f, 0x7d, 0x8f, 0xb1, 0x8f, 0xc8, 0xa0, 0x72, 0x7a, 0x74, 0x14, 0x22,
+    0xd0, 0x35, 0x0a, 0x96, 0xc0, 0xb9, 0x2c, 0x17, 0xad, 0xeb, 0xb9, 0x36, 0x5c, 0x98, 0xc8, 0x00,
+    0x97, 0x95, 0x1d, 0xb2, 0xab, 0x9d, 0x6c, 0xc8, 0x06, 0x88, 0x64, 0xb5, 0x92, 0x9c, 0x3d, 0x3a,
+    0x3f, 0x3f, 0x27, 0xef, 0x31, 0xb9, 0x8f, 0x8c, 0x5e, 0x63, 0x08, 0x5c, 0xda, 0xa5, 0x02, 0xcc,
+    0x2b, 0x53, 0x02, 0x8d, 0x16, 0xb0, 0x6c, 0x31, 0xeb, 0x50, 0xa2, 0xb9, 0x76, 0x4e, 0x17, 0x08,
+    0x73, 0x41, 0x42, 0x9f, 0x49, 0x84, 0x99, 0x15, 0x76, 0x97, 0x0f, 0x99, 0x46, 0x6b, 0x43, 0xa6,
+    0xf4, 0x49, 0x2e, 0x14, 0xcc, 0x85, 0xa2, 0x0c, 0x11, 0xa1, 0xc9, 0xf0, 0xb2, 0x29, 0x92, 0x2c,
+    0x97, 0x95, 0x7b, 0xef, 0x36, 0x4b, 0x31, 0x09, 0x39, 0x38, 0x11, 0x7e, 0x40, 0xbd, 0x6d, 0x3e,
+    0x75, 0xe8, 0xfb, 0x29, 0x9f, 0x01, 0x5d, 0x27, 0xf3, 0xb9, 0xb8, 0xb8, 0xb8, 0x97, 0xfb, 0x63,
+    0x02, 0x38, 0xee, 0xe0, 0x5d, 0x60, 0x85, 0x12, 0xa9, 0xfb, 0x3f, 0x3c, 0xed, 0xe7, 0x67, 0xab,
+    0x79, 0x21, 0x9d, 0xcf, 0xf0, 0xc0, 0xd3, 0x63, 0x0e, 0x97, 0x59, 0x36, 0x3a, 0xe2, 0x4a, 0xeb,
+    0xb7, 0xd4, 0xa5, 0xd8, 0x6b, 0xf1, 0x80, 0xb8, 0x70, 0xb2, 0xcf, 0xbe, 0x25, 0x69, 0x65, 0x2c,
+    0x81, 0x2c, 0xb5, 0x6c, 0xe9, 0x75, 0x2a, 0x84, 0x61, 0xae, 0x57, 0xc2, 0x1c, 0x07, 0x72, 0x0e,
+    0x57, 0x20, 0x2e, 0x3d, 0x29, 0x52, 0x64, 0x39, 0x36, 0xd4, 0xd3, 0xd2, 0x77, 0xde, 0xe9, 0xe5,
+    0x8e, 0xda, 0x0e, 0xe6, 0x4a, 0xe0, 0x59, 0xd3, 0xcc, 0x41, 0xbf, 0xff, 0xed, 0x36, 0x1c, 0xcc,
+    0x42, 0xc1, 0xd2, 0x0a, 0x64, 0x44, 0xf3, 0xed, 0x01, 0xd6, 0x3e, 0x44, 0xc9, 0x23, 0xaa, 0x6d,
+    0x7d, 0xe6, 0xdf, 0x33, 0xc7, 0xf7, 0x7b, 0x76, 0x49, 0x07, 0xfb, 0x23, 0xa5, 0x44, 0xe6, 0x1e,
+    0xc6, 0xf5, 0x83, 0x6b, 0xe5, 0x2d, 0x46, 0x36, 0x38, 0x6b, 0x31, 0x8f, 0x4b, 0xd0, 0x76, 0xfd,
+    0xb0, 0x17, 0xde, 0x74, 0x2d, 0xe4, 0x22, 0x77, 0x43, 0x36, 0xd7, 0x8a, 0xfb, 0x1a, 0xd9, 0xd4,
+    0x50, 0x86, 0x75, 0x29, 0xa8, 0x9e, 0x99, 0xd2, 0xeb, 0x08, 0xa7, 0xa7, 0x1e, 0x55, 0x9a, 0xe7,
+    0xbc, 0xb1, 0xb9, 0xea, 0xaf, 0x72, 0x6f, 0xb3, 0x06, 0x53, 0x62, 0xf0, 0xbb, 0xcd, 0xf0, 0x28,
+    0xcb, 0x00, 0xfa, 0xed, 0x5e, 0xf1, 0xfb, 0x68, 0xc8, 0xa4, 0xc3, 0x8c, 0xd2, 0xdd, 0x02, 0xf0,
+    0x4d, 0xf7, 0x7c, 0x8a, 0x7d, 0xe9, 0x23, 0xbf, 0xbf, 0x10, 0x64, 0x3f, 0x27, 0x5f, 0x8e, 0x13,
+    0x91, 0x6e, 0x41, 0x2e, 0x08, 0x84, 0x5d, 0xd4, 0x50, 0x87, 0x09, 0x22, 0x30, 0x95, 0x01, 0x11,
+    0x4f, 0xad, 0xa8, 0x53, 0x14, 0xa8, 0xf5, 0x61, 0x2f, 0x91, 0x96, 0xc6, 0x1e, 0x81, 0x8b, 0x54,
+    0x1b, 0x70, 0x52, 0x97, 0x5f, 0x67, 0xf0, 0x41, 0xab, 0x5a, 0x94, 0x53, 0xe4, 0xde, 0x7a, 0x3d,
+    0x4d, 0xdf, 0xa3, 0x39, 0xda, 0x6e, 0xf0, 0xbb, 0x60, 0x9c, 0x34, 0x8b, 0x7e, 0x9c, 0x34, 0x8f,
+    0x0b, 0xda, 0xf8, 0xf4, 0xf0, 0x18, 0x4c, 0xb7, 0x4f, 0x05, 0x9c, 0x19, 0xdc, 0x40, 0x37, 0x7a,
+    0x85, 0x4a, 0x03, 0x3c, 0xf3, 0x6b, 0x19, 0x1f, 0x2b, 0xb9, 0xe6, 0x93, 0xf0, 0xd9, 0xf5, 0x2c,
+    0x64, 0x90, 0x52, 0x42, 0x93, 0x30, 0xc9, 0xa5, 0x75, 0xda, 0x6c, 0xe8, 0x01, 0xc3, 0xe5, 0x8a,
+    0xa5, 0x0a, 0xac, 0x9d, 0x84, 0xed, 0x22, 0x25, 0x71, 0xbd, 0xf2, 0x50, 0x82, 0x62, 0xa3, 0x8b,
+    0x70, 0xfa, 0x92, 0x0f, 0xc7, 0x89, 0x97, 0xe2, 0xa9, 0x1f, 0x49, 0xb6, 0xb7, 0xf5, 0x98, 0xe4,
+    0x8d, 0x22, 0x2b, 0xa1, 0x10, 0xed, 0x77, 0x23, 0x3e, 0x55, 0xd2, 0x08, 0x7e, 0x08, 0xe8, 0x74,
+    0x38, 0x7d, 0xa2, 0xbf, 0x0a, 0x87, 0x6a, 0x0d, 0x18, 0x7d, 0x7b, 0x00, 0x0a, 0x6d, 0xc2, 0xe9,
+    0x4c, 0x2e, 0xf7, 0xd0, 0x9a, 0xe5, 0xe8, 0x21, 0xe8, 0xb8, 0x05, 0xf1, 0xaa, 0xc1, 0x58, 0x2f,
+    0xa9, 0x08, 0x6c, 0x05, 0xaa, 0x42, 0x29, 0x28, 0x7c, 0x08, 0xff, 0x66, 0xc5, 0x38, 0xa9, 0xe5,
+    0xf7, 0x14, 0xac, 0x28, 0x6d, 0x38, 0x7d, 0x23, 0xca, 0x5b, 0x6d, 0x3e, 0xca, 0x07, 0xd5, 0x56,
+    0x48, 0x35, 0x04, 0xc2, 0x4f, 0xa9, 0xc0, 0x1d, 0xa9, 0x26, 0x75, 0x48, 0x47, 0x99, 0x36, 0xbb,
+    0xac, 0x45, 0x78, 0x65, 0xe4, 0x0d, 0xfc, 0xfb, 0xb7, 0xa4, 0x18, 0x13, 0xec, 0x0a, 0xdd, 0xa8,
+    0x23, 0x87, 0x3d, 0x6a, 0xf6, 0x5a, 0xdb, 0x39, 0x4f, 0x8b, 0x49, 0x78, 0x6f, 0x78, 0xd9, 0xc1,
+    0xe0, 0xd6, 0xf5, 0xc4, 0xce, 0x62, 0x26, 0xbf, 0x82, 0x82, 0x05, 0x94, 0x1f, 0x45, 0x1c, 0xc7,
+    0x5b, 0x3f, 0xf5, 0x6d, 0xcf, 0x0d, 0xf1, 0x92, 0x7c, 0x00, 0xcb, 0x8d, 0xc8, 0x90, 0x31, 0x64,
+    0x78, 0x0b, 0x1f, 0xb1, 0x96, 0xec, 0x16, 0xfe, 0xf9, 0x4b, 0xb8, 0x52, 0xa3, 0x73, 0x03, 0xe5,
+    0x38, 0x81, 0x1d, 0x02, 0x6e, 0x14, 0xb9, 0xc4, 0x3c, 0x93, 0x84, 0xcd, 0x72, 0xc1, 0x96, 0xb0,
+    0x10, 0x4c, 0x5a, 0x96, 0x42, 0x9a, 0x0b, 0x64, 0xb8, 0x43, 0x99, 0x67, 0xa5, 0x83, 0x1b, 0x61,
+    0x71, 0x4b, 0xd8, 0x3a, 0x79, 0xcb, 0xfc, 0x58, 0x10, 0x67, 0xbc, 0xce, 0xa7, 0x4a, 0x98, 0x0d,
+    0x81, 0x74, 0x37, 0xc2, 0xe2, 0x04, 0x73, 0xd8, 0x30, 0xa7, 0xf1, 0x9f, 0xbe, 0xcc, 0x37, 0x8c,
+    0x8b, 0x0c, 0x2a, 0xe5, 0x7a, 0x0c, 0x4a, 0xee, 0x0d, 0xea, 0x7d, 0x9e, 0xea, 0x02, 0xa1, 0x3c,
+    0x4a, 0xcb, 0xf0, 0x84, 0x92, 0x0e, 0xba, 0x59, 0x55, 0x7a, 0xea, 0x77, 0x7b, 0x38, 0x73, 0x2b,
+    0x30, 0x0c, 0x17, 0x82, 0x65, 0x13, 0x56, 0x8a, 0x35, 0x7b, 0xfb, 0xfa, 0xf9, 0x1b, 0x01, 0x26,
+    0xcd, 0x5f, 0x81, 0x81, 0xc2, 0x76, 0x95, 0x4e, 0xfd, 0xdc, 0xc7, 0xd6, 0x4b, 0x7b, 0x23, 0x6f,
+    0xe0, 0xc3, 0x9e, 0x30, 0xae, 0xd3, 0xaa, 0xc0, 0xfa, 0xfb, 0x97, 0x0e, 0xfb, 0xbe, 0xff, 0x01,
+    0x37, 0x56, 0x83, 0xcd, 0x30, 0xb8, 0x2e, 0x27, 0x07, 0x46, 0xb8, 0xca, 0xe0, 0xef, 0x78, 0x21,
+    0xdc, 0xd3, 0x4a, 0xa9, 0x77, 0x08, 0x84, 0x9e, 0xbf, 0x63, 0x9d, 0xa8, 0x83, 0x9f, 0xdd, 0x4e,
+    0xdf, 0xdf, 0xfc, 0xf9, 0x0b, 0xec, 0x67, 0xee, 0x0f, 0x07, 0xbd, 0x5e, 0x6c, 0x71, 0x6b, 0x8a,
+    0x6e, 0x74, 0x76, 0x4f, 0xd9, 0xeb, 0x3e, 0xc1, 0xd1, 0xe8, 0xee, 0x6b, 0xd1, 0x6a, 0xa0, 0xe0,
+    0x4a, 0x7c, 0xf9, 0xa9, 0x93, 0xa9, 0x55, 0x46, 0xfe, 0x95, 0x2c, 0x46, 0xd2, 0x51, 0xac, 0x36,
+    0xa6, 0x92, 0xc4, 0xbe, 0xd2, 0xa8, 0x46, 0xa9, 0x13, 0x5a, 0xb7, 0x43, 0xe2, 0x4e, 0x8f, 0x7d,
+    0xf9, 0xe2, 0x43, 0xdf, 0x9a, 0x23, 0x1a, 0x9d, 0xcf, 0x64, 0x81, 0x50, 0xf8, 0xda, 0x79, 0x75,
+    0xf9, 0xb8, 0x4f, 0x7f, 0xbd, 0x7b, 0xb8, 0x4e, 0x9f, 0x40, 0x75, 0x7a, 0x0f, 0x53, 0xaf, 0xef,
+    0x1b, 0x21, 0xf9, 0x4f, 0x99, 0xa1, 0xb8, 0x36, 0xec, 0xe0, 0x4c, 0x76, 0xd0, 0x4a, 0xb8, 0x34,
+    0xef, 0x76, 0x0e, 0x3a, 0x49, 0xa5, 0x38, 0xee, 0x4f, 0x8c, 0x04, 0x28, 0x77, 0x1d, 0x36, 0xd8,
+    0x01, 0xd6, 0x74, 0xc0, 0xc4, 0xb4, 0xcb, 0xb1, 0x1e, 0xec, 0xee, 0x58, 0x8d, 0x5e, 0xc3, 0xa9,
+    0x57, 0xdb, 0x86, 0x62, 0x10, 0xd7, 0x75, 0x88, 0x3f, 0x6e, 0x7e, 0xe1, 0xdd, 0x8e, 0x77, 0xd7,
+    0x8b, 0x65, 0x59, 0x0a, 0xf3, 0xf3, 0xec, 0xc5, 0x73, 0x0c, 0x96, 0x6c, 0xb0, 0xe4, 0x54, 0xf6,
+    0x1e, 0x15, 0x19, 0xe7, 0xba, 0xe1, 0xfb, 0x38, 0x69, 0xf6, 0x71, 0x52, 0xbf, 0xe5, 0xff, 0x07,
+    0xb8, 0x48, 0x71, 0x3f, 0xf6, 0x0b, 0x00, 0x00,
+};
+static const WebAsset WEB_HISTORY = {WEB_HISTORY_GZ, sizeof(WEB_HISTORY_GZ), "\"bac6db3594657e13\""};
+
+// logs.html: 5996 bytes, 2401 gzipped
+static const uint8_t WEB_LOGS_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x9d, 0x58, 0x6b, 0x72, 0xdb, 0x38,
+    0x12, 0xfe, 0xaf, 0x53, 0x60, 0x94, 0xca, 0x50, 0xda, 0xb1, 0x28, 0xc9, 0x71, 0x52, 0x2e, 0xbd,
+    0xa6, 0x66, 0x1c, 0x67, 0x92, 0xad, 0xbc, 0x2a, 0x76, 0x26, 0x33, 0xeb, 0x72, 0x6d, 0x41, 0x24,
+    0x24, 0x21, 0x26, 0x09, 0x06, 0x80, 0xe4, 0xc7, 0xda, 0x37, 0xd8, 0xdc, 0x65, 0x4f, 0xb0, 0x3f,
+    0xb6, 0xb2, 0xf7, 0xda, 0xaf, 0x01, 0x52, 0xa2, 0x64, 0x69, 0x92, 0x59, 0xab, 0x4a, 0x22, 0xd1,
+    0x8d, 0x7e, 0x7e, 0xdd, 0x0d, 0x78, 0xf0, 0xdd, 0xd3, 0x37, 0x47, 0xa7, 0xbf, 0xbf, 0x3d, 0x66,
+    0x33, 0x9b, 0x26, 0xa3, 0xda, 0x80, 0x7e, 0x58, 0xc2, 0xb3, 0xe9, 0xb0, 0x6e, 0x92, 0x3a, 0x2d,
+    0x08, 0x1e, 0xe3, 0x27, 0x15, 0x96, 0xb3, 0x68, 0xc6, 0xb5, 0x11, 0x76, 0x58, 0x7f, 0x7f, 0xfa,
+    0xac, 0x75, 0x48, 0x54, 0x2b, 0x6d, 0x22, 0x46, 0xef, 0x8e, 0x3f, 0xb0, 0x16, 0x7b, 0xa9, 0xa6,
+    0x72, 0xd0, 0xf6, 0x2b, 0xb5, 0x81, 0xb1, 0xd7, 0xf4, 0x3b, 0x56, 0xf1, 0x35, 0xfb, 0x47, 0x6d,
+    0xcc, 0xa3, 0x8b, 0xa9, 0x56, 0xf3, 0x2c, 0xee, 0xb1, 0x07, 0xdd, 0x0e, 0x7d, 0xfa, 0xb5, 0x48,
+    0x25, 0x4a, 0xe3, 0x5d, 0x74, 0xe8, 0xd3, 0xaf, 0x4d, 0x54, 0x66, 0x5b, 0x13, 0x9e, 0xca, 0xe4,
+    0xba, 0xc7, 0x0c, 0xcf, 0x4c, 0xcb, 0x08, 0x2d, 0x27, 0xfd, 0x5a, 0xca, 0xf5, 0x54, 0x66, 0x3d,
+    0xb6, 0xdf, 0xc9, 0xaf, 0xfa, 0xb5, 0xbb, 0xda, 0xac, 0x0b, 0x91, 0xc5, 0xee, 0xcb, 0x99, 0xb4,
+    0xa2, 0x5f, 0xb3, 0xe2, 0xca, 0xb6, 0x78, 0x22, 0xa7, 0x60, 0x8b, 0x44, 0x66, 0x85, 0x26, 0xc6,
+    0x89, 0xd2, 0x29, 0x58, 0x53, 0x7e, 0xd5, 0xba, 0x94, 0xb1, 0x9d, 0xf5, 0xd8, 0x93, 0x8e, 0x93,
+    0x51, 0x95, 0xc8, 0xf8, 0xdc, 0xaa, 0xfe, 0x86, 0x89, 0x9c, 0x3e, 0xfd, 0x5a, 0xce, 0xe3, 0x58,
+    0x66, 0xd3, 0x52, 0xf5, 0x58, 0xe9, 0x58, 0xe8, 0x96, 0xe6, 0xb1, 0x9c, 0x9b, 0x1e, 0x3b, 0x5c,
+    0xad, 0xf5, 0x58, 0x17, 0x92, 0x8c, 0x4a, 0x64, 0xcc, 0x1e, 0x3c, 0x7a, 0xf4, 0x88, 0xb4, 0x87,
+    0xa4, 0xbe, 0xa5, 0xd5, 0x25, 0x4c, 0x88, 0xa5, 0xc9, 0x13, 0x0e, 0xbf, 0x26, 0x89, 0xc0, 0xa6,
+    0x29, 0xcf, 0x4b, 0x99, 0xde, 0x94, 0xd6, 0x58, 0x59, 0xab, 0x52, 0x88, 0x79, 0x4c, 0x8b, 0xce,
+    0x93, 0x16, 0x3c, 0x4b, 0x4d, 0xd5, 0x9f, 0x84, 0x8f, 0x45, 0x42, 0x0e, 0x61, 0x43, 0xe1, 0xd0,
+    0x61, 0x11, 0x13, 0x99, 0xe5, 0x73, 0x7b, 0x66, 0xaf, 0x73, 0x31, 0xac, 0xc7, 0xdc, 0x8a, 0xfa,
+    0xf9, 0x1e, 0xab, 0xae, 0x59, 0x99, 0xde, 0x5f, 0x43, 0xd0, 0x68, 0xcd, 0x88, 0x44, 0x44, 0x16,
+    0x72, 0x97, 0xee, 0x7a, 0xcf, 0xaa, 0x11, 0xd9, 0xe7, 0xf4, 0xd9, 0xea, 0xee, 0xe3, 0xc7, 0x8f,
+    0xef, 0x85, 0xe6, 0x80, 0x04, 0x6c, 0x26, 0x78, 0xdd, 0x4a, 0x33, 0x1f, 0xa7, 0x12, 0xfa, 0x37,
+    0xe1, 0x71, 0x10, 0xf3, 0x27, 0x93, 0x49, 0x7f, 0x23, 0xc1, 0xa5, 0xde, 0x4c, 0x65, 0xa2, 0x92,
+    0x97, 0x2e, 0x25, 0x70, 0x6b, 0x72, 0x5c, 0x1c, 0xa3, 0xb9, 0x36, 0x24, 0x24, 0x57, 0xb2, 0x8c,
+    0xe1, 0x36, 0x13, 0x7a, 0x33, 0xb5, 0x10, 0x7a, 0xd3, 0x90, 0x47, 0xfc, 0x90, 0x8b, 0x27, 0x2e,
+    0x93, 0x11, 0xa0, 0x89, 0x2c, 0x38, 0x2c, 0xb9, 0x74, 0x59, 0x95, 0xaf, 0xf0, 0x68, 0xf9, 0x38,
+    0x11, 0xa0, 0x15, 0x29, 0xe9, 0x76, 0x3a, 0x0f, 0x97, 0xe6, 0xc0, 0x8b, 0x84, 0xe7, 0x46, 0x20,
+    0x8d, 0xc5, 0xd3, 0x0e, 0xa8, 0xed, 0xc6, 0x91, 0x9d, 0xed, 0x31, 0x1b, 0xdf, 0x4b, 0x4f, 0x15,
+    0xf2, 0x89, 0x98, 0xd8, 0x3f, 0x16, 0xb1, 0xe9, 0x5c, 0x99, 0xcf, 0xf5, 0x28, 0xc3, 0x55, 0xe0,
+    0xb5, 0xa5, 0x57, 0xf5, 0xf5, 0x60, 0x32, 0x39, 0xc0, 0xdf, 0x92, 0x74, 0xb9, 0x46, 0xe2, 0xbc,
+    0xe3, 0xf2, 0x1a, 0xce, 0xa4, 0x8b, 0x4e, 0x49, 0x39, 0x3c, 0x3c, 0x2c, 0xea, 0xd9, 0xc8, 0x1b,
+    0xf8, 0xde, 0x09, 0x0f, 0x1f, 0x8b, 0x74, 0x29, 0x24, 0xaa, 0xb0, 0x1e, 0x1c, 0x90, 0x06, 0x47,
+    0x32, 0x91, 0xa6, 0x18, 0xf9, 0x60, 0x52, 0x46, 0x26, 0x09, 0x98, 0x51, 0x34, 0xbe, 0x42, 0xa9,
+    0x8c, 0x67, 0x42, 0x4e, 0x67, 0x96, 0x60, 0xbf, 0x98, 0xb9, 0x3d, 0x97, 0x5c, 0x67, 0x88, 0xc9,
+    0x16, 0xab, 0xbc, 0x7a, 0x6a, 0x43, 0x3d, 0x26, 0x2d, 0x02, 0x15, 0xad, 0xea, 0xde, 0xc1, 0xc6,
+    0x5b, 0x9e, 0xc8, 0x85, 0xb8, 0x5f, 0xa0, 0x5b, 0x0b, 0xd0, 0x55, 0xed, 0x13, 0x57, 0xb4, 0xab,
+    0x02, 0x5c, 0x49, 0x69, 0xc9, 0x6c, 0xa2, 0x20, 0x6a, 0x5b, 0x2f, 0x5a, 0x7a, 0x5b, 0x80, 0x9b,
+    0x04, 0x94, 0xbe, 0x74, 0xc3, 0xfd, 0x22, 0x36, 0x94, 0xa1, 0x1d, 0x02, 0xb6, 0xe1, 0xce, 0xf3,
+    0xf3, 0x6a, 0x30, 0x0b, 0xf1, 0x4e, 0x42, 0x2c, 0x22, 0xa5, 0xb9, 0x95, 0x2a, 0xfb, 0x7a, 0xd9,
+    0xac, 0x81, 0xa6, 0x94, 0xb2, 0xad, 0xa2, 0x96, 0x5a, 0xb7, 0xd7, 0xcc, 0x46, 0xf1, 0x2e, 0x7b,
+    0xfd, 0x5d, 0x6d, 0xd0, 0x2e, 0x46, 0xc2, 0xa0, 0x5d, 0xcc, 0x14, 0x9a, 0x0d, 0x34, 0x61, 0xba,
+    0x23, 0x1a, 0x1d, 0xcc, 0x48, 0x83, 0x70, 0x73, 0x90, 0xbb, 0x58, 0x75, 0xad, 0x1b, 0x53, 0x67,
+    0xa6, 0xe2, 0x61, 0xfd, 0x97, 0xe3, 0xd3, 0x3a, 0xe3, 0x11, 0xb9, 0x32, 0xac, 0xb7, 0x13, 0x35,
+    0x35, 0x34, 0x7c, 0x62, 0xb9, 0x60, 0x51, 0xc2, 0x8d, 0x19, 0xd6, 0xcb, 0x4e, 0x4b, 0xcb, 0xbe,
+    0x49, 0x62, 0xa5, 0x68, 0x84, 0xa3, 0xa7, 0xdc, 0xce, 0xd3, 0xde, 0xa0, 0xed, 0x08, 0x60, 0x70,
+    0x1d, 0x80, 0x55, 0x5a, 0x25, 0x93, 0x71, 0xf9, 0x94, 0xf1, 0x74, 0xb9, 0xaa, 0xc5, 0xa7, 0xb9,
+    0xd4, 0x22, 0x5e, 0x97, 0xe9, 0x1a, 0xe9, 0xe8, 0xbd, 0xe6, 0x3b, 0x24, 0x3a, 0xba, 0x93, 0xe8,
+    0x9f, 0xbc, 0x44, 0xff, 0x5c, 0x91, 0x58, 0xdd, 0x52, 0xb4, 0x21, 0xb6, 0xe0, 0xc9, 0x1c, 0xaf,
+    0x6f, 0xb5, 0xbc, 0xe0, 0xff, 0xfd, 0xb7, 0x5c, 0x39, 0x53, 0x78, 0x49, 0x20, 0xab, 0x8f, 0xd6,
+    0xb6, 0x46, 0x33, 0x11, 0x5d, 0x8c, 0xd5, 0x95, 0xd7, 0xe8, 0x19, 0xd8, 0xaf, 0x0c, 0xbb, 0x17,
+    0x6a, 0x65, 0x5f, 0x1b, 0xa1, 0xfa, 0xa6, 0x80, 0x7d, 0xaa, 0x8f, 0x5e, 0x98, 0x0b, 0x9e, 0x7d,
+    0x14, 0xbb, 0xbc, 0xa3, 0x91, 0xe1, 0x74, 0x7d, 0x2a, 0x5d, 0xc3, 0x03, 0x2a, 0x27, 0x12, 0x33,
+    0x95, 0x00, 0x2d, 0xc3, 0x7a, 0x96, 0xeb, 0x90, 0x7d, 0x90, 0xcf, 0x9c, 0xfd, 0xc5, 0x68, 0xf1,
+    0x9c, 0x89, 0x58, 0x08, 0x77, 0xa8, 0x50, 0x39, 0xa5, 0xb2, 0xf4, 0xb7, 0x3e, 0xfa, 0xd5, 0x08,
+    0xb6, 0xd0, 0xc6, 0xca, 0x48, 0x0c, 0xda, 0x9e, 0x78, 0x8f, 0x4b, 0x68, 0x5d, 0x1f, 0xbd, 0xe6,
+    0x39, 0xbf, 0xd8, 0xcd, 0x43, 0xcd, 0xa0, 0x3e, 0x7a, 0x93, 0xab, 0x1b, 0xa5, 0x65, 0xc2, 0x77,
+    0xf2, 0x51, 0xa1, 0xc2, 0x53, 0x7c, 0xef, 0x64, 0x89, 0xc5, 0x78, 0x3e, 0x05, 0x76, 0xe8, 0xa7,
+    0xc2, 0xd4, 0xf6, 0x0e, 0xfd, 0x99, 0x98, 0x4e, 0xb4, 0x4a, 0x61, 0x54, 0xfc, 0x55, 0x04, 0x3a,
+    0xc6, 0x22, 0x54, 0x7e, 0xd3, 0x3a, 0xf0, 0x60, 0xf2, 0x53, 0xf5, 0x55, 0x29, 0x60, 0x2b, 0x31,
+    0xa7, 0xea, 0x5b, 0xed, 0xa4, 0x5e, 0x5d, 0x1f, 0xfd, 0x8d, 0x49, 0x64, 0x3a, 0xc9, 0x64, 0xca,
+    0x32, 0x79, 0xa3, 0x52, 0x1c, 0x03, 0xd0, 0x5c, 0xb2, 0x8f, 0x8a, 0xa1, 0xf3, 0x30, 0x35, 0x8e,
+    0xd5, 0xf8, 0xa3, 0x48, 0x71, 0x36, 0x60, 0xb9, 0xc7, 0xa3, 0x00, 0xe9, 0x86, 0xc7, 0xc2, 0x5e,
+    0x48, 0x26, 0x6f, 0xd8, 0x42, 0x7c, 0xf9, 0xcc, 0xe2, 0x4c, 0x3a, 0x65, 0xd8, 0x8a, 0xb5, 0xb1,
+    0xe6, 0x99, 0x60, 0x73, 0x2d, 0xc2, 0x52, 0x6b, 0x9b, 0x62, 0xb2, 0xae, 0x7d, 0xd9, 0x29, 0x57,
+    0x90, 0x7d, 0xe1, 0xd2, 0xb1, 0xc5, 0xd2, 0x62, 0xec, 0x52, 0xde, 0x13, 0x3e, 0x25, 0x58, 0x86,
+    0x61, 0xb8, 0x85, 0x8f, 0x5a, 0x10, 0xf9, 0xca, 0xd9, 0x4c, 0x8b, 0x09, 0x5a, 0x04, 0xed, 0xb8,
+    0xe1, 0x1f, 0x61, 0x1b, 0x4c, 0xfe, 0xf2, 0x59, 0xd8, 0x4c, 0xc1, 0x3d, 0x98, 0x37, 0x68, 0xf3,
+    0x55, 0x4c, 0x30, 0x6f, 0x64, 0x8e, 0x5c, 0xb6, 0xdb, 0xec, 0x74, 0x06, 0x3f, 0xf9, 0x54, 0x20,
+    0x28, 0x2c, 0xe2, 0xa8, 0x2a, 0x34, 0x33, 0x8b, 0x35, 0xd7, 0x86, 0x2c, 0x30, 0x67, 0x30, 0x43,
+    0x8c, 0x07, 0x87, 0x61, 0xae, 0x03, 0x52, 0x8a, 0x1c, 0xcf, 0xa7, 0xb9, 0xd0, 0xd7, 0x8c, 0x67,
+    0x31, 0x09, 0xa2, 0x05, 0x60, 0x00, 0x52, 0x54, 0x2a, 0x3c, 0x8f, 0x6b, 0x58, 0x6d, 0x5a, 0xac,
+    0x35, 0x26, 0xf3, 0xcc, 0xb5, 0xb1, 0x46, 0x13, 0x9d, 0x73, 0xc1, 0x35, 0x43, 0x5b, 0x37, 0x6c,
+    0xc8, 0x32, 0x71, 0xc9, 0xde, 0xbf, 0x7b, 0x79, 0x22, 0xb8, 0x8e, 0x66, 0x6f, 0xb9, 0xe6, 0xa9,
+    0x69, 0x24, 0x2a, 0x72, 0xdd, 0x3b, 0x34, 0x6e, 0xb5, 0xd9, 0x77, 0x1b, 0x9c, 0x45, 0x43, 0x16,
+    0xab, 0x68, 0x9e, 0x22, 0x36, 0xee, 0x90, 0x69, 0xce, 0x3a, 0xe7, 0xfd, 0xda, 0x59, 0x40, 0x28,
+    0x08, 0xf6, 0x58, 0x40, 0xdd, 0x86, 0x7e, 0x3f, 0xd1, 0x97, 0xab, 0x3a, 0x7a, 0x20, 0x63, 0x1c,
+    0x55, 0x05, 0xe7, 0xb4, 0xed, 0x18, 0x7e, 0xae, 0x0c, 0xa2, 0x34, 0x92, 0x51, 0x72, 0xc2, 0x1a,
+    0x64, 0x54, 0x38, 0x15, 0xd6, 0x2f, 0x36, 0x9d, 0xce, 0x10, 0xc0, 0x27, 0x85, 0xe6, 0x8c, 0x16,
+    0xcf, 0x43, 0x17, 0x0a, 0x18, 0xb2, 0xce, 0x8b, 0x4e, 0x5f, 0xd8, 0x99, 0xe1, 0xdc, 0xeb, 0xfd,
+    0x42, 0xff, 0x15, 0x0d, 0xac, 0x96, 0xaa, 0x10, 0xe8, 0xb8, 0x91, 0x41, 0x17, 0xfa, 0xa1, 0x9d,
+    0xeb, 0x8c, 0x35, 0x32, 0x36, 0xc0, 0x48, 0x62, 0x3f, 0xb2, 0xa0, 0x13, 0xb0, 0x1e, 0x0b, 0x82,
+    0x26, 0xfb, 0x81, 0x65, 0x7d, 0x76, 0xe7, 0xac, 0xf9, 0x6e, 0x4d, 0x7d, 0x48, 0x4e, 0x7a, 0xed,
+    0x64, 0xee, 0x2e, 0x1a, 0xe9, 0x56, 0x97, 0x64, 0xd8, 0xb3, 0x79, 0x92, 0xfc, 0x8e, 0x08, 0x36,
+    0x48, 0x68, 0xd0, 0x0a, 0xf0, 0xed, 0x0c, 0xf0, 0xd4, 0x57, 0x80, 0xd8, 0xcc, 0x91, 0xba, 0x5b,
+    0xe9, 0xde, 0xf8, 0xa6, 0x3b, 0x39, 0xde, 0xb7, 0x85, 0x02, 0x5d, 0xda, 0xb2, 0x8b, 0x02, 0x4b,
+    0x2a, 0xf2, 0x9e, 0x2b, 0x1c, 0x49, 0x21, 0x90, 0x74, 0xf5, 0x3a, 0x9d, 0x00, 0x61, 0x11, 0x16,
+    0x79, 0x08, 0x56, 0x28, 0x21, 0x0b, 0x36, 0x73, 0x1f, 0x02, 0x57, 0xd9, 0x2a, 0x59, 0xba, 0x12,
+    0x3d, 0x1d, 0x52, 0x53, 0x46, 0x80, 0xd9, 0xdd, 0x26, 0x1b, 0xdd, 0xe6, 0x28, 0x48, 0x4b, 0xb0,
+    0x38, 0xa8, 0x9e, 0xb8, 0x16, 0xa6, 0x74, 0x23, 0x28, 0xcf, 0xb5, 0x41, 0x33, 0x94, 0x59, 0x26,
+    0xf4, 0xf3, 0xd3, 0x57, 0x2f, 0x61, 0x2e, 0x6d, 0xf3, 0x89, 0xbc, 0x6b, 0x52, 0xe2, 0x00, 0xeb,
+    0x97, 0x74, 0x4a, 0xb2, 0x5c, 0x26, 0x3d, 0x97, 0x52, 0x4d, 0x47, 0x8b, 0xd8, 0x14, 0xf8, 0xe6,
+    0xb9, 0x6c, 0xbb, 0x63, 0xd4, 0x54, 0x31, 0xa4, 0x17, 0x6d, 0x84, 0xa9, 0x89, 0xab, 0x04, 0x77,
+    0x32, 0xde, 0xa3, 0x47, 0x12, 0x92, 0x20, 0x96, 0xc6, 0xa2, 0xa5, 0x64, 0x38, 0x94, 0x97, 0xb5,
+    0xc4, 0xc7, 0x38, 0x47, 0xa0, 0xb8, 0xb6, 0xd4, 0x06, 0xe6, 0x5a, 0x15, 0xe9, 0x88, 0xde, 0xb1,
+    0x0f, 0xef, 0xcf, 0xd7, 0x2f, 0xe2, 0x46, 0x40, 0x2a, 0x83, 0x02, 0x6d, 0xee, 0xe8, 0xf5, 0x15,
+    0x5e, 0x6a, 0x33, 0x25, 0xbf, 0xd1, 0x11, 0x21, 0x04, 0xd0, 0xf8, 0xff, 0x70, 0xb9, 0xdc, 0x63,
+    0x2c, 0x4f, 0xf3, 0x86, 0x2d, 0x2b, 0xc7, 0x86, 0x74, 0x49, 0xfe, 0xc9, 0x36, 0x3a, 0x4d, 0x36,
+    0x1c, 0xb2, 0xe0, 0x15, 0xb6, 0x14, 0xd2, 0xac, 0xd7, 0x1c, 0x57, 0xab, 0x22, 0xa7, 0x0b, 0xf5,
+    0x8b, 0xcc, 0x36, 0xec, 0x1e, 0x14, 0x35, 0xd9, 0x5f, 0xe8, 0xf2, 0xd0, 0x81, 0x8d, 0xc5, 0x1e,
+    0xb2, 0x28, 0xbe, 0x07, 0x9b, 0x12, 0xa2, 0x8e, 0xf2, 0x4a, 0x66, 0x73, 0x84, 0x75, 0x2b, 0xed,
+    0x04, 0x69, 0xca, 0xe2, 0x92, 0x86, 0xcf, 0x0f, 0xb5, 0x25, 0xad, 0x00, 0x36, 0x11, 0xc2, 0x75,
+    0x81, 0x1b, 0x15, 0xb1, 0x4e, 0xad, 0x54, 0xd3, 0x43, 0x32, 0xd6, 0x55, 0xc6, 0x32, 0x1a, 0x04,
+    0xdf, 0x65, 0xfa, 0xec, 0xb8, 0x9a, 0x91, 0x1d, 0xd0, 0x03, 0x17, 0x8e, 0x81, 0x94, 0x16, 0x57,
+    0x5e, 0x76, 0x5c, 0xee, 0xf6, 0xc7, 0x89, 0x6f, 0x91, 0x70, 0x86, 0xaa, 0xe7, 0x2d, 0xba, 0x1d,
+    0x90, 0xfa, 0x73, 0x44, 0xfc, 0xf6, 0x96, 0x7d, 0x1d, 0xf2, 0xfd, 0x9a, 0x57, 0xb1, 0x06, 0xfd,
+    0xa0, 0x3a, 0x56, 0x56, 0xf7, 0x11, 0x4c, 0x27, 0x07, 0x65, 0xfc, 0xb8, 0xc3, 0xeb, 0xc0, 0xea,
+    0x11, 0x45, 0x33, 0xc0, 0xfb, 0xe8, 0xcb, 0x3f, 0xb9, 0x61, 0xe8, 0xd6, 0x6e, 0x9a, 0x36, 0x07,
+    0x6d, 0x2c, 0xd1, 0xf2, 0x71, 0xa6, 0x2c, 0x5f, 0xbe, 0x9d, 0xe4, 0x4a, 0xab, 0x2f, 0x9f, 0x65,
+    0xa2, 0xfc, 0x52, 0x1b, 0x12, 0xe8, 0xc9, 0x4b, 0x73, 0x47, 0x61, 0xbc, 0x96, 0xbf, 0x5e, 0x97,
+    0x1b, 0x53, 0xe8, 0x10, 0x7f, 0x32, 0x90, 0x77, 0x25, 0x7a, 0xec, 0x98, 0x5e, 0x50, 0x78, 0xfe,
+    0xe4, 0x75, 0x3b, 0xcf, 0xe4, 0x15, 0x7d, 0xd9, 0x5b, 0x4c, 0x6c, 0x83, 0x69, 0x57, 0x5f, 0x65,
+    0x0e, 0x37, 0x83, 0x77, 0xea, 0xb2, 0x41, 0xa1, 0x2c, 0x33, 0x90, 0x93, 0x56, 0xbc, 0x87, 0xb8,
+    0x19, 0x49, 0xdb, 0x08, 0x6e, 0xcb, 0x2c, 0xe5, 0x61, 0x22, 0xb2, 0x29, 0xee, 0x94, 0x03, 0x76,
+    0x50, 0xc2, 0xdb, 0x83, 0xdb, 0xe9, 0x71, 0x0d, 0xaf, 0xc0, 0x75, 0x8e, 0xc9, 0xe4, 0xa0, 0xed,
+    0xe9, 0xa9, 0x99, 0x12, 0x35, 0x34, 0xb8, 0x8d, 0x89, 0xc6, 0xa3, 0x66, 0xf8, 0x11, 0x17, 0xf3,
+    0x42, 0xb2, 0x83, 0xcc, 0x5a, 0xc2, 0x23, 0x2d, 0x00, 0xd2, 0xa2, 0x8e, 0x1b, 0x81, 0xd5, 0xc4,
+    0x66, 0x75, 0xe8, 0xd2, 0xf3, 0x1a, 0xe3, 0x06, 0xcc, 0x85, 0xc6, 0x21, 0xeb, 0x52, 0x99, 0xba,
+    0xcb, 0x2b, 0x95, 0xea, 0x72, 0x79, 0xbf, 0x5c, 0xbe, 0x74, 0x15, 0xec, 0x6e, 0x9f, 0x08, 0xe9,
+    0x99, 0xaf, 0xdb, 0xfc, 0xac, 0x7b, 0xde, 0xdc, 0x63, 0xf9, 0xd9, 0x3e, 0xac, 0x84, 0x71, 0x5b,
+    0xe6, 0xe2, 0x62, 0x09, 0xe7, 0xf8, 0x8f, 0x6c, 0x8b, 0x9d, 0x6d, 0xb1, 0xeb, 0xc5, 0x47, 0x45,
+    0x46, 0x86, 0x6c, 0xe1, 0xec, 0xe5, 0x79, 0x2e, 0xb2, 0xf8, 0x68, 0x26, 0x93, 0xb8, 0x61, 0xe3,
+    0xca, 0x8c, 0x74, 0x89, 0xf5, 0x35, 0x43, 0x59, 0x06, 0x12, 0x8d, 0xd0, 0xf6, 0x67, 0x01, 0x23,
+    0x44, 0xc3, 0x6a, 0x34, 0xce, 0x71, 0x38, 0x91, 0x38, 0x18, 0xbb, 0xbd, 0xbe, 0x13, 0x1f, 0x91,
+    0xb4, 0x98, 0x71, 0xeb, 0x1a, 0xec, 0xab, 0x9f, 0x7e, 0xfb, 0xfb, 0xbb, 0x37, 0x1f, 0x4e, 0xa8,
+    0xe1, 0x56, 0xce, 0x19, 0xdf, 0x54, 0x40, 0xf7, 0xea, 0xa6, 0xc8, 0x11, 0xbf, 0x7a, 0x47, 0x07,
+    0x98, 0x61, 0x29, 0xe1, 0xc7, 0x55, 0x3a, 0x8b, 0x8a, 0x41, 0x1f, 0xf8, 0xc9, 0x5a, 0x2d, 0xc7,
+    0xe8, 0x3c, 0x8d, 0x60, 0x4d, 0x4c, 0xd0, 0xf4, 0x9d, 0xcc, 0x5d, 0x8c, 0x2f, 0x61, 0xb6, 0x60,
+    0x8d, 0x52, 0xe2, 0x88, 0x75, 0xd8, 0xf7, 0xdf, 0x93, 0x53, 0xc4, 0x59, 0x82, 0x68, 0x54, 0x6a,
+    0x6c, 0x12, 0x25, 0x86, 0x79, 0x56, 0x10, 0x14, 0x37, 0xd8, 0x5a, 0x68, 0x47, 0x6b, 0xbd, 0xc6,
+    0xcc, 0xd4, 0xe5, 0x89, 0x1b, 0x25, 0x66, 0x0d, 0xb6, 0x64, 0xf9, 0x5f, 0x4f, 0xde, 0xbc, 0x0e,
+    0x9d, 0xd5, 0x9e, 0x04, 0xdc, 0xa2, 0xf9, 0x6f, 0x24, 0x27, 0x38, 0xfe, 0xed, 0x94, 0x7a, 0x22,
+    0x33, 0x21, 0xd6, 0x4f, 0x45, 0x9a, 0xbb, 0x2e, 0xf9, 0x9f, 0x7f, 0x1d, 0xed, 0xad, 0x96, 0x9f,
+    0xcf, 0x53, 0x19, 0x4b, 0x7b, 0xed, 0x48, 0x0f, 0x19, 0xbb, 0x65, 0xec, 0xe9, 0x49, 0x41, 0xa6,
+    0x21, 0x9d, 0xdc, 0xdb, 0x57, 0x2b, 0x08, 0xeb, 0x3b, 0xf7, 0xd8, 0xd1, 0x9b, 0xfd, 0xea, 0x3e,
+    0x7a, 0x25, 0x4a, 0x9e, 0xa7, 0xc1, 0xba, 0x5f, 0x96, 0x6b, 0xeb, 0x9a, 0x68, 0x31, 0xa4, 0x30,
+    0x2c, 0x8e, 0x17, 0x30, 0xf9, 0x04, 0x33, 0x00, 0x55, 0x13, 0x2c, 0xe7, 0x2d, 0x65, 0x0c, 0x3c,
+    0x21, 0x6a, 0xd7, 0x31, 0xbc, 0xa4, 0x1b, 0x34, 0x7a, 0x19, 0xc6, 0x9d, 0x9a, 0xe2, 0xa4, 0xb7,
+    0xc4, 0x30, 0x9d, 0x94, 0xca, 0x0a, 0x17, 0xa1, 0x8f, 0x08, 0xbb, 0xdb, 0xb9, 0xdb, 0x0f, 0xe8,
+    0x7b, 0x02, 0xaa, 0x01, 0xbf, 0x27, 0x45, 0x61, 0xa7, 0x56, 0x04, 0xb7, 0xea, 0x18, 0x67, 0xdb,
+    0xc2, 0xfe, 0x16, 0x03, 0xff, 0x86, 0x2f, 0x38, 0x2e, 0x16, 0xe2, 0x42, 0xe2, 0x50, 0x9f, 0x71,
+    0x94, 0xa0, 0xca, 0xd4, 0x02, 0xa7, 0xf4, 0x9c, 0x88, 0x6a, 0x51, 0x9c, 0xf5, 0x03, 0x28, 0xd8,
+    0x08, 0x8e, 0xca, 0x1b, 0xe5, 0xb0, 0x85, 0xde, 0x26, 0x4d, 0x72, 0x34, 0x04, 0x65, 0xdc, 0x11,
+    0xb3, 0x3a, 0xd6, 0xb7, 0xa9, 0x76, 0x91, 0xc6, 0xb1, 0x62, 0x8b, 0xd3, 0x98, 0xdb, 0xd9, 0x54,
+    0x54, 0x9d, 0x76, 0xf6, 0x43, 0x0d, 0xf1, 0xbb, 0x7b, 0xb6, 0x88, 0x9b, 0x65, 0x76, 0xfa, 0x4c,
+    0x24, 0xb8, 0x1a, 0x79, 0x73, 0x7c, 0x14, 0xfc, 0x59, 0x09, 0x37, 0xc4, 0xe2, 0x56, 0x31, 0x68,
+    0x17, 0xff, 0xe0, 0x68, 0xfb, 0xff, 0xad, 0xff, 0x0f, 0x49, 0x39, 0x54, 0x9c, 0x6c, 0x17, 0x00,
+    0x00,
+};
+static const WebAsset WEB_LOGS = {WEB_LOGS_GZ, sizeof(WEB_LOGS_GZ), "\"9b1ba4303509cbf7\""};
+
+// root.html: 1099 bytes, 613 gzipped
+static const uint8_t WEB_ROOT_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x6d, 0x54, 0xcb, 0x6e, 0xdb, 0x30,
+    0x10, 0xbc, 0xeb, 0x2b, 0xb6, 0xca, 0x21, 0xf6, 0x41, 0x96, 0xdd, 0x24, 0x45, 0x20, 0xc9, 0x3e,
+    0xa4, 0x4d, 0xd1, 0x02, 0x69, 0x1b, 0x14, 0x6e, 0x83, 0xf6, 0xb6, 0x26, 0x57, 0x12, 0x13, 0x8a,
+    0x14, 0x48, 0xca, 0x89, 0x11, 0xe4, 0x13, 0xfa, 0x57, 0xfd, 0xb0, 0x92, 0x96, 0x9c, 0x87, 0x1b,
+    0xf3, 0x40, 0x91, 0x9c, 0x1d, 0xce, 0x70, 0x07, 0x2e, 0xde, 0x7c, 0xf8, 0xf6, 0x7e, 0xf9, 0xeb,
+    0xf2, 0x1c, 0x6a, 0xd7, 0xc8, 0x45, 0x54, 0x84, 0x09, 0x24, 0xaa, 0x6a, 0x1e, 0x5b, 0x19, 0x87,
+    0x0d, 0x42, 0xee, 0xa7, 0x86, 0x1c, 0x02, 0xab, 0xd1, 0x58, 0x72, 0xf3, 0xf8, 0xc7, 0xf2, 0x63,
+    0x72, 0x1a, 0x4e, 0x9d, 0x70, 0x92, 0x16, 0xdf, 0xcf, 0xaf, 0xe0, 0x8a, 0x56, 0x45, 0xda, 0x2f,
+    0xa3, 0xc2, 0xba, 0x4d, 0x98, 0x57, 0x9a, 0x6f, 0xe0, 0x3e, 0x5a, 0x21, 0xbb, 0xa9, 0x8c, 0xee,
+    0x14, 0xcf, 0xe0, 0x60, 0x36, 0x0d, 0x23, 0x8f, 0x98, 0x96, 0xda, 0xf8, 0x35, 0x4d, 0xc3, 0xc8,
+    0xa3, 0x52, 0x2b, 0x97, 0x94, 0xd8, 0x08, 0xb9, 0xc9, 0xc0, 0xa2, 0xb2, 0x89, 0x25, 0x23, 0xca,
+    0x3c, 0x6a, 0xd0, 0x54, 0x42, 0x65, 0xf0, 0x76, 0xda, 0xde, 0xe5, 0xd1, 0x43, 0x54, 0xcf, 0x3c,
+    0xe5, 0x50, 0x7d, 0x5b, 0x0b, 0x47, 0x79, 0xe4, 0xe8, 0xce, 0x25, 0x28, 0x45, 0xe5, 0x61, 0x8c,
+    0x94, 0x23, 0x13, 0x80, 0x13, 0xeb, 0xd0, 0x75, 0xf6, 0x3f, 0x01, 0x18, 0x46, 0x1e, 0xb5, 0xc8,
+    0xb9, 0x50, 0x55, 0x06, 0xb3, 0x93, 0x40, 0xbc, 0xd2, 0x86, 0x93, 0x49, 0x0c, 0x72, 0xd1, 0xd9,
+    0x0c, 0x4e, 0x9f, 0xf6, 0x3c, 0xa2, 0xbd, 0x03, 0xab, 0xa5, 0xe0, 0x70, 0x70, 0x74, 0x74, 0xf4,
+    0x52, 0x12, 0x78, 0xed, 0x5b, 0x19, 0x89, 0x6d, 0x91, 0x51, 0x06, 0xad, 0xa1, 0x44, 0x0a, 0x45,
+    0x5b, 0x09, 0x0a, 0xd7, 0xfe, 0xfe, 0xd7, 0xf4, 0xed, 0x73, 0x0c, 0x60, 0x7c, 0x32, 0x77, 0x70,
+    0xcc, 0xf1, 0x5d, 0x59, 0x0e, 0xf6, 0x38, 0x31, 0x6d, 0xd0, 0x09, 0xed, 0x6b, 0x94, 0x0e, 0xf4,
+    0x3b, 0x86, 0xe9, 0xe0, 0xe0, 0xc9, 0x50, 0xa0, 0xec, 0x9f, 0xeb, 0x15, 0x07, 0x3b, 0xd6, 0x3d,
+    0xc3, 0x27, 0xfd, 0xeb, 0xf6, 0x22, 0xb2, 0x5a, 0xaf, 0xc9, 0xec, 0xbf, 0xdc, 0xae, 0x72, 0xa7,
+    0x6f, 0xd7, 0x4a, 0x5f, 0x45, 0xc6, 0x68, 0xf3, 0x4c, 0x7a, 0x59, 0x1e, 0xfb, 0xdf, 0xd0, 0xd5,
+    0x5b, 0x12, 0x55, 0xed, 0x32, 0x58, 0x69, 0xc9, 0x03, 0xba, 0x48, 0x87, 0x7c, 0x14, 0xe9, 0x90,
+    0xae, 0x10, 0x94, 0x90, 0xb5, 0xd9, 0x36, 0x4a, 0x09, 0xfc, 0xf4, 0x8f, 0x24, 0x24, 0x32, 0x71,
+    0x6d, 0x6f, 0x10, 0x48, 0x69, 0x87, 0x1e, 0x3b, 0xf3, 0x10, 0x2e, 0xd6, 0xc0, 0x24, 0x5a, 0xeb,
+    0xf3, 0xb9, 0x6d, 0x6f, 0x0c, 0x82, 0x3f, 0x7e, 0x2f, 0xbe, 0xa2, 0xc4, 0x0a, 0xd5, 0x35, 0x4d,
+    0x26, 0x93, 0x22, 0xf5, 0xe0, 0x97, 0x25, 0xde, 0x5c, 0x48, 0x2d, 0x42, 0x6d, 0xa8, 0x9c, 0xc7,
+    0x69, 0x2d, 0xac, 0xd3, 0x66, 0x13, 0x2f, 0x7e, 0x57, 0x9a, 0xeb, 0xb5, 0x50, 0xfe, 0x1a, 0x7c,
+    0x0e, 0x90, 0xba, 0xf2, 0xac, 0x17, 0xba, 0x12, 0x7b, 0x07, 0x35, 0xc9, 0x36, 0x5e, 0x5c, 0xea,
+    0x46, 0xff, 0xfd, 0xb3, 0x77, 0xc4, 0x49, 0x92, 0xa3, 0x78, 0x71, 0x66, 0x84, 0x0d, 0x52, 0xfa,
+    0xe3, 0x41, 0x8c, 0x65, 0x46, 0xb4, 0x6e, 0x11, 0xa5, 0x29, 0x2c, 0x6b, 0x82, 0x16, 0x2b, 0x02,
+    0x61, 0x81, 0x21, 0xab, 0x89, 0xe7, 0xc0, 0x3a, 0x63, 0xbc, 0x77, 0x58, 0xa3, 0xec, 0xc8, 0x6f,
+    0xeb, 0x86, 0xa0, 0x34, 0xba, 0x81, 0xb4, 0x77, 0x18, 0x95, 0xe4, 0x58, 0x3d, 0x3a, 0x1c, 0x96,
+    0x87, 0xe3, 0x89, 0xab, 0x49, 0x8d, 0xca, 0x4e, 0xb1, 0x10, 0x8d, 0x91, 0x19, 0xc3, 0x3d, 0x18,
+    0x72, 0x9d, 0x51, 0x60, 0x26, 0x21, 0x38, 0xa3, 0x71, 0x0e, 0x0f, 0xfb, 0x30, 0xe7, 0x61, 0x11,
+    0xd7, 0xac, 0x6b, 0xfc, 0x65, 0x93, 0x8a, 0xdc, 0xb9, 0xa4, 0xf0, 0x79, 0xb6, 0xf9, 0xcc, 0x47,
+    0x87, 0x8f, 0xdc, 0x42, 0x29, 0x32, 0x9f, 0x96, 0x5f, 0x2e, 0x60, 0x0e, 0xce, 0x77, 0x6e, 0x9c,
+    0x87, 0xde, 0x0d, 0x0e, 0x8a, 0x74, 0xe8, 0x5a, 0xda, 0xff, 0x75, 0xfc, 0x03, 0x35, 0x67, 0x0d,
+    0xa8, 0x4b, 0x04, 0x00, 0x00,
+};
+static const WebAsset WEB_ROOT = {WEB_ROOT_GZ, sizeof(WEB_ROOT_GZ), "\"66267af9ffc19736\""};
+
+#endif // WEBASSETS_H
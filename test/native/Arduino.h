@@ -0,0 +1,283 @@
+// Arduino.h - Host stand-in for the Arduino core (native test env) header
+// Only what the storage, history and logging modules use. Time is
+// steady_clock based; tests move millis() forward with hostMillisOffset.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "pgmspace.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+using std::max;
+using std::min;
+
+#define HEX 16
+#define DEC 10
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define SS 10
+#define IRAM_ATTR
+#define F(s) (s)
+#ifndef constrain
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#endif
+
+typedef bool boolean;
+typedef uint8_t byte;
+class __FlashStringHelper;
+
+class String {
+public:
+    String() {}
+    String(const char* c) : s(c ? c : "") {}
+    String(const std::string& c) : s(c) {}
+    String(char c) : s(1, c) {}
+    String(int v, unsigned char base = 10) { format(base == 16 ? "%x" : "%d", v); }
+    String(unsigned v, unsigned char base = 10) { format(base == 16 ? "%x" : "%u", v); }
+    String(long v, unsigned char base = 10) { format(base == 16 ? "%lx" : "%ld", v); }
+    String(unsigned long v, unsigned char base = 10) { format(base == 16 ? "%lx" : "%lu", v); }
+    String(long long v, unsigned char base = 10) { format(base == 16 ? "%llx" : "%lld", v); }
+    String(unsigned long long v, unsigned char base = 10) { format(base == 16 ? "%llx" : "%llu", v); }
+    String(float v, unsigned char decimals = 2) { format("%.*f", decimals, (double)v); }
+    String(double v, unsigned char decimals = 2) { format("%.*f", decimals, v); }
+
+    const char* c_str() const { return s.c_str(); }
+    unsigned length() const { return s.size(); }
+    bool reserve(unsigned n) {
+        s.reserve(n);
+        return true;
+    }
+    bool isEmpty() const { return s.empty(); }
+    void clear() { s.clear(); }
+
+    int indexOf(char c, unsigned from = 0) const { return pos(s.find(c, from)); }
+    int indexOf(const String& c, unsigned from = 0) const { return pos(s.find(c.s, from)); }
+    int lastIndexOf(char c) const { return pos(s.rfind(c)); }
+    int lastIndexOf(const String& c) const { return pos(s.rfind(c.s)); }
+    String substring(unsigned from) const { return from > s.size() ? String() : String(s.substr(from)); }
+    String substring(unsigned from, unsigned to) const {
+        if (from > to) std::swap(from, to);
+        return from > s.size() ? String() : String(s.substr(from, to - from));
+    }
+    void trim() {
+        size_t a = s.find_first_not_of(" \t\r\n");
+        if (a == std::string::npos) {
+            s.clear();
+            return;
+        }
+        s = s.substr(a, s.find_last_not_of(" \t\r\n") - a + 1);
+    }
+    void toLowerCase() {
+        for (char& c : s) c = tolower((unsigned char)c);
+    }
+    void toUpperCase() {
+        for (char& c : s) c = toupper((unsigned char)c);
+    }
+    void replace(const String& from, const String& to) {
+        if (from.s.empty()) return;
+        for (size_t at = s.find(from.s); at != std::string::npos; at = s.find(from.s, at + to.s.size())) {
+            s.replace(at, from.s.size(), to.s);
+        }
+    }
+    long toInt() const { return atol(s.c_str()); }
+    float toFloat() const { return atof(s.c_str()); }
+    bool startsWith(const String& p) const { return s.compare(0, p.s.size(), p.s) == 0; }
+    bool endsWith(const String& p) const {
+        return s.size() >= p.s.size() && s.compare(s.size() - p.s.size(), p.s.size(), p.s) == 0;
+    }
+    bool equals(const String& o) const { return s == o.s; }
+    bool equalsIgnoreCase(const String& o) const { return strcasecmp(s.c_str(), o.s.c_str()) == 0; }
+    bool concat(const char* c, unsigned n) {
+        s.append(c, n);
+        return true;
+    }
+    bool concat(const String& c) {
+        s += c.s;
+        return true;
+    }
+    bool concat(char c) {
+        s += c;
+        return true;
+    }
+    char charAt(unsigned i) const { return i < s.size() ? s[i] : 0; }
+    char operator[](unsigned i) const { return i < s.size() ? s[i] : 0; }
+    char& operator[](unsigned i) { return s[i]; }
+
+    String& operator+=(const String& o) {
+        s += o.s;
+        return *this;
+    }
+    String& operator+=(const char* o) {
+        s += o;
+        return *this;
+    }
+    String& operator+=(char o) {
+        s += o;
+        return *this;
+    }
+    template <typename T>
+    String& operator+=(T v) {
+        s += String(v).s;
+        return *this;
+    }
+    bool operator==(const String& o) const { return s == o.s; }
+    bool operator==(const char* o) const { return s == o; }
+    bool operator!=(const String& o) const { return s != o.s; }
+    bool operator!=(const char* o) const { return s != o; }
+    bool operator<(const String& o) const { return s < o.s; }
+    bool operator>(const String& o) const { return s > o.s; }
+
+    // ArduinoJson's String adapter
+    size_t write(uint8_t c) {
+        s += (char)c;
+        return 1;
+    }
+
+    std::string s;
+
+private:
+    static int pos(size_t p) { return p == std::string::npos ? -1 : (int)p; }
+    void format(const char* fmt, ...) {
+        char b[64];
+        va_list ap;
+        va_start(ap, fmt);
+        vsnprintf(b, sizeof(b), fmt, ap);
+        va_end(ap);
+        s = b;
+    }
+};
+
+inline String operator+(const String& a, const String& b) { return String(a.s + b.s); }
+inline String operator+(const String& a, const char* b) { return String(a.s + b); }
+inline String operator+(const char* a, const String& b) { return String(a + b.s); }
+inline String operator+(const String& a, char b) { return String(a.s + b); }
+template <typename T>
+inline String operator+(const String& a, T v) { return String(a.s + String(v).s); }
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t size) {
+        size_t n = 0;
+        while (n < size && write(buf[n])) n++;
+        return n;
+    }
+    size_t write(const char* str) { return write((const uint8_t*)str, strlen(str)); }
+    size_t write(const char* buf, size_t size) { return write((const uint8_t*)buf, size); }
+    virtual void flush() {}
+
+    size_t print(const String& v) { return write((const uint8_t*)v.c_str(), v.length()); }
+    size_t print(const char* v) { return write(v); }
+    size_t print(char v) { return write((uint8_t)v); }
+    size_t print(int v, int base = DEC) { return print(String(v, base)); }
+    size_t print(unsigned v, int base = DEC) { return print(String(v, base)); }
+    size_t print(long v, int base = DEC) { return print(String(v, base)); }
+    size_t print(unsigned long v, int base = DEC) { return print(String(v, base)); }
+    size_t print(double v, int decimals = 2) { return print(String(v, decimals)); }
+    template <typename T>
+    size_t println(const T& v) {
+        return print(v) + println();
+    }
+    template <typename T>
+    size_t println(const T& v, int base) {
+        return print(v, base) + println();
+    }
+    size_t println() { return write((const uint8_t*)"\r\n", 2); }
+    size_t printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        char b[512];
+        va_list ap;
+        va_start(ap, fmt);
+        int n = vsnprintf(b, sizeof(b), fmt, ap);
+        va_end(ap);
+        return n > 0 ? write((const uint8_t*)b, min((size_t)n, sizeof(b) - 1)) : 0;
+    }
+};
+
+class Printable {
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print& p) const = 0;
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    size_t readBytes(char* buf, size_t size) {
+        size_t n = 0;
+        for (int c; n < size && (c = read()) >= 0;) buf[n++] = c;
+        return n;
+    }
+    size_t readBytes(uint8_t* buf, size_t size) { return readBytes((char*)buf, size); }
+    void setTimeout(unsigned long) {}
+};
+
+// Serial goes to stdout unless a test silences it
+class HardwareSerial : public Stream {
+public:
+    bool quiet = false;
+    void begin(unsigned long) {}
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* buf, size_t size) override {
+        if (!quiet) fwrite(buf, 1, size, stdout);
+        return size;
+    }
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    int availableForWrite() { return 128; }
+    operator bool() const { return true; }
+    using Print::write;
+};
+
+inline HardwareSerial Serial;
+
+class IPAddress {
+public:
+    IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0) : octets{a, b, c, d} {}
+    String toString() const {
+        char b[16];
+        snprintf(b, sizeof(b), "%u.%u.%u.%u", octets[0], octets[1], octets[2], octets[3]);
+        return String(b);
+    }
+    uint8_t octets[4];
+};
+
+inline unsigned long hostMillisOffset = 0;
+inline const std::chrono::steady_clock::time_point hostStart = std::chrono::steady_clock::now();
+
+inline unsigned long micros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - hostStart).count();
+}
+inline unsigned long millis() { return hostMillisOffset + micros() / 1000; }
+inline void delay(unsigned long ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+inline void yield() { std::this_thread::yield(); }
+
+// No pins on the host; SdFat's chip select lands here
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return LOW; }
+
+inline bool psramFound() { return false; }
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,33 @@
+// EEPROM.h - Host stand-in for the EEPROM emulation (native test env) header
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include "Arduino.h"
+#include <vector>
+
+class EEPROMClass {
+public:
+    bool begin(size_t size) {
+        _data.resize(size, 0xFF);
+        return true;
+    }
+    template <typename T>
+    T& get(int address, T& t) {
+        if (address + sizeof(T) <= _data.size()) memcpy(&t, _data.data() + address, sizeof(T));
+        return t;
+    }
+    template <typename T>
+    const T& put(int address, const T& t) {
+        if (address + sizeof(T) <= _data.size()) memcpy(_data.data() + address, &t, sizeof(T));
+        return t;
+    }
+    bool commit() { return true; }
+    void end() {}
+
+private:
+    std::vector<uint8_t> _data;
+};
+
+inline EEPROMClass EEPROM;
+
+#endif // HOST_EEPROM_H
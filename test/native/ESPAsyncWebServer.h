@@ -0,0 +1,51 @@
+// ESPAsyncWebServer.h - Host stand-in for the async web server (native test env) header
+// Requests carry only their arguments; a chunked response keeps its filler
+// so a test can pull the body the way the TCP task would.
+#ifndef HOST_ESPASYNCWEBSERVER_H
+#define HOST_ESPASYNCWEBSERVER_H
+
+#include "Arduino.h"
+#include <functional>
+#include <map>
+
+#define RESPONSE_TRY_AGAIN 0xFFFFFFFF
+
+typedef std::function<size_t(uint8_t*, size_t, size_t)> AwsResponseFiller;
+
+class AsyncWebServerResponse {
+public:
+    AsyncWebServerResponse(const String& contentType, AwsResponseFiller filler)
+        : contentType(contentType), filler(filler) {}
+    void addHeader(const String& name, const String& value) { headers[name.s] = value; }
+    void setCode(int c) { code = c; }
+
+    // Next piece of the body into buffer; 0 once it is complete
+    size_t fill(uint8_t* buffer, size_t maxLen) {
+        size_t n = filler(buffer, maxLen, sent);
+        if (n != RESPONSE_TRY_AGAIN) sent += n;
+        return n;
+    }
+
+    int code = 200;
+    String contentType;
+    std::map<std::string, String> headers;
+    AwsResponseFiller filler;
+    size_t sent = 0;
+};
+
+class AsyncWebServerRequest {
+public:
+    String arg(const char* name) const {
+        auto it = args.find(name);
+        return it == args.end() ? String() : it->second;
+    }
+    String arg(const String& name) const { return arg(name.c_str()); }
+    bool hasArg(const char* name) const { return args.count(name) > 0; }
+    AsyncWebServerResponse* beginChunkedResponse(const String& contentType, AwsResponseFiller filler) {
+        return new AsyncWebServerResponse(contentType, filler);
+    }
+
+    std::map<std::string, String> args;
+};
+
+#endif // HOST_ESPASYNCWEBSERVER_H
@@ -0,0 +1,96 @@
+// FS.h - Host copy of the Arduino-ESP32 File and FS wrappers (native test env) header
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+#include "FSImpl.h"
+
+#define FILE_READ       "r"
+#define FILE_WRITE      "w"
+#define FILE_APPEND     "a"
+
+namespace fs {
+
+class File : public Stream {
+public:
+    File(FileImplPtr p = FileImplPtr()) : _p(p) {}
+
+    size_t write(uint8_t c) override { return _p ? _p->write(&c, 1) : 0; }
+    size_t write(const uint8_t* buf, size_t size) override { return _p ? _p->write(buf, size) : 0; }
+    int available() override { return _p ? _p->size() - _p->position() : 0; }
+    int read() override {
+        uint8_t c;
+        return _p && _p->read(&c, 1) == 1 ? c : -1;
+    }
+    size_t read(uint8_t* buf, size_t size) { return _p ? _p->read(buf, size) : 0; }
+    int peek() override {
+        int c = read();
+        if (c >= 0) _p->seek(_p->position() - 1, SeekSet);
+        return c;
+    }
+    void flush() override {
+        if (_p) _p->flush();
+    }
+    bool seek(uint32_t pos, SeekMode mode) { return _p && _p->seek(pos, mode); }
+    bool seek(uint32_t pos) { return seek(pos, SeekSet); }
+    size_t position() const { return _p ? _p->position() : 0; }
+    size_t size() const { return _p ? _p->size() : 0; }
+    bool setBufferSize(size_t size) { return _p && _p->setBufferSize(size); }
+    void close() {
+        if (_p) {
+            _p->close();
+            _p = nullptr;
+        }
+    }
+    operator bool() const { return _p != nullptr && *_p != false; }
+    time_t getLastWrite() { return _p ? _p->getLastWrite() : 0; }
+    const char* path() const { return _p ? _p->path() : ""; }
+    const char* name() const { return _p ? _p->name() : ""; }
+    boolean isDirectory(void) { return _p && _p->isDirectory(); }
+    boolean seekDir(long position) { return _p && _p->seekDir(position); }
+    File openNextFile(const char* mode = FILE_READ) { return _p ? File(_p->openNextFile(mode)) : File(); }
+    String getNextFileName(void) { return _p ? _p->getNextFileName() : String(); }
+    String getNextFileName(bool* isDir) { return _p ? _p->getNextFileName(isDir) : String(); }
+    void rewindDirectory(void) {
+        if (_p) _p->rewindDirectory();
+    }
+    using Print::write;
+
+protected:
+    FileImplPtr _p;
+};
+
+class FS {
+public:
+    FS(FSImplPtr impl) : _impl(impl) {}
+
+    File open(const char* path, const char* mode = FILE_READ, const bool create = false) {
+        return _impl ? File(_impl->open(path, mode, create)) : File();
+    }
+    File open(const String& path, const char* mode = FILE_READ, const bool create = false) {
+        return open(path.c_str(), mode, create);
+    }
+    bool exists(const char* path) { return _impl && _impl->exists(path); }
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const char* path) { return _impl && _impl->remove(path); }
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool rename(const char* pathFrom, const char* pathTo) { return _impl && _impl->rename(pathFrom, pathTo); }
+    bool rename(const String& pathFrom, const String& pathTo) { return rename(pathFrom.c_str(), pathTo.c_str()); }
+    bool mkdir(const char* path) { return _impl && _impl->mkdir(path); }
+    bool mkdir(const String& path) { return mkdir(path.c_str()); }
+    bool rmdir(const char* path) { return _impl && _impl->rmdir(path); }
+    bool rmdir(const String& path) { return rmdir(path.c_str()); }
+
+protected:
+    FSImplPtr _impl;
+};
+
+} // namespace fs
+
+using fs::File;
+using fs::FS;
+using fs::SeekCur;
+using fs::SeekEnd;
+using fs::SeekMode;
+using fs::SeekSet;
+
+#endif // HOST_FS_H
@@ -0,0 +1,137 @@
+// LittleFS.h - Host stand-in for the internal flash file system (native test env) header
+// Files live in memory for the life of the process; directories are not
+// modelled, the tier stage and the log format dictionary sit in the root.
+#ifndef HOST_LITTLEFS_H
+#define HOST_LITTLEFS_H
+
+#include "FS.h"
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace fs {
+
+struct HostFlash {
+    std::recursive_mutex lock;
+    std::map<std::string, std::shared_ptr<std::vector<uint8_t>>> files;
+    size_t capacity = 917504;       // huge_app.csv spiffs partition
+};
+
+inline HostFlash hostFlash;
+
+class HostFlashFileImpl : public FileImpl {
+public:
+    HostFlashFileImpl(const std::string& path, std::shared_ptr<std::vector<uint8_t>> data, bool writable, bool append)
+        : _path(path), _data(data), _writable(writable), _append(append) {
+        size_t slash = _path.rfind('/');
+        _name = slash == std::string::npos ? _path : _path.substr(slash + 1);
+    }
+
+    size_t write(const uint8_t* buf, size_t size) {
+        if (!_data || !_writable) return 0;
+        std::lock_guard<std::recursive_mutex> guard(hostFlash.lock);
+        if (_append) _pos = _data->size();
+        if (_data->size() < _pos + size) _data->resize(_pos + size);
+        memcpy(_data->data() + _pos, buf, size);
+        _pos += size;
+        return size;
+    }
+    size_t read(uint8_t* buf, size_t size) {
+        if (!_data) return 0;
+        std::lock_guard<std::recursive_mutex> guard(hostFlash.lock);
+        size_t n = _pos < _data->size() ? std::min(size, _data->size() - _pos) : 0;
+        memcpy(buf, _data->data() + _pos, n);
+        _pos += n;
+        return n;
+    }
+    void flush() {}
+    bool seek(uint32_t pos, SeekMode mode) {
+        if (!_data) return false;
+        size_t base = mode == SeekCur ? _pos : mode == SeekEnd ? _data->size() : 0;
+        _pos = base + pos;
+        return _pos <= _data->size();
+    }
+    size_t position() const { return _pos; }
+    size_t size() const { return _data ? _data->size() : 0; }
+    bool setBufferSize(size_t) { return true; }
+    void close() { _data.reset(); }
+    time_t getLastWrite() { return 0; }
+    const char* path() const { return _path.c_str(); }
+    const char* name() const { return _name.c_str(); }
+    boolean isDirectory(void) { return false; }
+    FileImplPtr openNextFile(const char*) { return FileImplPtr(); }
+    boolean seekDir(long) { return false; }
+    String getNextFileName(void) { return String(); }
+    String getNextFileName(bool*) { return String(); }
+    void rewindDirectory(void) {}
+    operator bool() { return _data != nullptr; }
+
+private:
+    std::string _path;
+    std::string _name;
+    std::shared_ptr<std::vector<uint8_t>> _data;
+    bool _writable;
+    bool _append;
+    size_t _pos = 0;
+};
+
+class HostFlashFSImpl : public FSImpl {
+public:
+    FileImplPtr open(const char* path, const char* mode, const bool) {
+        std::lock_guard<std::recursive_mutex> guard(hostFlash.lock);
+        auto it = hostFlash.files.find(path);
+        if (mode[0] == 'r' && it == hostFlash.files.end()) return FileImplPtr();
+        if (mode[0] == 'w' || it == hostFlash.files.end()) {
+            hostFlash.files[path] = std::make_shared<std::vector<uint8_t>>();
+            it = hostFlash.files.find(path);
+        }
+        bool writable = mode[0] != 'r' || mode[1] == '+';
+        return std::make_shared<HostFlashFileImpl>(path, it->second, writable, mode[0] == 'a');
+    }
+    bool exists(const char* path) {
+        std::lock_guard<std::recursive_mutex> guard(hostFlash.lock);
+        return hostFlash.files.count(path) > 0;
+    }
+    bool rename(const char* pathFrom, const char* pathTo) {
+        std::lock_guard<std::recursive_mutex> guard(hostFlash.lock);
+        auto it = hostFlash.files.find(pathFrom);
+        if (it == hostFlash.files.end()) return false;
+        hostFlash.files[pathTo] = it->second;
+        hostFlash.files.erase(pathFrom);
+        return true;
+    }
+    bool remove(const char* path) {
+        std::lock_guard<std::recursive_mutex> guard(hostFlash.lock);
+        return hostFlash.files.erase(path) > 0;
+    }
+    bool mkdir(const char*) { return true; }
+    bool rmdir(const char*) { return true; }
+};
+
+class LittleFSFS : public FS {
+public:
+    LittleFSFS() : FS(FSImplPtr(new HostFlashFSImpl())) {}
+    bool begin(bool formatOnFail = false, const char* basePath = "/littlefs", uint8_t maxOpenFiles = 10,
+               const char* partitionLabel = "spiffs") {
+        return true;
+    }
+    void end() {}
+    // Drops every file, as a fresh partition
+    void format() {
+        std::lock_guard<std::recursive_mutex> guard(hostFlash.lock);
+        hostFlash.files.clear();
+    }
+    size_t totalBytes() { return hostFlash.capacity; }
+    size_t usedBytes() {
+        std::lock_guard<std::recursive_mutex> guard(hostFlash.lock);
+        size_t used = 0;
+        for (auto& f : hostFlash.files) used += f.second->size();
+        return used;
+    }
+};
+
+} // namespace fs
+
+inline fs::LittleFSFS LittleFS;
+
+#endif // HOST_LITTLEFS_H
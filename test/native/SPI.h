@@ -0,0 +1,32 @@
+// SPI.h - Host stand-in for the Arduino SPI driver (native test env) header
+// Lets the vendored SdFat build on the host; there is no bus, the card is a
+// disk image behind SdFat's block device interface.
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include "Arduino.h"
+
+#define MSBFIRST    1
+#define SPI_MODE0   0
+
+class SPISettings {
+public:
+    SPISettings(uint32_t clock = 0, uint8_t bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0) {}
+};
+
+class SPIClass {
+public:
+    void begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1) {}
+    void end() {}
+    void beginTransaction(SPISettings) {}
+    void endTransaction() {}
+    uint8_t transfer(uint8_t) { return 0xFF; }
+    void transfer(void* buf, size_t count) { memset(buf, 0xFF, count); }
+    void transferBytes(const uint8_t* out, uint8_t* in, uint32_t size) {
+        if (in) memset(in, 0xFF, size);
+    }
+};
+
+inline SPIClass SPI;
+
+#endif // HOST_SPI_H
@@ -0,0 +1,15 @@
+// esp_heap_caps.h - Host stand-in for the ESP-IDF capability allocator (native test env) header
+#ifndef HOST_ESP_HEAP_CAPS_H
+#define HOST_ESP_HEAP_CAPS_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#define MALLOC_CAP_8BIT     0x0004
+#define MALLOC_CAP_SPIRAM   0x0400
+#define MALLOC_CAP_INTERNAL 0x0800
+
+inline void* heap_caps_malloc(size_t size, uint32_t) { return malloc(size); }
+inline void heap_caps_free(void* p) { free(p); }
+
+#endif // HOST_ESP_HEAP_CAPS_H
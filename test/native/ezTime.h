@@ -0,0 +1,91 @@
+// ezTime.h - Host stand-in for the ezTime library (native test env) header
+// One UTC zone; its clock is hostNow, which tests set and advance.
+#ifndef HOST_EZTIME_H
+#define HOST_EZTIME_H
+
+#include "Arduino.h"
+
+#define TIME_NOW        0x7FFFFFFF
+#define LAST_READ       0x7FFFFFFE
+#define SECS_PER_DAY    86400UL
+#define SECS_PER_HOUR   3600UL
+
+typedef enum { LOCAL_TIME, UTC_TIME } ezLocalOrUTC_t;
+
+typedef struct {
+    uint8_t Second;
+    uint8_t Minute;
+    uint8_t Hour;
+    uint8_t Wday;               // 1 = Sunday
+    uint8_t Day;
+    uint8_t Month;
+    uint8_t Year;               // offset from 1970
+} tmElements_t;
+
+inline time_t hostNow = 1790000000;     // 2026-09-21
+
+inline void breakTime(const time_t time, tmElements_t& tm) {
+    struct tm g;
+    gmtime_r(&time, &g);
+    tm.Second = g.tm_sec;
+    tm.Minute = g.tm_min;
+    tm.Hour = g.tm_hour;
+    tm.Wday = g.tm_wday + 1;
+    tm.Day = g.tm_mday;
+    tm.Month = g.tm_mon + 1;
+    tm.Year = g.tm_year + 1900 - 1970;
+}
+
+inline time_t makeTime(const uint8_t hour, const uint8_t minute, const uint8_t second, const uint8_t day,
+                       const uint8_t month, const uint16_t year) {
+    struct tm g = {};
+    g.tm_sec = second;
+    g.tm_min = minute;
+    g.tm_hour = hour;
+    g.tm_mday = day;
+    g.tm_mon = month - 1;
+    g.tm_year = (year < 1970 ? year + 1970 : year) - 1900;
+    return timegm(&g);
+}
+
+inline time_t makeTime(tmElements_t& tm) {
+    return makeTime(tm.Hour, tm.Minute, tm.Second, tm.Day, tm.Month, tm.Year + 1970);
+}
+
+class Timezone {
+public:
+    bool setPosix(const String&) { return true; }
+    bool setLocation(const String& = "") { return true; }
+    time_t now() { return hostNow; }
+    time_t tzTime(time_t t = TIME_NOW, ezLocalOrUTC_t = LOCAL_TIME) { return t == TIME_NOW ? hostNow : t; }
+    String dateTime(const String& format = "Y-m-d H:i:s") { return dateTime(hostNow, format); }
+    String dateTime(time_t t, const ezLocalOrUTC_t, const String& format) { return dateTime(t, format); }
+    // The format letters the firmware uses: Y m d H i s y
+    String dateTime(time_t t, const String& format) {
+        struct tm g;
+        gmtime_r(&t, &g);
+        std::string out;
+        char b[8];
+        for (const char* f = format.c_str(); *f; f++) {
+            switch (*f) {
+                case 'Y': snprintf(b, sizeof(b), "%04d", g.tm_year + 1900); break;
+                case 'y': snprintf(b, sizeof(b), "%02d", g.tm_year % 100); break;
+                case 'm': snprintf(b, sizeof(b), "%02d", g.tm_mon + 1); break;
+                case 'd': snprintf(b, sizeof(b), "%02d", g.tm_mday); break;
+                case 'H': snprintf(b, sizeof(b), "%02d", g.tm_hour); break;
+                case 'i': snprintf(b, sizeof(b), "%02d", g.tm_min); break;
+                case 's': snprintf(b, sizeof(b), "%02d", g.tm_sec); break;
+                default: b[0] = *f; b[1] = '\0';
+            }
+            out += b;
+        }
+        return String(out);
+    }
+};
+
+inline void events() {}
+inline void setInterval(uint16_t = 0) {}
+inline void setServer(const String& = "") {}
+inline void updateNTP() {}
+
+#endif // HOST_EZTIME_H
@@ -0,0 +1,32 @@
+// FreeRTOS.h - Host stand-in for the FreeRTOS types (native test env) header
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+#include <stdint.h>
+#include <mutex>
+
+typedef void* SemaphoreHandle_t;
+typedef void* TaskHandle_t;
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+
+#define portMAX_DELAY       0xFFFFFFFFUL
+#define pdTRUE              1
+#define pdFALSE             0
+#define pdPASS              1
+#define pdMS_TO_TICKS(ms)   (ms)
+#define tskIDLE_PRIORITY    0
+#define tskNO_AFFINITY      0x7FFFFFFF
+
+// Critical sections are one process-wide mutex
+typedef struct {
+    int unused;
+} portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED {0}
+
+inline std::recursive_mutex hostCritical;
+inline void portENTER_CRITICAL(portMUX_TYPE*) { hostCritical.lock(); }
+inline void portEXIT_CRITICAL(portMUX_TYPE*) { hostCritical.unlock(); }
+
+#endif // HOST_FREERTOS_H
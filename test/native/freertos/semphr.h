@@ -0,0 +1,21 @@
+// semphr.h - Host stand-in for FreeRTOS semaphores (native test env) header
+#ifndef HOST_SEMPHR_H
+#define HOST_SEMPHR_H
+
+#include "FreeRTOS.h"
+
+// Mutexes only; every handle is a recursive mutex that is never freed
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { return new std::recursive_mutex(); }
+inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() { return new std::recursive_mutex(); }
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t s, TickType_t) {
+    ((std::recursive_mutex*)s)->lock();
+    return pdTRUE;
+}
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t s) {
+    ((std::recursive_mutex*)s)->unlock();
+    return pdTRUE;
+}
+inline BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t s, TickType_t t) { return xSemaphoreTake(s, t); }
+inline BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t s) { return xSemaphoreGive(s); }
+
+#endif // HOST_SEMPHR_H
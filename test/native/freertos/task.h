@@ -0,0 +1,35 @@
+// task.h - Host stand-in for FreeRTOS tasks (native test env) header
+#ifndef HOST_TASK_H
+#define HOST_TASK_H
+
+#include "FreeRTOS.h"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+typedef void (*TaskFunction_t)(void*);
+
+// A task is a detached thread; its handle is the thread's own marker, so
+// xTaskGetCurrentTaskHandle() tells threads apart like it tells tasks apart
+inline thread_local int hostTaskMarker;
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return &hostTaskMarker; }
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char*, uint32_t, void* arg, UBaseType_t,
+                                          TaskHandle_t* handle, BaseType_t) {
+    static int created;
+    if (handle) *handle = &created;
+    std::thread(fn, arg).detach();
+    return pdPASS;
+}
+
+inline void vTaskDelay(TickType_t ticks) { std::this_thread::sleep_for(std::chrono::milliseconds(ticks)); }
+inline uint32_t ulTaskNotifyTake(BaseType_t, TickType_t ticks) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(std::min(ticks, (TickType_t)5)));
+    return 0;
+}
+inline BaseType_t xTaskNotifyGive(TaskHandle_t) { return pdPASS; }
+inline BaseType_t xPortGetCoreID() { return 1; }
+inline UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t) { return 0; }
+
+#endif // HOST_TASK_H
@@ -0,0 +1,11 @@
+// pgmspace.h - Host stand-in for the ESP32 PROGMEM helpers (native test env) header
+#ifndef HOST_PGMSPACE_H
+#define HOST_PGMSPACE_H
+
+#define PROGMEM
+#define PGM_P const char*
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+#endif // HOST_PGMSPACE_H
@@ -0,0 +1,63 @@
+// simyear.h - Simulated year of sensor history for the host benchmarks header
+// Samples are written every HISTORY_INTERVAL through histAppend(), with the
+// appenders and the flash stage ticked as loop() does, onto the POSIX
+// backend in a temporary directory.
+#ifndef HOST_SIMYEAR_H
+#define HOST_SIMYEAR_H
+
+#include "globals.h"
+#include "sd.h"
+#include "hist.h"
+#include "appender.h"
+#include "tier.h"
+#include <filesystem>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define YEAR_START          1735689600UL    // 2025-01-01 00:00 local
+#define YEAR_DAYS           365
+#define SAMPLE_SECONDS      (HISTORY_INTERVAL / 1000)
+#define SAMPLES_PER_DAY     (86400 / SAMPLE_SECONDS)
+
+inline char simYearDir[] = "/tmp/simyear_XXXXXX";
+
+// Slow daily and seasonal swings with a little sensor noise
+inline void simYearSample(HistRecord& rec, uint32_t ts) {
+    float day = (ts - YEAR_START) / 86400.0f;
+    float daily = sinf(day * 2 * M_PI);
+    float season = -cosf(day / 365 * 2 * M_PI);
+    rec.ts = ts;
+    for (uint8_t ch = 0; ch < HIST_CHANNELS; ch++) {
+        float value = 20 + ch + 10 * season + 4 * daily + (rand() % 10) / 10.0f;
+        rec.v[ch] = (int32_t)lroundf(value * histScale[ch]);
+    }
+}
+
+inline uint32_t simYearDate(uint32_t day) {
+    return histDateOf(YEAR_START + day * 86400UL);
+}
+
+// The POSIX backend works below ./sdcard; keep it out of the project
+inline bool simYearWrite() {
+    if (!mkdtemp(simYearDir) || chdir(simYearDir) != 0 || mkdir("sdcard", 0755) != 0) return false;
+    Serial.quiet = true;
+    timeSynced = true;
+    srand(1);
+    if (!initSD()) return false;
+    for (uint32_t ts = YEAR_START; ts < YEAR_START + YEAR_DAYS * 86400UL; ts += SAMPLE_SECONDS) {
+        HistRecord rec;
+        simYearSample(rec, ts);
+        histAppend(rec);
+        hostMillisOffset += HISTORY_INTERVAL;
+        appenderTick();
+        tierTick();
+    }
+    appenderSyncAll();
+    return tierMigrateAll();
+}
+
+inline void simYearRemove() {
+    if (chdir("/") == 0) std::filesystem::remove_all(simYearDir);
+}
+
+#endif // HOST_SIMYEAR_H
@@ -0,0 +1,85 @@
+// test_main.cpp - History compaction benchmark (native)
+// Compacts every day of a simulated year with histCompactStep() in
+// compactTick() sized slices, then reports the delta+varint compression
+// ratio and HistReader decode throughput of raw and compacted days. The
+// decoded records must be identical in both formats.
+#include <unity.h>
+#include "simyear.h"
+#include "compact.h"
+
+#define COMPACT_RATIO_MIN   3.0         // raw bytes per compacted byte
+
+struct YearScan {
+    uint32_t records = 0;
+    uint64_t sum = 0;               // order dependent checksum of every field
+    uint64_t bytes = 0;             // day file sizes
+    double secs = 0;
+};
+
+// Every record of the year through histOpen()/histNext()
+static YearScan scanYear() {
+    YearScan scan;
+    uint32_t start = micros();
+    for (uint32_t day = 0; day < YEAR_DAYS; day++) {
+        String path = histPath(simYearDate(day));
+        File f = storage.open(path.c_str(), FILE_READ);
+        if (f) scan.bytes += f.size();
+        f.close();
+
+        HistReader r;
+        if (!histOpen(r, path.c_str())) continue;
+        HistRecord rec;
+        while (histNext(r, rec)) {
+            scan.sum = scan.sum * 31 + rec.ts;
+            for (uint8_t ch = 0; ch < HIST_CHANNELS; ch++) scan.sum = scan.sum * 31 + (uint32_t)rec.v[ch];
+            scan.records++;
+        }
+        histClose(r);
+    }
+    scan.secs = (micros() - start) / 1e6;
+    return scan;
+}
+
+void test_compaction_ratio_and_decode_throughput() {
+    YearScan raw = scanYear();
+
+    uint32_t start = micros();
+    uint32_t compacted = 0;
+    for (uint32_t day = 0; day < YEAR_DAYS; day++) {
+        HistCompactor c;
+        if (!histCompactBegin(c, simYearDate(day))) continue;
+        int result;
+        while ((result = histCompactStep(c, COMPACT_SLICE)) > 0) {}
+        if (result == 0 && histCompactCommit(c)) compacted++;
+        else histCompactAbort(c);
+    }
+    double encodeSecs = (micros() - start) / 1e6;
+
+    YearScan packed = scanYear();
+    double ratio = (double)raw.bytes / packed.bytes;
+    printf("compact: %u records, %.2f MB raw -> %.2f MB (%.2fx), encode %.1f MB/s\n", raw.records,
+           raw.bytes / 1048576.0, packed.bytes / 1048576.0, ratio, raw.bytes / 1048576.0 / encodeSecs);
+    printf("decode: raw %.0f records/s, compacted %.0f records/s\n", raw.records / raw.secs,
+           packed.records / packed.secs);
+
+    TEST_ASSERT_EQUAL_UINT32(YEAR_DAYS * SAMPLES_PER_DAY, raw.records);
+    TEST_ASSERT_EQUAL_UINT32(YEAR_DAYS, compacted);
+    TEST_ASSERT_EQUAL_UINT32(raw.records, packed.records);
+    TEST_ASSERT_TRUE(raw.sum == packed.sum);
+    TEST_ASSERT_TRUE(ratio >= COMPACT_RATIO_MIN);
+    for (uint32_t day = 0; day < YEAR_DAYS; day++) {
+        TEST_ASSERT_TRUE(histIsCompact(histPath(simYearDate(day)).c_str()));
+    }
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+    if (!simYearWrite()) return 1;
+    UNITY_BEGIN();
+    RUN_TEST(test_compaction_ratio_and_decode_throughput);
+    int failures = UNITY_END();
+    simYearRemove();
+    return failures;
+}
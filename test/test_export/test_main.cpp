@@ -0,0 +1,95 @@
+// test_main.cpp - CSV export benchmark (native)
+// Exports a simulated year of sensor history through beginCsvExport() and
+// pulls the body in TCP-window sized pieces. Heap is counted through the
+// global operator new; the peak of a year must stay under EXPORT_HEAP_LIMIT
+// and exceed the peak of a single week only by the year's day file list.
+#include <unity.h>
+#include "simyear.h"
+#include "export.h"
+#include "manifest.h"
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+#define SEND_WINDOW         1436            // one TCP segment, what AsyncTCP usually offers
+#define EXPORT_HEAP_LIMIT   8192            // bytes above the level before the export
+
+static std::atomic<size_t> heapUsed{0};
+static std::atomic<size_t> heapPeak{0};
+
+// Size header ahead of every block, so delete knows what it returns
+void* operator new(size_t size) {
+    size_t* p = (size_t*)malloc(size + sizeof(max_align_t));
+    if (!p) throw std::bad_alloc();
+    *p = size;
+    size_t used = heapUsed += size;
+    size_t peak = heapPeak;
+    while (used > peak && !heapPeak.compare_exchange_weak(peak, used)) {}
+    return (uint8_t*)p + sizeof(max_align_t);
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr) return;
+    size_t* p = (size_t*)((uint8_t*)ptr - sizeof(max_align_t));
+    heapUsed -= *p;
+    free(p);
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete[](void* ptr) noexcept { operator delete(ptr); }
+void operator delete(void* ptr, size_t) noexcept { operator delete(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { operator delete(ptr); }
+
+struct ExportRun {
+    size_t bytes = 0;
+    uint32_t rows = 0;
+    size_t heapPeak = 0;
+    double secs = 0;
+};
+
+static ExportRun exportRange(uint32_t fromDate, uint32_t toDate) {
+    ExportRun run;
+    AsyncWebServerRequest request;
+    size_t base = heapUsed;
+    heapPeak = base;
+    uint32_t start = micros();
+
+    AsyncWebServerResponse* response = beginCsvExport(&request, EXPORT_SENS, fromDate, toDate);
+    uint8_t window[SEND_WINDOW];
+    size_t n;
+    while ((n = response->fill(window, sizeof(window))) > 0) {
+        run.bytes += n;
+        for (size_t i = 0; i < n; i++) run.rows += window[i] == '\n';
+    }
+    run.heapPeak = heapPeak - base;
+    delete response;
+
+    run.secs = (micros() - start) / 1e6;
+    return run;
+}
+
+void test_export_year_in_constant_heap() {
+    ExportRun week = exportRange(simYearDate(0), simYearDate(6));
+    ExportRun year = exportRange(simYearDate(0), simYearDate(YEAR_DAYS - 1));
+    printf("export: week %u rows, %lu B heap peak; year %u rows, %.1f MB, %lu B heap peak, %.2f s (%.1f MB/s)\n",
+           week.rows, (unsigned long)week.heapPeak, year.rows, year.bytes / 1048576.0, (unsigned long)year.heapPeak,
+           year.secs, year.bytes / 1048576.0 / year.secs);
+
+    // Rows plus the header line
+    TEST_ASSERT_EQUAL_UINT32(7 * SAMPLES_PER_DAY + 1, week.rows);
+    TEST_ASSERT_EQUAL_UINT32(YEAR_DAYS * SAMPLES_PER_DAY + 1, year.rows);
+    TEST_ASSERT_LESS_THAN_size_t(EXPORT_HEAP_LIMIT, year.heapPeak);
+    TEST_ASSERT_LESS_OR_EQUAL_size_t(week.heapPeak + (YEAR_DAYS - 7) * sizeof(ManifestEntry) + 256, year.heapPeak);
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+    if (!simYearWrite()) return 1;
+    UNITY_BEGIN();
+    RUN_TEST(test_export_year_in_constant_heap);
+    int failures = UNITY_END();
+    simYearRemove();
+    return failures;
+}
@@ -0,0 +1,175 @@
+// test_main.cpp - Log ring stress test (native)
+// Several producer threads push numbered records of varying length while
+// one consumer drains, as AsyncTCP handlers and loop() log while the writer
+// task drains on the device.
+#include <unity.h>
+#include "logring.h"
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#define PRODUCERS           6
+#define RECORDS             200000      // per producer
+#define PAYLOAD_MAX         200
+
+static std::atomic<bool> producing;
+
+// "<producer>:<seq>:" then filler derived from both, so a torn or mixed
+// record does not parse or does not match
+static size_t makeRecord(char* buf, uint8_t producer, uint32_t seq) {
+    int n = snprintf(buf, PAYLOAD_MAX, "%u:%lu:", producer, (unsigned long)seq);
+    size_t len = n + (seq * 7 + producer) % (PAYLOAD_MAX - n);
+    for (size_t i = n; i < len; i++) buf[i] = 'a' + (producer + seq + i) % 26;
+    return len;
+}
+
+static bool checkRecord(const char* rec, size_t len, uint8_t& producer, uint32_t& seq) {
+    unsigned p;
+    unsigned long s;
+    int n;
+    char head[32];
+    size_t headLen = len < sizeof(head) - 1 ? len : sizeof(head) - 1;
+    memcpy(head, rec, headLen);
+    head[headLen] = '\0';
+    if (sscanf(head, "%u:%lu:%n", &p, &s, &n) != 2 || p >= PRODUCERS) return false;
+    producer = p;
+    seq = s;
+    char expect[PAYLOAD_MAX];
+    return makeRecord(expect, producer, seq) == len && memcmp(expect, rec, len) == 0;
+}
+
+static void producer(uint8_t id, uint32_t* pushed) {
+    char buf[PAYLOAD_MAX];
+    uint32_t ok = 0;
+    for (uint32_t seq = 0; seq < RECORDS; seq++) {
+        // Header and payload as separate parts, like logText()
+        size_t len = makeRecord(buf, id, seq);
+        size_t split = len / 3;
+        const char* parts[2] = {buf, buf + split};
+        size_t lens[2] = {split, len - split};
+        // A full ring drops the record; give the consumer a turn so most get through
+        if (logRingPush(parts, lens, 2)) ok++;
+        else std::this_thread::yield();
+    }
+    *pushed = ok;
+}
+
+void test_ring_keeps_every_record_whole_and_in_order() {
+    LogRingStats before;
+    logRingStats(before);
+
+    uint32_t pushed[PRODUCERS] = {};
+    uint32_t received[PRODUCERS] = {};
+    int64_t lastSeq[PRODUCERS];
+    for (int i = 0; i < PRODUCERS; i++) lastSeq[i] = -1;
+    uint32_t corrupt = 0;
+    uint32_t reordered = 0;
+
+    producing = true;
+    std::thread consumer([&] {
+        char rec[LOG_RING_LINE_MAX];
+        while (true) {
+            bool done = !producing;
+            size_t n = logRingPop(rec, sizeof(rec));
+            if (n == 0) {
+                if (done && logRingUsed() == 0) break;
+                std::this_thread::yield();
+                continue;
+            }
+            uint8_t p;
+            uint32_t seq;
+            if (!checkRecord(rec, n, p, seq)) {
+                corrupt++;
+                continue;
+            }
+            if ((int64_t)seq <= lastSeq[p]) reordered++;
+            lastSeq[p] = seq;
+            received[p]++;
+        }
+    });
+
+    std::vector<std::thread> producers;
+    uint32_t start = clock();
+    for (uint8_t i = 0; i < PRODUCERS; i++) producers.emplace_back(producer, i, &pushed[i]);
+    for (auto& t : producers) t.join();
+    producing = false;
+    consumer.join();
+    double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    LogRingStats after;
+    logRingStats(after);
+    uint32_t totalPushed = 0, totalReceived = 0;
+    for (int i = 0; i < PRODUCERS; i++) {
+        totalPushed += pushed[i];
+        totalReceived += received[i];
+    }
+    uint32_t dropped = after.dropped - before.dropped;
+    printf("ring: %u producers x %u records, %lu received, %lu dropped, high water %lu B, %.2f s cpu\n",
+           PRODUCERS, RECORDS, (unsigned long)totalReceived, (unsigned long)dropped,
+           (unsigned long)after.highWater, secs);
+
+    TEST_ASSERT_EQUAL_UINT32(0, corrupt);
+    TEST_ASSERT_EQUAL_UINT32(0, reordered);
+    TEST_ASSERT_EQUAL_UINT32(totalPushed, totalReceived);
+    TEST_ASSERT_EQUAL_UINT32(totalPushed, after.pushed - before.pushed);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)PRODUCERS * RECORDS, totalPushed + dropped);
+    TEST_ASSERT_EQUAL_UINT32(0, logRingUsed());
+    TEST_ASSERT_TRUE(after.highWater <= LOG_RING_SIZE);
+}
+
+// With nobody draining the ring fills, refuses and counts, then takes
+// records again once drained
+void test_ring_counts_drops_when_full() {
+    char buf[PAYLOAD_MAX];
+    memset(buf, 'x', sizeof(buf));
+    const char* parts[1] = {buf};
+    size_t lens[1] = {100};
+    LogRingStats before;
+    logRingStats(before);
+
+    uint32_t accepted = 0;
+    while (logRingPush(parts, lens, 1)) accepted++;
+    TEST_ASSERT_TRUE(accepted > 0);
+    TEST_ASSERT_FALSE(logRingPush(parts, lens, 1));
+
+    LogRingStats full;
+    logRingStats(full);
+    TEST_ASSERT_EQUAL_UINT32(2, full.dropped - before.dropped);
+    TEST_ASSERT_EQUAL_UINT32(200, full.droppedBytes - before.droppedBytes);
+
+    char rec[LOG_RING_LINE_MAX];
+    uint32_t popped = 0;
+    while (logRingPop(rec, sizeof(rec)) == 100) popped++;
+    TEST_ASSERT_EQUAL_UINT32(accepted, popped);
+    TEST_ASSERT_TRUE(logRingPush(parts, lens, 1));
+    TEST_ASSERT_EQUAL_size_t(100, logRingPop(rec, sizeof(rec)));
+}
+
+// Records over LOG_RING_LINE_MAX are cut, not dropped
+void test_ring_truncates_long_records() {
+    static char big[LOG_RING_LINE_MAX + 300];
+    memset(big, 'y', sizeof(big));
+    const char* parts[1] = {big};
+    size_t lens[1] = {sizeof(big)};
+    LogRingStats before;
+    logRingStats(before);
+    TEST_ASSERT_TRUE(logRingPush(parts, lens, 1));
+    char rec[LOG_RING_LINE_MAX + 300];
+    TEST_ASSERT_EQUAL_size_t(LOG_RING_LINE_MAX, logRingPop(rec, sizeof(rec)));
+    LogRingStats after;
+    logRingStats(after);
+    TEST_ASSERT_EQUAL_UINT32(1, after.truncated - before.truncated);
+}
+
+void setUp() {}
+void tearDown() {}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_ring_keeps_every_record_whole_and_in_order);
+    RUN_TEST(test_ring_counts_drops_when_full);
+    RUN_TEST(test_ring_truncates_long_records);
+    return UNITY_END();
+}
@@ -0,0 +1,143 @@
+// test_main.cpp - Storage backend benchmark (native)
+// Sustained append and range-read throughput of the backend this env is
+// built with: POSIX files in [env:native], SdFat on a disk image in
+// [env:native_sdfat]. Day files are created with the appender's reserve
+// and written in appender-sized blocks; reads are whole files and short
+// ranges at random offsets, as histOpen() seeks into a day.
+#include <unity.h>
+#include "storage.h"
+#include "appender.h"
+#include <filesystem>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define BENCH_FILES         32
+#define BENCH_FILE_BYTES    (1024UL * 1024UL)
+#define BENCH_RANGE         512
+#define BENCH_RANGE_READS   20000
+
+static char benchDir[] = "/tmp/storage_XXXXXX";
+
+// Content depends on file and offset, so a misplaced sector shows
+static uint8_t benchByte(uint32_t file, uint32_t offset) {
+    return (uint8_t)(file * 131 + offset * 7 + (offset >> 9));
+}
+
+static String benchPath(uint32_t file) {
+    char path[24];
+    snprintf(path, sizeof(path), "/bench/d%02lu.bin", (unsigned long)file);
+    return String(path);
+}
+
+void test_append_throughput() {
+    uint8_t block[APPENDER_BUF_SIZE];
+    uint32_t start = micros();
+    for (uint32_t f = 0; f < BENCH_FILES; f++) {
+        File file = storageCreate(benchPath(f), APPENDER_RESERVE);
+        TEST_ASSERT_TRUE(file);
+        for (uint32_t pos = 0; pos < BENCH_FILE_BYTES; pos += sizeof(block)) {
+            for (uint32_t i = 0; i < sizeof(block); i++) block[i] = benchByte(f, pos + i);
+            TEST_ASSERT_EQUAL_size_t(sizeof(block), file.write(block, sizeof(block)));
+        }
+        file.close();
+    }
+    double secs = (micros() - start) / 1e6;
+    printf("%s append: %.1f MB/s\n", storageName(), BENCH_FILES * BENCH_FILE_BYTES / 1048576.0 / secs);
+
+    for (uint32_t f = 0; f < BENCH_FILES; f++) {
+        File file = storageBackend.open(benchPath(f).c_str(), FILE_READ);
+        TEST_ASSERT_EQUAL_size_t(BENCH_FILE_BYTES, file.size());
+        file.close();
+    }
+}
+
+void test_sequential_read_throughput() {
+    uint8_t block[4096];
+    uint32_t start = micros();
+    for (uint32_t f = 0; f < BENCH_FILES; f++) {
+        File file = storageBackend.open(benchPath(f).c_str(), FILE_READ);
+        TEST_ASSERT_TRUE(file);
+        uint32_t pos = 0;
+        size_t n;
+        while ((n = file.read(block, sizeof(block))) > 0) {
+            TEST_ASSERT_EQUAL_UINT8(benchByte(f, pos), block[0]);
+            TEST_ASSERT_EQUAL_UINT8(benchByte(f, pos + n - 1), block[n - 1]);
+            pos += n;
+        }
+        file.close();
+        TEST_ASSERT_EQUAL_UINT32(BENCH_FILE_BYTES, pos);
+    }
+    double secs = (micros() - start) / 1e6;
+    printf("%s sequential read: %.1f MB/s\n", storageName(), BENCH_FILES * BENCH_FILE_BYTES / 1048576.0 / secs);
+}
+
+// One open file per day, as a range query keeps its day open while it seeks
+void test_range_read_throughput() {
+    File files[BENCH_FILES];
+    for (uint32_t f = 0; f < BENCH_FILES; f++) files[f] = storageBackend.open(benchPath(f).c_str(), FILE_READ);
+    uint8_t range[BENCH_RANGE];
+    srand(1);
+    uint32_t start = micros();
+    for (uint32_t i = 0; i < BENCH_RANGE_READS; i++) {
+        uint32_t f = rand() % BENCH_FILES;
+        uint32_t pos = rand() % (BENCH_FILE_BYTES - BENCH_RANGE);
+        TEST_ASSERT_TRUE(files[f].seek(pos));
+        TEST_ASSERT_EQUAL_size_t(BENCH_RANGE, files[f].read(range, BENCH_RANGE));
+        TEST_ASSERT_EQUAL_UINT8(benchByte(f, pos), range[0]);
+        TEST_ASSERT_EQUAL_UINT8(benchByte(f, pos + BENCH_RANGE - 1), range[BENCH_RANGE - 1]);
+    }
+    double secs = (micros() - start) / 1e6;
+    for (uint32_t f = 0; f < BENCH_FILES; f++) files[f].close();
+    printf("%s range read: %.0f reads/s of %u B\n", storageName(), BENCH_RANGE_READS / secs, BENCH_RANGE);
+}
+
+// A day file shorter than its reserve has the size of what was written,
+// open and after close, and appends continue from there
+void test_reserve_is_handed_back() {
+    uint8_t data[100];
+    for (uint32_t i = 0; i < sizeof(data); i++) data[i] = benchByte(0, i);
+    File file = storageCreate("/bench/short.bin", APPENDER_RESERVE);
+    TEST_ASSERT_TRUE(file);
+    file.write(data, sizeof(data));
+    TEST_ASSERT_EQUAL_size_t(sizeof(data), file.size());
+    TEST_ASSERT_TRUE(file.seek(0));
+    uint8_t back[sizeof(data) * 2];
+    TEST_ASSERT_EQUAL_size_t(sizeof(data), file.read(back, sizeof(back)));
+    // A reader next to the writer, as a range query on the current day
+    File reader = storageBackend.open("/bench/short.bin", FILE_READ);
+    TEST_ASSERT_EQUAL_size_t(sizeof(data), reader.size());
+    TEST_ASSERT_EQUAL_size_t(sizeof(data), reader.read(back, sizeof(back)));
+    reader.close();
+    file.close();
+
+    file = storageBackend.open("/bench/short.bin", FILE_APPEND);
+    file.write(data, sizeof(data));
+    file.close();
+    file = storageBackend.open("/bench/short.bin", FILE_READ);
+    TEST_ASSERT_EQUAL_size_t(2 * sizeof(data), file.size());
+    TEST_ASSERT_EQUAL_size_t(2 * sizeof(data), file.read(back, sizeof(back)));
+    file.close();
+    TEST_ASSERT_EQUAL_MEMORY(data, back + sizeof(data), sizeof(data));
+}
+
+void setUp() {}
+void tearDown() {}
+
+// The POSIX backend works below ./sdcard, the SdFat image is created in
+// the current directory; keep both out of the project
+int main() {
+    if (!mkdtemp(benchDir) || chdir(benchDir) != 0 || mkdir("sdcard", 0755) != 0) return 1;
+    if (!storageBegin()) return 1;
+    storageBackend.mkdir("/bench");
+
+    UNITY_BEGIN();
+    RUN_TEST(test_append_throughput);
+    RUN_TEST(test_sequential_read_throughput);
+    RUN_TEST(test_range_read_throughput);
+    RUN_TEST(test_reserve_is_handed_back);
+    int failures = UNITY_END();
+    storageEnd();
+    if (chdir("/") == 0) std::filesystem::remove_all(benchDir);
+    return failures;
+}
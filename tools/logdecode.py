@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+"""logdecode.py - Turns REW day logs back into "unix|unit|message" lines.
+
+Day files (/YYYY/MM/logs_DD.txt) mix binary LOG_AT() records with plain text
+lines (CEW, older files). Formats come from the card's /logfmt.dict.
+
+    tools/logdecode.py -d /media/sd/logfmt.dict /media/sd/2026/10/logs_17.txt
+"""
+import argparse
+import re
+import struct
+import sys
+
+REC_MARK = 0x1E
+REC_HEAD = 12
+REC_UNSYNCED = 0x01
+TEXT_ID = 0
+REPEAT_ID = 1
+
+CONV = re.compile(r"%([-+ #0-9.*]*)(?:hh|h|ll|l|L|q|j|z|t)?([diuxXocfeEgGaAs%])")
+
+
+def load_dict(path):
+    formats = {}
+    with open(path, "rb") as f:
+        for raw in f:
+            line = raw.decode("utf-8", "replace").rstrip("\r\n")
+            key, sep, fmt = line.partition("|")
+            if sep:
+                try:
+                    formats[int(key, 16)] = fmt
+                except ValueError:
+                    pass
+    return formats
+
+
+def varint(buf, pos):
+    value = shift = 0
+    while pos < len(buf) and shift < 64:
+        b = buf[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        if not b & 0x80:
+            return value, pos
+        shift += 7
+    raise ValueError("truncated varint")
+
+
+def format_args(fmt, buf, pos):
+    out = []
+    last = 0
+    for m in CONV.finditer(fmt):
+        out.append(fmt[last:m.start()])
+        last = m.end()
+        flags, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        try:
+            if conv in "diuxXoc":
+                zz, pos = varint(buf, pos)
+                value = (zz >> 1) ^ -(zz & 1)
+                if conv in "uxXo" and value < 0:
+                    value &= (1 << 64) - 1
+                spec = "%" + flags + ("d" if conv in "iu" else conv)
+                out.append(spec % value)
+            elif conv in "feEgGaA":
+                (value,) = struct.unpack_from("<f", buf, pos)
+                pos += 4
+                spec = "%" + flags + ("f" if conv in "aA" else conv)
+                out.append(spec % value)
+            else:
+                n, pos = varint(buf, pos)
+                if pos + n > len(buf):
+                    raise ValueError("truncated string")
+                text = buf[pos:pos + n].decode("utf-8", "replace")
+                pos += n
+                out.append(("%" + flags + "s") % text)
+        except (ValueError, struct.error):
+            return "".join(out)
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+def decode_record(rec, formats):
+    flags = rec[3]
+    ts, fid = struct.unpack_from("<II", rec, 4)
+    stamp = ("M%u" if flags & REC_UNSYNCED else "%u") % ts
+    body = rec[REC_HEAD:]
+    suffix = ""
+    if fid == REPEAT_ID:
+        try:
+            count, pos = varint(body, 0)
+            seconds, pos = varint(body, pos)
+            (fid,) = struct.unpack_from("<I", body, pos)
+        except (ValueError, struct.error):
+            return "%s|R|" % stamp
+        body = body[pos + 4:]
+        suffix = " [%u times in %u s]" % (count, seconds)
+    if fid == TEXT_ID:
+        msg = body.decode("utf-8", "replace")
+    elif fid in formats:
+        msg = format_args(formats[fid], body, 0)
+    else:
+        msg = "?%08x (%u B)" % (fid, len(body))
+    return "%s|R|%s%s" % (stamp, msg, suffix)
+
+
+def decode_file(data, formats):
+    pos = 0
+    while pos < len(data):
+        if data[pos] == REC_MARK:
+            if pos + 3 > len(data):
+                break
+            size = 3 + (data[pos + 1] | data[pos + 2] << 8)
+            rec = data[pos:pos + size]
+            pos += size
+            if len(rec) < REC_HEAD:
+                break
+            yield decode_record(rec, formats)
+        else:
+            end = data.find(b"\n", pos)
+            if end < 0:
+                end = len(data)
+            yield data[pos:end].decode("utf-8", "replace").rstrip("\r")
+            pos = end + 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode REW day log files")
+    parser.add_argument("-d", "--dict", required=True, help="logfmt.dict from the card root")
+    parser.add_argument("files", nargs="+", help="logs_DD.txt day files")
+    args = parser.parse_args()
+
+    formats = load_dict(args.dict)
+    for path in args.files:
+        with open(path, "rb") as f:
+            data = f.read()
+        for line in decode_file(data, formats):
+            sys.stdout.write(line + "\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""webassets.py - Packs the web page shells in web/ into src/webassets.h.
+
+Every web/<name>.html becomes WEB_<NAME>: the page with indentation and blank
+lines dropped, gzipped, plus an ETag from the hash of its content. The pages
+hold no device data (that is fetched from /status, /logs/rows and
+/history/rows), so the same bytes serve every request.
+
+Runs before each PlatformIO build (extra_scripts = pre:tools/webassets.py)
+and rewrites the header only when a page changed; by hand:
+
+    tools/webassets.py
+"""
+import gzip
+import hashlib
+import os
+import sys
+
+HEADER = "src/webassets.h"
+BYTES_PER_LINE = 16
+
+
+def minify(text):
+    # Leading whitespace only; newlines stay for the scripts' comments
+    return "\n".join(line.strip() for line in text.splitlines() if line.strip()) + "\n"
+
+
+def pack(root):
+    pages = []
+    web = os.path.join(root, "web")
+    for name in sorted(os.listdir(web)):
+        base, ext = os.path.splitext(name)
+        if ext != ".html":
+            continue
+        with open(os.path.join(web, name), encoding="utf-8") as f:
+            text = minify(f.read()).encode("utf-8")
+        data = gzip.compress(text, compresslevel=9, mtime=0)
+        etag = hashlib.sha256(text).hexdigest()[:16]
+        pages.append((base.upper(), name, text, data, etag))
+    return pages
+
+
+def render(pages):
+    out = ["// webassets.h - Gzipped web page shells header",
+           "// Generated by tools/webassets.py from web/*.html; edit those and rebuild",
+           "#ifndef WEBASSETS_H",
+           "#define WEBASSETS_H",
+           "",
+           "#include <Arduino.h>",
+           "",
+           "struct WebAsset {",
+           "    const uint8_t* data;",
+           "    size_t length;",
+           "    const char* etag;           // quoted, as sent",
+           "};",
+           ""]
+    for ident, name, text, data, etag in pages:
+        out.append("// %s: %d bytes, %d gzipped" % (name, len(text), len(data)))
+        out.append("static const uint8_t WEB_%s_GZ[] PROGMEM = {" % ident)
+        for i in range(0, len(data), BYTES_PER_LINE):
+            out.append("    " + ", ".join("0x%02x" % b for b in data[i:i + BYTES_PER_LINE]) + ",")
+        out.append("};")
+        out.append('static const WebAsset WEB_%s = {WEB_%s_GZ, sizeof(WEB_%s_GZ), "\\"%s\\""};'
+                   % (ident, ident, ident, etag))
+        out.append("")
+    out.append("#endif // WEBASSETS_H")
+    return "\n".join(out) + "\n"
+
+
+def main(root):
+    header = os.path.join(root, HEADER)
+    content = render(pack(root))
+    try:
+        with open(header, encoding="utf-8") as f:
+            if f.read() == content:
+                return
+    except FileNotFoundError:
+        pass
+    with open(header, "w", encoding="utf-8") as f:
+        f.write(content)
+    print("webassets: wrote %s" % HEADER)
+
+
+try:
+    Import("env")  # noqa: F821 - provided by PlatformIO's SCons
+    main(env.subst("$PROJECT_DIR"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        main(os.path.dirname(os.path.dirname(os.path.abspath(sys.argv[0]))))